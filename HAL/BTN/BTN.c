@@ -35,20 +35,27 @@ extern const BTN_stConfig_t BTN_stConfigArr[NUMBER_OF_BTNS];
 void BTN_Init(void)
 {
 	u8 loc_iterator = ZERO;
+	u32 loc_u32PortClkMask = ZERO;
     GPIO_strPinConfig_t temp_pinConfig;
 
     temp_pinConfig.mode = INPUT_PIN;
-    
+
+	/* Collect the used ports then enable their clocks with one request */
 	for(loc_iterator=ZERO; loc_iterator<NUMBER_OF_BTNS; loc_iterator++)
 	{
         switch ((u32)BTN_stConfigArr[loc_iterator].port)
         {
-        case (u32)GPIOA: RCC_enuSetPeripheralClk(RCC_AHB1_GPIOA, RCC_ENABLE); break;
-        case (u32)GPIOB: RCC_enuSetPeripheralClk(RCC_AHB1_GPIOB, RCC_ENABLE); break;
-        case (u32)GPIOC: RCC_enuSetPeripheralClk(RCC_AHB1_GPIOC, RCC_ENABLE); break;
+        case (u32)GPIOA: loc_u32PortClkMask |= RCC_PERIPH_MASK(RCC_AHB1_GPIOA); break;
+        case (u32)GPIOB: loc_u32PortClkMask |= RCC_PERIPH_MASK(RCC_AHB1_GPIOB); break;
+        case (u32)GPIOC: loc_u32PortClkMask |= RCC_PERIPH_MASK(RCC_AHB1_GPIOC); break;
         default: break;
         }
+	}
 
+	RCC_enuAcquirePeripheralMask(RCC_enuBusAHB1, loc_u32PortClkMask);
+    
+	for(loc_iterator=ZERO; loc_iterator<NUMBER_OF_BTNS; loc_iterator++)
+	{
         temp_pinConfig.port = BTN_stConfigArr[loc_iterator].port;
         temp_pinConfig.pin = BTN_stConfigArr[loc_iterator].pin;
 
@@ -0,0 +1,307 @@
+/*
+ * @file  : HPWR.c
+ * @brief : API Implementations for the power manager (low power mode selection)
+ * @author: Alaa Hisham
+ * @date  : 19-03-2024
+ */
+/*===========================================================================================================*/
+/*												    Includes		 										 */
+/*===========================================================================================================*/
+
+#include "STD_TYPES.h"
+
+#include "RCC.h"
+#include "PWR.h"
+#include "HPWR.h"
+#include "HPWR_cfg.h"
+
+/*===========================================================================================================*/
+/*												     Macros		 										     */
+/*===========================================================================================================*/
+#define VETO_COUNT_MAX      255
+
+/* PRIMASK save/restore: masked interrupts still end WFI, their handlers run once it is restored */
+#define ENTER_CRITICAL(STATE)   __asm volatile ("mrs %0, primask\n\tcpsid i" : "=r" (STATE) : : "memory")
+#define EXIT_CRITICAL(STATE)    __asm volatile ("msr primask, %0" : : "r" (STATE) : "memory")
+
+#if (HPWR_CFG_STOP_LP_MIN_TICKS < HPWR_CFG_STOP_MIN_TICKS)
+#error "HPWR_CFG_STOP_LP_MIN_TICKS: the deeper stop mode can't need less time than stop"
+#endif
+
+/*===========================================================================================================*/
+/*										  	   Global Variables											     */
+/*===========================================================================================================*/
+/* Number of vetoes taken on each mode (index HPWR_enuRun unused) */
+static u8 HPWR_u8Vetoes[NUMBER_OF_PWR_MODES] = {ZERO};
+
+static HPWR_strModeStats_t HPWR_strStats[NUMBER_OF_PWR_MODES];
+
+static u32 (*HPWR_GetTicks)(void) = NULL;
+
+/* Time of the last wake-up (start of the current run period) */
+static u32 HPWR_u32RunStartTicks = ZERO;
+
+/*===========================================================================================================*/
+/*										  	   Private Functions											 */
+/*===========================================================================================================*/
+/**
+ * @brief Returns the current time from the time source (0 if none is set)
+ */
+static u32 get_ticks(void);
+
+/*===========================================================================================================*/
+/*										  	  API Implementations											 */
+/*===========================================================================================================*/
+/**
+ * @brief Initializes the power manager (PWR clock, no vetoes, cleared statistics)
+ *
+ * @return STD_enuErrorStatus_t : STD_enuOk 			 : Successful Operation
+ * 								  STD_enuOperationFailed : The PWR clock could not be enabled
+ */
+STD_enuErrorStatus_t HPWR_Init(void)
+{
+    u8 loc_u8Iterator = ZERO;
+
+    for(loc_u8Iterator = ZERO; loc_u8Iterator < NUMBER_OF_PWR_MODES; loc_u8Iterator++)
+    {
+        HPWR_u8Vetoes[loc_u8Iterator] = ZERO;
+    }
+
+    HPWR_ResetStats();
+
+    return PWR_Init();
+}
+
+/**
+ * @brief Forbids a low power mode (and every deeper one) until the veto is released
+ *        Vetoes are counted: each call needs its own HPWR_enuReleaseVeto
+ *
+ * @param[in] Copy_enuMode      : HPWR_enuSleep / HPWR_enuStop / HPWR_enuStopLowPower
+ *
+ * @return STD_enuErrorStatus_t : STD_enuOk 			 : Successful Operation
+ * 								  STD_enuInvalidValue	 : Invalid mode
+ * 								  STD_enuInvalidState	 : Too many vetoes on the mode
+ */
+STD_enuErrorStatus_t HPWR_enuVeto(HPWR_enuMode_t Copy_enuMode)
+{
+    STD_enuErrorStatus_t loc_enuErrorStatus = STD_enuOk;
+
+    if((HPWR_enuRun == Copy_enuMode) || (Copy_enuMode > HPWR_enuStopLowPower))
+    {
+        loc_enuErrorStatus = STD_enuInvalidValue;
+    }
+    else if(VETO_COUNT_MAX == HPWR_u8Vetoes[Copy_enuMode])
+    {
+        loc_enuErrorStatus = STD_enuInvalidState;
+    }
+    else
+    {
+        HPWR_u8Vetoes[Copy_enuMode]++;
+    }
+
+    return loc_enuErrorStatus;
+}
+
+/**
+ * @brief Releases a veto taken by HPWR_enuVeto
+ *
+ * @param[in] Copy_enuMode      : HPWR_enuSleep / HPWR_enuStop / HPWR_enuStopLowPower
+ *
+ * @return STD_enuErrorStatus_t : STD_enuOk 			 : Successful Operation
+ * 								  STD_enuInvalidValue	 : Invalid mode
+ * 								  STD_enuInvalidState	 : No veto on the mode
+ */
+STD_enuErrorStatus_t HPWR_enuReleaseVeto(HPWR_enuMode_t Copy_enuMode)
+{
+    STD_enuErrorStatus_t loc_enuErrorStatus = STD_enuOk;
+
+    if((HPWR_enuRun == Copy_enuMode) || (Copy_enuMode > HPWR_enuStopLowPower))
+    {
+        loc_enuErrorStatus = STD_enuInvalidValue;
+    }
+    else if(ZERO == HPWR_u8Vetoes[Copy_enuMode])
+    {
+        loc_enuErrorStatus = STD_enuInvalidState;
+    }
+    else
+    {
+        HPWR_u8Vetoes[Copy_enuMode]--;
+    }
+
+    return loc_enuErrorStatus;
+}
+
+/**
+ * @brief Sets the free running time source used for the deadlines and the residency
+ *        statistics (it must keep counting in stop mode, e.g. RTC/LPTIM based)
+ *
+ * @param[in] Add_GetTicks      : function returning the current time in ticks
+ *
+ * @return STD_enuErrorStatus_t : STD_enuOk 	 : Successful Operation
+ * 								  STD_enuNullPtr : Add_GetTicks is a NULL pointer
+ */
+STD_enuErrorStatus_t HPWR_enuSetTimeSource(u32 (*Add_GetTicks)(void))
+{
+    STD_enuErrorStatus_t loc_enuErrorStatus = STD_enuOk;
+
+    if(NULL != Add_GetTicks)
+    {
+        HPWR_GetTicks = Add_GetTicks;
+        HPWR_u32RunStartTicks = Add_GetTicks();
+    }
+    else
+    {
+        loc_enuErrorStatus = STD_enuNullPtr;
+    }
+
+    return loc_enuErrorStatus;
+}
+
+/**
+ * @brief Enters the deepest low power mode allowed by the vetoes and the next deadline,
+ *        returns once woken up (with the clocks restored after a stop mode)
+ *
+ * Stop modes halt SysTick: a wake-up source (EXTI line, RTC alarm) must be armed
+ * by the caller before the deadline. The mode is chosen and entered with the interrupts
+ * masked, so a veto taken by an interrupt handler at that point keeps the core awake:
+ * the handler that wakes the system runs after the wake-up, once the clocks are restored
+ * (with PWR_enuWFE entry, SEVONPEND must be set for the masked interrupts to wake the core).
+ *
+ * @param[in] Copy_u32TicksToDeadline : time to the next timer deadline (HPWR_NO_DEADLINE: none)
+ * @param[out] Add_penuMode           : the mode that was entered (can be NULL)
+ *
+ * @return STD_enuErrorStatus_t : STD_enuOk 			 : Successful Operation
+ * 								  STD_enuOperationFailed : The clocks could not be restored after a stop mode
+ */
+STD_enuErrorStatus_t HPWR_enuIdle(u32 Copy_u32TicksToDeadline, HPWR_enuMode_t* Add_penuMode)
+{
+    STD_enuErrorStatus_t loc_enuErrorStatus = STD_enuOk;
+    HPWR_enuMode_t loc_enuMode = HPWR_enuRun;
+    u32 loc_u32EnterTicks = ZERO;
+    u32 loc_u32ExitTicks = ZERO;
+    u32 loc_u32Primask = ZERO;
+
+    /* No veto can be taken between the check and the WFI/WFE */
+    ENTER_CRITICAL(loc_u32Primask);
+
+    /* Deepest mode allowed by the vetoes: stop before the shallowest vetoed one */
+    while((loc_enuMode < HPWR_enuStopLowPower) && (ZERO == HPWR_u8Vetoes[loc_enuMode + 1]))
+    {
+        loc_enuMode++;
+    }
+
+    /* Limited by the wake-up latency of each mode */
+    if(ZERO == Copy_u32TicksToDeadline)
+    {
+        loc_enuMode = HPWR_enuRun;
+    }
+    else if((Copy_u32TicksToDeadline < HPWR_CFG_STOP_MIN_TICKS) && (loc_enuMode > HPWR_enuSleep))
+    {
+        loc_enuMode = HPWR_enuSleep;
+    }
+    else if((Copy_u32TicksToDeadline < HPWR_CFG_STOP_LP_MIN_TICKS) && (loc_enuMode > HPWR_enuStop))
+    {
+        loc_enuMode = HPWR_enuStop;
+    }
+    else
+    {
+        /* Do Nothing */
+    }
+
+    if(HPWR_enuRun != loc_enuMode)
+    {
+        loc_u32EnterTicks = get_ticks();
+        HPWR_strStats[HPWR_enuRun].ResidencyTicks += loc_u32EnterTicks - HPWR_u32RunStartTicks;
+
+        /* HPWR_enuSleep.. map to PWR_enuSleep.. */
+        PWR_enuEnterMode((PWR_enuMode_t)(loc_enuMode - HPWR_enuSleep), HPWR_CFG_ENTRY);
+
+        if(loc_enuMode >= HPWR_enuStop)
+        {
+            loc_enuErrorStatus = RCC_enuRestoreAfterStop();
+        }
+        else
+        {
+            /* Do Nothing */
+        }
+
+        /* The pending handler (the wake-up source) runs here */
+        EXIT_CRITICAL(loc_u32Primask);
+
+        loc_u32ExitTicks = get_ticks();
+        HPWR_strStats[loc_enuMode].Entries++;
+        HPWR_strStats[loc_enuMode].ResidencyTicks += loc_u32ExitTicks - loc_u32EnterTicks;
+
+        HPWR_strStats[HPWR_enuRun].Entries++;
+        HPWR_u32RunStartTicks = loc_u32ExitTicks;
+    }
+    else
+    {
+        EXIT_CRITICAL(loc_u32Primask);
+    }
+
+    if(NULL != Add_penuMode)
+    {
+        *Add_penuMode = loc_enuMode;
+    }
+    else
+    {
+        /* Do Nothing */
+    }
+
+    return loc_enuErrorStatus;
+}
+
+/**
+ * @brief Reads the residency statistics of a mode (HPWR_enuRun: time between idle calls)
+ *
+ * @param[in]  Copy_enuMode     : the mode
+ * @param[out] Add_pstrStats    : the statistics of the mode
+ *
+ * @return STD_enuErrorStatus_t : STD_enuOk 			 : Successful Operation
+ * 								  STD_enuNullPtr		 : Add_pstrStats is a NULL pointer
+ * 								  STD_enuInvalidValue	 : Invalid mode
+ */
+STD_enuErrorStatus_t HPWR_enuGetStats(HPWR_enuMode_t Copy_enuMode, HPWR_strModeStats_t* Add_pstrStats)
+{
+    STD_enuErrorStatus_t loc_enuErrorStatus = STD_enuOk;
+
+    if(NULL == Add_pstrStats)
+    {
+        loc_enuErrorStatus = STD_enuNullPtr;
+    }
+    else if(Copy_enuMode > HPWR_enuStopLowPower)
+    {
+        loc_enuErrorStatus = STD_enuInvalidValue;
+    }
+    else
+    {
+        *Add_pstrStats = HPWR_strStats[Copy_enuMode];
+    }
+
+    return loc_enuErrorStatus;
+}
+
+/**
+ * @brief Clears the residency statistics of all modes
+ */
+void HPWR_ResetStats(void)
+{
+    u8 loc_u8Iterator = ZERO;
+
+    for(loc_u8Iterator = ZERO; loc_u8Iterator < NUMBER_OF_PWR_MODES; loc_u8Iterator++)
+    {
+        HPWR_strStats[loc_u8Iterator].Entries = ZERO;
+        HPWR_strStats[loc_u8Iterator].ResidencyTicks = ZERO;
+    }
+
+    HPWR_u32RunStartTicks = get_ticks();
+}
+
+/*===========================================================================================================*/
+/*										  	 Private Implementations										 */
+/*===========================================================================================================*/
+static u32 get_ticks(void)
+{
+    return (NULL != HPWR_GetTicks) ? HPWR_GetTicks() : ZERO;
+}
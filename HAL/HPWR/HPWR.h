@@ -0,0 +1,124 @@
+/*
+ * @file  : HPWR.h
+ * @brief : user interface for the power manager (low power mode selection)
+ * @author: Alaa Hisham
+ * @date  : 19-03-2024
+ */
+
+#ifndef HPWR_H_
+#define HPWR_H_
+
+/*===========================================================================================================*/
+/*												    Includes	 										     */
+/*===========================================================================================================*/
+#include "STD_TYPES.h"
+
+/*===========================================================================================================*/
+/*												     Macros		 										     */
+/*===========================================================================================================*/
+/**
+ * No timer deadline pending (for HPWR_enuIdle)
+ */
+#define HPWR_NO_DEADLINE        0xFFFFFFFFUL
+
+#define NUMBER_OF_PWR_MODES     4
+
+/*===========================================================================================================*/
+/*												     Types		 										     */
+/*===========================================================================================================*/
+typedef enum
+{
+    HPWR_enuRun         ,   /* No low power mode */
+    HPWR_enuSleep       ,
+    HPWR_enuStop        ,
+    HPWR_enuStopLowPower    /* Deepest mode */
+} HPWR_enuMode_t;
+
+typedef struct
+{
+    u32 Entries;            /* Number of times the mode was entered */
+    u32 ResidencyTicks;     /* Time spent in the mode (ticks of the time source) */
+} HPWR_strModeStats_t;
+
+/*===========================================================================================================*/
+/*											 Function Prototypes											 */
+/*===========================================================================================================*/
+
+/**
+ * @brief Initializes the power manager (PWR clock, no vetoes, cleared statistics)
+ *
+ * @return STD_enuErrorStatus_t : STD_enuOk 			 : Successful Operation
+ * 								  STD_enuOperationFailed : The PWR clock could not be enabled
+ */
+STD_enuErrorStatus_t HPWR_Init(void);
+
+/**
+ * @brief Forbids a low power mode (and every deeper one) until the veto is released
+ *        Vetoes are counted: each call needs its own HPWR_enuReleaseVeto
+ *
+ * @param[in] Copy_enuMode      : HPWR_enuSleep / HPWR_enuStop / HPWR_enuStopLowPower
+ *
+ * @return STD_enuErrorStatus_t : STD_enuOk 			 : Successful Operation
+ * 								  STD_enuInvalidValue	 : Invalid mode
+ * 								  STD_enuInvalidState	 : Too many vetoes on the mode
+ */
+STD_enuErrorStatus_t HPWR_enuVeto(HPWR_enuMode_t Copy_enuMode);
+
+/**
+ * @brief Releases a veto taken by HPWR_enuVeto
+ *
+ * @param[in] Copy_enuMode      : HPWR_enuSleep / HPWR_enuStop / HPWR_enuStopLowPower
+ *
+ * @return STD_enuErrorStatus_t : STD_enuOk 			 : Successful Operation
+ * 								  STD_enuInvalidValue	 : Invalid mode
+ * 								  STD_enuInvalidState	 : No veto on the mode
+ */
+STD_enuErrorStatus_t HPWR_enuReleaseVeto(HPWR_enuMode_t Copy_enuMode);
+
+/**
+ * @brief Sets the free running time source used for the deadlines and the residency
+ *        statistics (it must keep counting in stop mode, e.g. RTC/LPTIM based)
+ *
+ * @param[in] Add_GetTicks      : function returning the current time in ticks
+ *
+ * @return STD_enuErrorStatus_t : STD_enuOk 	 : Successful Operation
+ * 								  STD_enuNullPtr : Add_GetTicks is a NULL pointer
+ */
+STD_enuErrorStatus_t HPWR_enuSetTimeSource(u32 (*Add_GetTicks)(void));
+
+/**
+ * @brief Enters the deepest low power mode allowed by the vetoes and the next deadline,
+ *        returns once woken up (with the clocks restored after a stop mode)
+ *
+ * Stop modes halt SysTick: a wake-up source (EXTI line, RTC alarm) must be armed
+ * by the caller before the deadline. The mode is chosen and entered with the interrupts
+ * masked, so a veto taken by an interrupt handler at that point keeps the core awake:
+ * the handler that wakes the system runs after the wake-up, once the clocks are restored
+ * (with PWR_enuWFE entry, SEVONPEND must be set for the masked interrupts to wake the core).
+ *
+ * @param[in] Copy_u32TicksToDeadline : time to the next timer deadline (HPWR_NO_DEADLINE: none)
+ * @param[out] Add_penuMode           : the mode that was entered (can be NULL)
+ *
+ * @return STD_enuErrorStatus_t : STD_enuOk 			 : Successful Operation
+ * 								  STD_enuOperationFailed : The clocks could not be restored after a stop mode
+ */
+STD_enuErrorStatus_t HPWR_enuIdle(u32 Copy_u32TicksToDeadline, HPWR_enuMode_t* Add_penuMode);
+
+/**
+ * @brief Reads the residency statistics of a mode (HPWR_enuRun: time between idle calls)
+ *
+ * @param[in]  Copy_enuMode     : the mode
+ * @param[out] Add_pstrStats    : the statistics of the mode
+ *
+ * @return STD_enuErrorStatus_t : STD_enuOk 			 : Successful Operation
+ * 								  STD_enuNullPtr		 : Add_pstrStats is a NULL pointer
+ * 								  STD_enuInvalidValue	 : Invalid mode
+ */
+STD_enuErrorStatus_t HPWR_enuGetStats(HPWR_enuMode_t Copy_enuMode, HPWR_strModeStats_t* Add_pstrStats);
+
+/**
+ * @brief Clears the residency statistics of all modes
+ */
+void HPWR_ResetStats(void);
+
+#endif /* HPWR_H_ */
@@ -0,0 +1,25 @@
+/*
+ * @file  : HPWR_cfg.h
+ * @brief : pre-compile configurations for the power manager
+ * @author: Alaa Hisham
+ * @date  : 19-03-2024
+ */
+
+#ifndef HPWR_CFG_H_
+#define HPWR_CFG_H_
+
+/**
+ * @brief Minimum time to the next deadline to enter each stop mode
+ *        (in ticks of the time source, covers the wake-up and clock restore latency)
+ */
+#define HPWR_CFG_STOP_MIN_TICKS             5
+#define HPWR_CFG_STOP_LP_MIN_TICKS          20
+
+/**
+ * @brief The instruction used to enter the low power modes (entered with the interrupts masked:
+ *        PWR_enuWFE needs SEVONPEND set for the interrupts to wake the core)
+ *        Options: PWR_enuWFI, PWR_enuWFE
+ */
+#define HPWR_CFG_ENTRY                      PWR_enuWFI
+
+#endif /* HPWR_CFG_H_ */
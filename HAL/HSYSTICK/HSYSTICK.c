@@ -12,7 +12,6 @@
 #include "BIT_MATH.h"
 
 #include "RCC.h"
-#include "NVIC.h"
 #include "SYSTICK.h"
 #include "HSYSTICK.h"
 
@@ -30,26 +29,47 @@
 /*===========================================================================================================*/
 SYSTICK_enuMode_t HSTK_gl_mode = OneTime;
 
-/*===========================================================================================================*/
-/*										  	   Private Functions											 */
-/*===========================================================================================================*/
+/* Last requested time, re-applied when the AHB clock changes (0: not set yet) */
+static u32 HSTK_gl_TimeMs = ZERO;
+
 /**
  * @brief updates the SYSTICK timer's clock value for correct time calculations
- *        Should be called back whenever the system clock (AHB clock) is changed
+ *        Called back by RCC whenever the AHB clock is changed
  */
-void update_systick_clock(void);
+static void update_systick_clock(RCC_enuClkChangePhase_t Copy_enuPhase, const RCC_strClkTree_t* Add_pstrClkTree);
+
+static RCC_strClkSubscriber_t HSTK_gl_ClkSubscriber = {update_systick_clock, NULL};
 
+/*===========================================================================================================*/
+/*										  	   Private Functions											 */
+/*===========================================================================================================*/
 /*===========================================================================================================*/
 /*										  	  API Implementations											 */
 /*===========================================================================================================*/
 /**
  * @brief Initializes the SysTick timer
+ *        (takes the current HCLK and follows its changes through RCC)
  *
- * @return 
+ * @return STD_enuErrorStatus_t : STD_enuOk 			 : Successful Operation
+ * 								  STD_enuInvalidValue	 : HCLK out of the timer range
+ * 								  STD_enuInvalidState	 : Already initialized
  */
 STD_enuErrorStatus_t SYSTICK_Init(void)
 {
-    return RCC_enuSetCBF(SYSTICK_INDEX, update_systick_clock);
+    STD_enuErrorStatus_t loc_enuErrorStatus = STD_enuOk;
+
+    loc_enuErrorStatus = SYSTICK_SetClkHz(RCC_u32GetHclkHz());
+
+    if(STD_enuOk == loc_enuErrorStatus)
+    {
+        loc_enuErrorStatus = RCC_enuSubscribeClkChange(&HSTK_gl_ClkSubscriber);
+    }
+    else
+    {
+        /* Do Nothing */
+    }
+
+    return loc_enuErrorStatus;
 }
 
 /**
@@ -95,7 +115,9 @@ STD_enuErrorStatus_t HSYSTICK_DelayMs(u32 Copy_u32Time, HSYSTICK_enuMode_t Copy_
 
     if(STD_enuOk == loc_enuErrorStatus)
     {
-        NVIC_EnableIRQ(SysTick_IRQn);
+        HSTK_gl_TimeMs = Copy_u32Time;
+
+        /* SysTick exception priority is applied once by NVIC_Init (NVIC_cfg.c) */
         SYSTICK_EnableInterrupt();
         loc_enuErrorStatus = SYSTICK_start(Copy_enuMode);
     }
@@ -120,12 +142,28 @@ STD_enuErrorStatus_t HSYSTICK_SetCBF(void (*Add_Callback)(void))
     return SYSTICK_SetCBF(Add_Callback);
 }
 
-/**
- * @brief updates the SYSTICK timer's clock value for correct time calculations
- *        Should be called back whenever the system clock (AHB clock) is changed
- */
-void update_systick_clock(void)
+/*===========================================================================================================*/
+/*										  	 Private Implementations										 */
+/*===========================================================================================================*/
+static void update_systick_clock(RCC_enuClkChangePhase_t Copy_enuPhase, const RCC_strClkTree_t* Add_pstrClkTree)
 {
-    f32 AHB_ClkSpeed = RCC_f32GetSysClkSpeed();    
-    SYSTICK_SetClkSpeed(AHB_ClkSpeed);
-}
\ No newline at end of file
+    if(RCC_enuClkPostChange == Copy_enuPhase)
+    {
+        /* SysTick is clocked from HCLK (AHB), not SYSCLK */
+        SYSTICK_SetClkHz(Add_pstrClkTree->HclkHz);
+
+        /* Keep the running period in ms across the change */
+        if(ZERO != HSTK_gl_TimeMs)
+        {
+            SYSTICK_setTimeMs(HSTK_gl_TimeMs);
+        }
+        else
+        {
+            /* Do Nothing */
+        }
+    }
+    else
+    {
+        /* Do Nothing */
+    }
+}
@@ -52,8 +52,11 @@ typedef enum
 
 /**
  * @brief Initializes the SysTick timer
+ *        (takes the current HCLK and follows its changes through RCC)
  *
- * @return 
+ * @return STD_enuErrorStatus_t : STD_enuOk 			 : Successful Operation
+ * 								  STD_enuInvalidValue	 : HCLK out of the timer range
+ * 								  STD_enuInvalidState	 : Already initialized
  */
 STD_enuErrorStatus_t SYSTICK_Init(void);
 
@@ -35,6 +35,7 @@ extern const LED_stConfig_t LED_stConfigArr[NUMBER_OF_LEDS];
 void LED_Init(void)
 {
     u8 loc_iterator = ZERO;
+    u32 loc_u32PortClkMask = ZERO;
     GPIO_strPinConfig_t temp_pinConfig;
 
 	u8 on_value = GPIO_PIN_HIGH;
@@ -44,17 +45,23 @@ void LED_Init(void)
     temp_pinConfig.modeCfg.outputCfg.pull = PULLDOWN;
     temp_pinConfig.modeCfg.outputCfg.speed = OUTPUT_MEDIUM_SPEED;
 	temp_pinConfig.modeCfg.outputCfg.type = OUTPUT_PUSH_PULL;
-        
+
+    /* Collect the used ports then enable their clocks with one request */
     for(loc_iterator=ZERO; loc_iterator<NUMBER_OF_LEDS; loc_iterator++)
     {
         switch ((u32)LED_stConfigArr[loc_iterator].port)
         {
-        case (u32)GPIOA: RCC_enuSetPeripheralClk(RCC_AHB1_GPIOA, RCC_ENABLE); break;
-        case (u32)GPIOB: RCC_enuSetPeripheralClk(RCC_AHB1_GPIOB, RCC_ENABLE); break;
-        case (u32)GPIOC: RCC_enuSetPeripheralClk(RCC_AHB1_GPIOC, RCC_ENABLE); break;
+        case (u32)GPIOA: loc_u32PortClkMask |= RCC_PERIPH_MASK(RCC_AHB1_GPIOA); break;
+        case (u32)GPIOB: loc_u32PortClkMask |= RCC_PERIPH_MASK(RCC_AHB1_GPIOB); break;
+        case (u32)GPIOC: loc_u32PortClkMask |= RCC_PERIPH_MASK(RCC_AHB1_GPIOC); break;
         default: break;
         }
+    }
 
+    RCC_enuAcquirePeripheralMask(RCC_enuBusAHB1, loc_u32PortClkMask);
+        
+    for(loc_iterator=ZERO; loc_iterator<NUMBER_OF_LEDS; loc_iterator++)
+    {
         temp_pinConfig.port = LED_stConfigArr[loc_iterator].port;
         temp_pinConfig.pin = LED_stConfigArr[loc_iterator].pin;
 
@@ -0,0 +1,708 @@
+/*
+ * @file  : DMA.c
+ * @brief : API Implementations for the DMA controllers (stream allocation, transfers & callbacks)
+ * @author: Alaa Hisham
+ * @date  : 28-03-2024
+ */
+/*===========================================================================================================*/
+/*												    Includes		 										 */
+/*===========================================================================================================*/
+
+#include "STD_TYPES.h"
+#include "BIT_MATH.h"
+
+#include "RCC.h"
+#include "DMA.h"
+
+/*===========================================================================================================*/
+/*												     Macros		 										     */
+/*===========================================================================================================*/
+#define DMA1                ((volatile DMA_t*)0x40026000)
+#define DMA2                ((volatile DMA_t*)0x40026400)
+
+#define STREAMS_PER_DMA     8
+#define STREAMS_PER_REG     4
+
+/* Stream configuration register */
+#define CR_EN_MASK          0x00000001
+#define CR_DMEIE_MASK       0x00000002
+#define CR_TEIE_MASK        0x00000004
+#define CR_HTIE_MASK        0x00000008
+#define CR_TCIE_MASK        0x00000010
+#define CR_DIR_MASK         0x000000C0
+#define CR_CT_MASK          0x00080000
+#define CR_PSIZE_OFFSET     11
+#define CR_MSIZE_OFFSET     13
+#define CR_PL_OFFSET        16
+#define CR_PBURST_OFFSET    21
+#define CR_MBURST_OFFSET    23
+#define CR_CHSEL_OFFSET     25
+
+/* Stream FIFO control register */
+#define FCR_DMDIS_MASK      0x00000004
+#define FCR_FEIE_MASK       0x00000080
+
+#define MODE_MASK           (DMA_MODE_PERIPH_INC | DMA_MODE_MEM_INC | DMA_MODE_CIRCULAR | DMA_MODE_DOUBLE_BUFFER)
+
+/* Interrupt flags of a stream, shifted by its offset in LISR/HISR (streams 0..3 / 4..7) */
+#define FLAG_FE             0x00000001
+#define FLAG_DME            0x00000004
+#define FLAG_TE             0x00000008
+#define FLAG_HT             0x00000010
+#define FLAG_TC             0x00000020
+#define FLAGS_ALL           0x0000003D
+#define FLAG_OFFSETS        {0, 6, 16, 22}
+
+#define MAX_CHANNEL         7
+#define FIFO_BYTES_PER_STEP 4       /* 1/4 of the 16 bytes FIFO */
+#define BURST_BEATS(BURST)  (2UL << (BURST))            /* INC4, INC8, INC16 */
+
+#define DISABLE_TIMEOUT     1000UL
+
+/* Stream reservation states */
+#define STREAM_FREE         0
+#define STREAM_RESERVED     1
+#define STREAM_CONFIGURED   2
+
+/* PRIMASK save/restore around the state shared with the interrupts */
+#define ENTER_CRITICAL(STATE)   __asm volatile ("mrs %0, primask\n\tcpsid i" : "=r" (STATE) : : "memory")
+#define EXIT_CRITICAL(STATE)    __asm volatile ("msr primask, %0" : : "r" (STATE) : "memory")
+
+/*===========================================================================================================*/
+/*												     Types		 										     */
+/*===========================================================================================================*/
+typedef struct
+{
+    volatile u32 CR;        /* Stream configuration register */
+    volatile u32 NDTR;      /* Stream number of data register */
+    volatile u32 PAR;       /* Stream peripheral address register */
+    volatile u32 M0AR;      /* Stream memory 0 address register */
+    volatile u32 M1AR;      /* Stream memory 1 address register */
+    volatile u32 FCR;       /* Stream FIFO control register */
+} DMA_Stream_t;
+
+typedef struct
+{
+    volatile u32 LISR;      /* Low interrupt status register (streams 0..3) */
+    volatile u32 HISR;      /* High interrupt status register (streams 4..7) */
+    volatile u32 LIFCR;     /* Low interrupt flag clear register */
+    volatile u32 HIFCR;     /* High interrupt flag clear register */
+    DMA_Stream_t S[STREAMS_PER_DMA];
+} DMA_t;
+
+typedef struct
+{
+    DMA_CBF_t Callback;
+    u8 Events;
+    u8 PeriphSize;
+    u8 MemSize;
+    u8 State;
+} DMA_strStreamState_t;
+
+/*===========================================================================================================*/
+/*										  	   Global Variables											     */
+/*===========================================================================================================*/
+static DMA_strStreamState_t DMA_strStreamState[DMA_STREAMS];
+
+static const u8 DMA_u8FlagOffsets[STREAMS_PER_REG] = FLAG_OFFSETS;
+
+/*===========================================================================================================*/
+/*										  	   Private Functions											 */
+/*===========================================================================================================*/
+static volatile DMA_t* get_dma(DMA_enuStream_t Copy_enuStream);
+
+static volatile DMA_Stream_t* get_stream(DMA_enuStream_t Copy_enuStream);
+
+/**
+ * @brief Returns the interrupt flags of a stream (unshifted FLAG_xx) and clears them
+ */
+static u32 take_flags(DMA_enuStream_t Copy_enuStream);
+
+/**
+ * @brief Checks a burst against the FIFO threshold (the threshold must hold a whole number of bursts)
+ */
+static u8 burst_fits(u8 Copy_u8Burst, u8 Copy_u8Size, u8 Copy_u8Fifo);
+
+/**
+ * @brief Common part of DMA_enuStart / DMA_enuStartDoubleBuffer
+ */
+static STD_enuErrorStatus_t start_stream(DMA_enuStream_t Copy_enuStream, u32 Copy_u32PeriphAddress,
+                                         u32 Copy_u32Mem0Address, u32 Copy_u32Mem1Address, u16 Copy_u16Count, u8 Copy_u8Double);
+
+static void stream_irq(DMA_enuStream_t Copy_enuStream);
+
+/*===========================================================================================================*/
+/*										  	  API Implementations											 */
+/*===========================================================================================================*/
+/**
+ * @brief Reserves a stream for the caller and enables its controller clock
+ *
+ * @param[in] Copy_enuStream	: the stream (DMA_enuDma1Stream0 ... DMA_enuDma2Stream7)
+ *
+ * @return STD_enuErrorStatus_t : STD_enuOk 			 : Successful Operation
+ * 								  STD_enuInvalidValue	 : Invalid stream
+ * 								  STD_enuInvalidState	 : The stream is already reserved
+ * 								  STD_enuOperationFailed : The controller clock could not be enabled
+ */
+STD_enuErrorStatus_t DMA_enuAcquireStream(DMA_enuStream_t Copy_enuStream)
+{
+    STD_enuErrorStatus_t loc_enuErrorStatus = STD_enuOk;
+    u32 loc_u32Primask = ZERO;
+
+    if(Copy_enuStream >= DMA_STREAMS)
+    {
+        loc_enuErrorStatus = STD_enuInvalidValue;
+    }
+    else
+    {
+        ENTER_CRITICAL(loc_u32Primask);
+
+        if(STREAM_FREE != DMA_strStreamState[Copy_enuStream].State)
+        {
+            loc_enuErrorStatus = STD_enuInvalidState;
+        }
+        else
+        {
+            DMA_strStreamState[Copy_enuStream].State = STREAM_RESERVED;
+            DMA_strStreamState[Copy_enuStream].Callback = NULL;
+        }
+
+        EXIT_CRITICAL(loc_u32Primask);
+
+        if(STD_enuOk != loc_enuErrorStatus)
+        {
+            /* Do Nothing */
+        }
+        else if(STD_enuOk != RCC_enuAcquirePeripheralClk((Copy_enuStream < DMA_enuDma2Stream0) ? RCC_AHB1_DMA1 : RCC_AHB1_DMA2))
+        {
+            DMA_strStreamState[Copy_enuStream].State = STREAM_FREE;
+            loc_enuErrorStatus = STD_enuOperationFailed;
+        }
+        else
+        {
+            /* A stream left running by its previous user is stopped */
+            get_stream(Copy_enuStream)->CR = ZERO;
+        }
+    }
+
+    return loc_enuErrorStatus;
+}
+
+/**
+ * @brief Reserves the first free stream in a range (e.g. any DMA2 stream for memory to memory)
+ *
+ * @param[in]  Copy_enuFirst	: first stream of the range
+ * @param[in]  Copy_enuLast		: last stream of the range
+ * @param[out] Add_penuStream	: the reserved stream
+ *
+ * @return STD_enuErrorStatus_t : STD_enuOk 			 : Successful Operation
+ * 								  STD_enuNullPtr		 : Add_penuStream is a NULL pointer
+ * 								  STD_enuInvalidValue	 : Invalid range
+ * 								  STD_enuInvalidState	 : All the streams of the range are reserved
+ * 								  STD_enuOperationFailed : The controller clock could not be enabled
+ */
+STD_enuErrorStatus_t DMA_enuAcquireFreeStream(DMA_enuStream_t Copy_enuFirst, DMA_enuStream_t Copy_enuLast, DMA_enuStream_t* Add_penuStream)
+{
+    STD_enuErrorStatus_t loc_enuErrorStatus = STD_enuInvalidState;
+    u8 loc_u8Stream = ZERO;
+
+    if(NULL == Add_penuStream)
+    {
+        loc_enuErrorStatus = STD_enuNullPtr;
+    }
+    else if((Copy_enuLast >= DMA_STREAMS) || (Copy_enuFirst > Copy_enuLast))
+    {
+        loc_enuErrorStatus = STD_enuInvalidValue;
+    }
+    else
+    {
+        for(loc_u8Stream = Copy_enuFirst; (loc_u8Stream <= Copy_enuLast) && (STD_enuInvalidState == loc_enuErrorStatus); loc_u8Stream++)
+        {
+            loc_enuErrorStatus = DMA_enuAcquireStream((DMA_enuStream_t)loc_u8Stream);
+
+            if(STD_enuOk == loc_enuErrorStatus)
+            {
+                *Add_penuStream = (DMA_enuStream_t)loc_u8Stream;
+            }
+            else
+            {
+                /* Do Nothing */
+            }
+        }
+    }
+
+    return loc_enuErrorStatus;
+}
+
+/**
+ * @brief Stops a reserved stream and frees it (the controller clock is released)
+ *
+ * @param[in] Copy_enuStream	: the stream
+ *
+ * @return STD_enuErrorStatus_t : STD_enuOk 			 : Successful Operation
+ * 								  STD_enuInvalidValue	 : Invalid stream
+ * 								  STD_enuInvalidState	 : The stream is not reserved
+ */
+STD_enuErrorStatus_t DMA_enuReleaseStream(DMA_enuStream_t Copy_enuStream)
+{
+    STD_enuErrorStatus_t loc_enuErrorStatus = STD_enuOk;
+
+    if(Copy_enuStream >= DMA_STREAMS)
+    {
+        loc_enuErrorStatus = STD_enuInvalidValue;
+    }
+    else if(STREAM_FREE == DMA_strStreamState[Copy_enuStream].State)
+    {
+        loc_enuErrorStatus = STD_enuInvalidState;
+    }
+    else
+    {
+        DMA_enuStop(Copy_enuStream);
+        get_stream(Copy_enuStream)->CR = ZERO;
+
+        DMA_strStreamState[Copy_enuStream].Callback = NULL;
+        DMA_strStreamState[Copy_enuStream].State = STREAM_FREE;
+
+        RCC_enuReleasePeripheralClk((Copy_enuStream < DMA_enuDma2Stream0) ? RCC_AHB1_DMA1 : RCC_AHB1_DMA2);
+    }
+
+    return loc_enuErrorStatus;
+}
+
+/**
+ * @brief Configures a reserved and stopped stream
+ *
+ * @param[in] Copy_enuStream	: the stream
+ * @param[in] Add_pstrConfig	: the stream configuration
+ *
+ * @return STD_enuErrorStatus_t : STD_enuOk 			 : Successful Operation
+ * 								  STD_enuNullPtr		 : Add_pstrConfig is a NULL pointer
+ * 								  STD_enuInvalidValue	 : Invalid stream
+ * 								  STD_enuInvalidState	 : The stream is not reserved / is running
+ * 								  STD_enuInvalidConfig	 : Invalid or unsupported combination of options
+ */
+STD_enuErrorStatus_t DMA_enuConfigure(DMA_enuStream_t Copy_enuStream, const DMA_strConfig_t* Add_pstrConfig)
+{
+    STD_enuErrorStatus_t loc_enuErrorStatus = STD_enuOk;
+    volatile DMA_Stream_t* loc_pstrStream = NULL;
+    u32 loc_u32Cr = ZERO;
+    u32 loc_u32Fcr = ZERO;
+    u8 loc_u8Events = ZERO;
+
+    if(NULL == Add_pstrConfig)
+    {
+        loc_enuErrorStatus = STD_enuNullPtr;
+    }
+    else if(Copy_enuStream >= DMA_STREAMS)
+    {
+        loc_enuErrorStatus = STD_enuInvalidValue;
+    }
+    else if((STREAM_FREE == DMA_strStreamState[Copy_enuStream].State) || DMA_u8IsBusy(Copy_enuStream))
+    {
+        loc_enuErrorStatus = STD_enuInvalidState;
+    }
+    else if((Add_pstrConfig->Channel > MAX_CHANNEL)
+         || ((Add_pstrConfig->Direction != DMA_PERIPH_TO_MEM) && (Add_pstrConfig->Direction != DMA_MEM_TO_PERIPH)
+          && (Add_pstrConfig->Direction != DMA_MEM_TO_MEM))
+         || (ZERO != (Add_pstrConfig->Mode & ~MODE_MASK))
+         || (Add_pstrConfig->Priority > DMA_PRIORITY_VERY_HIGH)
+         || (Add_pstrConfig->PeriphSize > DMA_SIZE_WORD) || (Add_pstrConfig->MemSize > DMA_SIZE_WORD)
+         || (Add_pstrConfig->Fifo > DMA_FIFO_DIRECT)
+         || (Add_pstrConfig->PeriphBurst > DMA_BURST_INC16) || (Add_pstrConfig->MemBurst > DMA_BURST_INC16))
+    {
+        loc_enuErrorStatus = STD_enuInvalidConfig;
+    }
+    else if((DMA_MEM_TO_MEM == Add_pstrConfig->Direction)
+         && ((Copy_enuStream < DMA_enuDma2Stream0) || (DMA_FIFO_DIRECT == Add_pstrConfig->Fifo)
+          || (ZERO != (Add_pstrConfig->Mode & (DMA_MODE_CIRCULAR | DMA_MODE_DOUBLE_BUFFER)))))
+    {
+        /* Memory to memory: DMA2 only, through the FIFO, one shot */
+        loc_enuErrorStatus = STD_enuInvalidConfig;
+    }
+    else if((DMA_FIFO_DIRECT == Add_pstrConfig->Fifo)
+         && ((Add_pstrConfig->PeriphSize != Add_pstrConfig->MemSize)
+          || (DMA_BURST_SINGLE != Add_pstrConfig->PeriphBurst) || (DMA_BURST_SINGLE != Add_pstrConfig->MemBurst)))
+    {
+        /* Direct mode: no packing, no burst */
+        loc_enuErrorStatus = STD_enuInvalidConfig;
+    }
+    else if((DMA_FIFO_DIRECT != Add_pstrConfig->Fifo)
+         && (!burst_fits(Add_pstrConfig->PeriphBurst, Add_pstrConfig->PeriphSize, Add_pstrConfig->Fifo)
+          || !burst_fits(Add_pstrConfig->MemBurst, Add_pstrConfig->MemSize, Add_pstrConfig->Fifo)))
+    {
+        loc_enuErrorStatus = STD_enuInvalidConfig;
+    }
+    else
+    {
+        loc_pstrStream = get_stream(Copy_enuStream);
+        loc_u8Events = (NULL != Add_pstrConfig->Callback) ? Add_pstrConfig->Events : ZERO;
+
+        loc_u32Cr = ((u32)Add_pstrConfig->Channel << CR_CHSEL_OFFSET)
+                  | ((u32)Add_pstrConfig->MemBurst << CR_MBURST_OFFSET)
+                  | ((u32)Add_pstrConfig->PeriphBurst << CR_PBURST_OFFSET)
+                  | ((u32)Add_pstrConfig->Priority << CR_PL_OFFSET)
+                  | ((u32)Add_pstrConfig->MemSize << CR_MSIZE_OFFSET)
+                  | ((u32)Add_pstrConfig->PeriphSize << CR_PSIZE_OFFSET)
+                  | Add_pstrConfig->Mode | Add_pstrConfig->Direction;
+
+        if(loc_u8Events & DMA_EVENT_HALF)
+        {
+            loc_u32Cr |= CR_HTIE_MASK;
+        }
+        if(loc_u8Events & DMA_EVENT_COMPLETE)
+        {
+            loc_u32Cr |= CR_TCIE_MASK;
+        }
+        if(loc_u8Events & DMA_EVENT_ERROR)
+        {
+            loc_u32Cr |= (CR_TEIE_MASK | CR_DMEIE_MASK);
+        }
+
+        if(DMA_FIFO_DIRECT != Add_pstrConfig->Fifo)
+        {
+            loc_u32Fcr = FCR_DMDIS_MASK | Add_pstrConfig->Fifo;
+
+            if(loc_u8Events & DMA_EVENT_FIFO_ERROR)
+            {
+                loc_u32Fcr |= FCR_FEIE_MASK;
+            }
+            else
+            {
+                /* Do Nothing */
+            }
+        }
+        else
+        {
+            /* Do Nothing */
+        }
+
+        DMA_strStreamState[Copy_enuStream].Callback = Add_pstrConfig->Callback;
+        DMA_strStreamState[Copy_enuStream].Events = loc_u8Events;
+        DMA_strStreamState[Copy_enuStream].PeriphSize = Add_pstrConfig->PeriphSize;
+        DMA_strStreamState[Copy_enuStream].MemSize = Add_pstrConfig->MemSize;
+
+        loc_pstrStream->CR  = loc_u32Cr;
+        loc_pstrStream->FCR = loc_u32Fcr;
+        take_flags(Copy_enuStream);
+
+        DMA_strStreamState[Copy_enuStream].State = STREAM_CONFIGURED;
+    }
+
+    return loc_enuErrorStatus;
+}
+
+/**
+ * @brief Starts a transfer on a configured stream (the call does not wait)
+ *
+ * @param[in] Copy_enuStream		: the stream
+ * @param[in] Copy_u32PeriphAddress	: the peripheral data register (or the source)
+ * @param[in] Copy_u32MemAddress	: the memory buffer (memory 0 in double buffer mode)
+ * @param[in] Copy_u16Count			: number of peripheral size items [1 - 65535]
+ *
+ * @return STD_enuErrorStatus_t : STD_enuOk 			 : Successful Operation
+ * 								  STD_enuInvalidValue	 : Invalid stream / count / address alignment
+ * 								  STD_enuInvalidState	 : The stream is not configured / is running
+ */
+STD_enuErrorStatus_t DMA_enuStart(DMA_enuStream_t Copy_enuStream, u32 Copy_u32PeriphAddress, u32 Copy_u32MemAddress, u16 Copy_u16Count)
+{
+    return start_stream(Copy_enuStream, Copy_u32PeriphAddress, Copy_u32MemAddress, Copy_u32MemAddress, Copy_u16Count, ZERO);
+}
+
+/**
+ * @brief Starts a double buffer (ping-pong) transfer
+ *
+ * @param[in] Copy_enuStream		: the stream (configured with DMA_MODE_DOUBLE_BUFFER)
+ * @param[in] Copy_u32PeriphAddress	: the peripheral data register
+ * @param[in] Copy_u32Mem0Address	: memory 0
+ * @param[in] Copy_u32Mem1Address	: memory 1
+ * @param[in] Copy_u16Count			: number of peripheral size items per buffer [1 - 65535]
+ *
+ * @return STD_enuErrorStatus_t : STD_enuOk 			 : Successful Operation
+ * 								  STD_enuInvalidValue	 : Invalid stream / count / address alignment
+ * 								  STD_enuInvalidState	 : The stream is not configured for double buffer / is running
+ */
+STD_enuErrorStatus_t DMA_enuStartDoubleBuffer(DMA_enuStream_t Copy_enuStream, u32 Copy_u32PeriphAddress,
+                                              u32 Copy_u32Mem0Address, u32 Copy_u32Mem1Address, u16 Copy_u16Count)
+{
+    return start_stream(Copy_enuStream, Copy_u32PeriphAddress, Copy_u32Mem0Address, Copy_u32Mem1Address, Copy_u16Count, 1);
+}
+
+/**
+ * @brief Replaces the buffer the stream is not using in double buffer mode
+ *
+ * @param[in] Copy_enuStream		: the stream
+ * @param[in] Copy_u32MemAddress	: the new buffer
+ *
+ * @return STD_enuErrorStatus_t : STD_enuOk 			 : Successful Operation
+ * 								  STD_enuInvalidValue	 : Invalid stream / address alignment
+ * 								  STD_enuInvalidState	 : The stream is not running in double buffer mode
+ */
+STD_enuErrorStatus_t DMA_enuSetNextBuffer(DMA_enuStream_t Copy_enuStream, u32 Copy_u32MemAddress)
+{
+    STD_enuErrorStatus_t loc_enuErrorStatus = STD_enuOk;
+    volatile DMA_Stream_t* loc_pstrStream = NULL;
+
+    if(Copy_enuStream >= DMA_STREAMS)
+    {
+        loc_enuErrorStatus = STD_enuInvalidValue;
+    }
+    else if(ZERO != (Copy_u32MemAddress & ((1UL << DMA_strStreamState[Copy_enuStream].MemSize) - 1)))
+    {
+        loc_enuErrorStatus = STD_enuInvalidValue;
+    }
+    else
+    {
+        loc_pstrStream = get_stream(Copy_enuStream);
+
+        if((STREAM_CONFIGURED != DMA_strStreamState[Copy_enuStream].State)
+        || !(loc_pstrStream->CR & DMA_MODE_DOUBLE_BUFFER) || !(loc_pstrStream->CR & CR_EN_MASK))
+        {
+            loc_enuErrorStatus = STD_enuInvalidState;
+        }
+        else if(loc_pstrStream->CR & CR_CT_MASK)
+        {
+            /* Memory 1 in use: only memory 0 can be written */
+            loc_pstrStream->M0AR = Copy_u32MemAddress;
+        }
+        else
+        {
+            loc_pstrStream->M1AR = Copy_u32MemAddress;
+        }
+    }
+
+    return loc_enuErrorStatus;
+}
+
+/**
+ * @brief Stops a stream (the current data item completes first) and clears its events
+ *
+ * @param[in] Copy_enuStream	: the stream
+ *
+ * @return STD_enuErrorStatus_t : STD_enuOk 			 : Successful Operation
+ * 								  STD_enuInvalidValue	 : Invalid stream
+ * 								  STD_enuInvalidState	 : The stream is not reserved
+ * 								  STD_enuOperationFailed : The stream did not stop
+ */
+STD_enuErrorStatus_t DMA_enuStop(DMA_enuStream_t Copy_enuStream)
+{
+    STD_enuErrorStatus_t loc_enuErrorStatus = STD_enuOk;
+    volatile DMA_Stream_t* loc_pstrStream = NULL;
+    u32 loc_u32Timeout = DISABLE_TIMEOUT;
+
+    if(Copy_enuStream >= DMA_STREAMS)
+    {
+        loc_enuErrorStatus = STD_enuInvalidValue;
+    }
+    else if(STREAM_FREE == DMA_strStreamState[Copy_enuStream].State)
+    {
+        loc_enuErrorStatus = STD_enuInvalidState;
+    }
+    else
+    {
+        loc_pstrStream = get_stream(Copy_enuStream);
+        loc_pstrStream->CR &= ~CR_EN_MASK;
+
+        while((loc_pstrStream->CR & CR_EN_MASK) && (loc_u32Timeout > ZERO))
+        {
+            loc_u32Timeout--;
+        }
+
+        if(loc_pstrStream->CR & CR_EN_MASK)
+        {
+            loc_enuErrorStatus = STD_enuOperationFailed;
+        }
+        else
+        {
+            /* The transfer complete raised by the disable is not reported */
+            take_flags(Copy_enuStream);
+        }
+    }
+
+    return loc_enuErrorStatus;
+}
+
+/**
+ * @brief Returns the number of items left in the current buffer of a stream
+ *
+ * @param[in] Copy_enuStream	: the stream
+ *
+ * @return u16 : the NDTR register (0 for an invalid stream)
+ */
+u16 DMA_u16GetRemaining(DMA_enuStream_t Copy_enuStream)
+{
+    return (Copy_enuStream < DMA_STREAMS) ? (u16)get_stream(Copy_enuStream)->NDTR : ZERO;
+}
+
+/**
+ * @brief Checks whether a stream is transferring
+ *
+ * @param[in] Copy_enuStream	: the stream
+ *
+ * @return u8 : 1 while the stream is enabled, 0 otherwise
+ */
+u8 DMA_u8IsBusy(DMA_enuStream_t Copy_enuStream)
+{
+    return (Copy_enuStream < DMA_STREAMS) ? (u8)(get_stream(Copy_enuStream)->CR & CR_EN_MASK) : ZERO;
+}
+
+/**
+ * @brief DMA stream interrupts: report the stream events to the stream owner
+ */
+void DMA1_Stream0_IRQHandler(void) { stream_irq(DMA_enuDma1Stream0); }
+void DMA1_Stream1_IRQHandler(void) { stream_irq(DMA_enuDma1Stream1); }
+void DMA1_Stream2_IRQHandler(void) { stream_irq(DMA_enuDma1Stream2); }
+void DMA1_Stream3_IRQHandler(void) { stream_irq(DMA_enuDma1Stream3); }
+void DMA1_Stream4_IRQHandler(void) { stream_irq(DMA_enuDma1Stream4); }
+void DMA1_Stream5_IRQHandler(void) { stream_irq(DMA_enuDma1Stream5); }
+void DMA1_Stream6_IRQHandler(void) { stream_irq(DMA_enuDma1Stream6); }
+void DMA1_Stream7_IRQHandler(void) { stream_irq(DMA_enuDma1Stream7); }
+void DMA2_Stream0_IRQHandler(void) { stream_irq(DMA_enuDma2Stream0); }
+void DMA2_Stream1_IRQHandler(void) { stream_irq(DMA_enuDma2Stream1); }
+void DMA2_Stream2_IRQHandler(void) { stream_irq(DMA_enuDma2Stream2); }
+void DMA2_Stream3_IRQHandler(void) { stream_irq(DMA_enuDma2Stream3); }
+void DMA2_Stream4_IRQHandler(void) { stream_irq(DMA_enuDma2Stream4); }
+void DMA2_Stream5_IRQHandler(void) { stream_irq(DMA_enuDma2Stream5); }
+void DMA2_Stream6_IRQHandler(void) { stream_irq(DMA_enuDma2Stream6); }
+void DMA2_Stream7_IRQHandler(void) { stream_irq(DMA_enuDma2Stream7); }
+
+/*===========================================================================================================*/
+/*										  	 Private Implementations										 */
+/*===========================================================================================================*/
+static volatile DMA_t* get_dma(DMA_enuStream_t Copy_enuStream)
+{
+    return (Copy_enuStream < DMA_enuDma2Stream0) ? DMA1 : DMA2;
+}
+
+static volatile DMA_Stream_t* get_stream(DMA_enuStream_t Copy_enuStream)
+{
+    return &get_dma(Copy_enuStream)->S[Copy_enuStream % STREAMS_PER_DMA];
+}
+
+static u32 take_flags(DMA_enuStream_t Copy_enuStream)
+{
+    volatile DMA_t* loc_pstrDma = get_dma(Copy_enuStream);
+    u8 loc_u8Stream = Copy_enuStream % STREAMS_PER_DMA;
+    u8 loc_u8Offset = DMA_u8FlagOffsets[loc_u8Stream % STREAMS_PER_REG];
+    u32 loc_u32Flags = ZERO;
+
+    if(loc_u8Stream < STREAMS_PER_REG)
+    {
+        loc_u32Flags = (loc_pstrDma->LISR >> loc_u8Offset) & FLAGS_ALL;
+        loc_pstrDma->LIFCR = loc_u32Flags << loc_u8Offset;
+    }
+    else
+    {
+        loc_u32Flags = (loc_pstrDma->HISR >> loc_u8Offset) & FLAGS_ALL;
+        loc_pstrDma->HIFCR = loc_u32Flags << loc_u8Offset;
+    }
+
+    return loc_u32Flags;
+}
+
+static u8 burst_fits(u8 Copy_u8Burst, u8 Copy_u8Size, u8 Copy_u8Fifo)
+{
+    u32 loc_u32BurstBytes = ZERO;
+    u32 loc_u32ThresholdBytes = (Copy_u8Fifo + 1) * FIFO_BYTES_PER_STEP;
+
+    if(DMA_BURST_SINGLE == Copy_u8Burst)
+    {
+        loc_u32BurstBytes = 1UL << Copy_u8Size;
+    }
+    else
+    {
+        loc_u32BurstBytes = (u32)BURST_BEATS(Copy_u8Burst) << Copy_u8Size;
+    }
+
+    return (u8)(ZERO == (loc_u32ThresholdBytes % loc_u32BurstBytes));
+}
+
+static STD_enuErrorStatus_t start_stream(DMA_enuStream_t Copy_enuStream, u32 Copy_u32PeriphAddress,
+                                         u32 Copy_u32Mem0Address, u32 Copy_u32Mem1Address, u16 Copy_u16Count, u8 Copy_u8Double)
+{
+    STD_enuErrorStatus_t loc_enuErrorStatus = STD_enuOk;
+    volatile DMA_Stream_t* loc_pstrStream = NULL;
+    u32 loc_u32MemAlign = ZERO;
+
+    if((Copy_enuStream >= DMA_STREAMS) || (ZERO == Copy_u16Count) || (Copy_u16Count > DMA_MAX_COUNT))
+    {
+        loc_enuErrorStatus = STD_enuInvalidValue;
+    }
+    else if((STREAM_CONFIGURED != DMA_strStreamState[Copy_enuStream].State) || DMA_u8IsBusy(Copy_enuStream)
+         || ((ZERO != (get_stream(Copy_enuStream)->CR & DMA_MODE_DOUBLE_BUFFER)) != (ZERO != Copy_u8Double)))
+    {
+        loc_enuErrorStatus = STD_enuInvalidState;
+    }
+    else
+    {
+        loc_u32MemAlign = (1UL << DMA_strStreamState[Copy_enuStream].MemSize) - 1;
+
+        if((ZERO != (Copy_u32PeriphAddress & ((1UL << DMA_strStreamState[Copy_enuStream].PeriphSize) - 1)))
+        || (ZERO != (Copy_u32Mem0Address & loc_u32MemAlign)) || (ZERO != (Copy_u32Mem1Address & loc_u32MemAlign)))
+        {
+            loc_enuErrorStatus = STD_enuInvalidValue;
+        }
+        else
+        {
+            loc_pstrStream = get_stream(Copy_enuStream);
+
+            take_flags(Copy_enuStream);
+
+            loc_pstrStream->PAR  = Copy_u32PeriphAddress;
+            loc_pstrStream->M0AR = Copy_u32Mem0Address;
+            loc_pstrStream->M1AR = Copy_u32Mem1Address;
+            loc_pstrStream->NDTR = Copy_u16Count;
+
+            /* Double buffer starts on memory 0 */
+            loc_pstrStream->CR = (loc_pstrStream->CR & ~CR_CT_MASK) | CR_EN_MASK;
+        }
+    }
+
+    return loc_enuErrorStatus;
+}
+
+static void stream_irq(DMA_enuStream_t Copy_enuStream)
+{
+    u32 loc_u32Flags = take_flags(Copy_enuStream);
+    u32 loc_u32Cr = get_stream(Copy_enuStream)->CR;
+    u8 loc_u8Events = ZERO;
+
+    if(loc_u32Flags & FLAG_HT)
+    {
+        loc_u8Events |= DMA_EVENT_HALF;
+    }
+    if(loc_u32Flags & FLAG_TC)
+    {
+        loc_u8Events |= DMA_EVENT_COMPLETE;
+    }
+    if(loc_u32Flags & (FLAG_TE | FLAG_DME))
+    {
+        loc_u8Events |= DMA_EVENT_ERROR;
+    }
+    if(loc_u32Flags & FLAG_FE)
+    {
+        loc_u8Events |= DMA_EVENT_FIFO_ERROR;
+    }
+
+    loc_u8Events &= DMA_strStreamState[Copy_enuStream].Events;
+
+    /* CT already points to the next buffer at transfer complete, the half transfer is in the current one */
+    if((loc_u32Cr & DMA_MODE_DOUBLE_BUFFER)
+    && (((loc_u8Events & DMA_EVENT_COMPLETE) && !(loc_u32Cr & CR_CT_MASK))
+     || (!(loc_u8Events & DMA_EVENT_COMPLETE) && (loc_u32Cr & CR_CT_MASK))))
+    {
+        loc_u8Events |= DMA_EVENT_MEMORY1;
+    }
+    else
+    {
+        /* Do Nothing */
+    }
+
+    if((ZERO != (loc_u8Events & ~DMA_EVENT_MEMORY1)) && (NULL != DMA_strStreamState[Copy_enuStream].Callback))
+    {
+        DMA_strStreamState[Copy_enuStream].Callback(Copy_enuStream, loc_u8Events);
+    }
+    else
+    {
+        /* Do Nothing */
+    }
+}
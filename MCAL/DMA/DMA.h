@@ -0,0 +1,292 @@
+/*
+ * @file  : DMA.h
+ * @brief : user interface for the DMA controllers (stream allocation, transfers & callbacks)
+ * @author: Alaa Hisham
+ * @date  : 28-03-2024
+ */
+
+#ifndef DMA_H_
+#define DMA_H_
+
+/*===========================================================================================================*/
+/*												    Includes	 										     */
+/*===========================================================================================================*/
+#include "STD_TYPES.h"
+
+/*===========================================================================================================*/
+/*												     Macros		 										     */
+/*===========================================================================================================*/
+/**
+ * Transfer direction options (memory to memory is only available on DMA2)
+ */
+#define DMA_PERIPH_TO_MEM			0x00000000
+#define DMA_MEM_TO_PERIPH			0x00000040
+#define DMA_MEM_TO_MEM				0x00000080
+
+/**
+ * Mode options (can be ORed)
+ */
+#define DMA_MODE_PERIPH_INC			0x00000200	/* Increment the peripheral (source for memory to memory) address */
+#define DMA_MODE_MEM_INC			0x00000400	/* Increment the memory address */
+#define DMA_MODE_CIRCULAR			0x00000100	/* Reload the count and the addresses at the end of the transfer */
+#define DMA_MODE_DOUBLE_BUFFER		0x00040000	/* Circular ping-pong between memory 0 and memory 1 */
+
+/**
+ * Data size options (peripheral and memory sides)
+ */
+#define DMA_SIZE_BYTE				0
+#define DMA_SIZE_HALFWORD			1
+#define DMA_SIZE_WORD				2
+
+/**
+ * Priority options (between the streams of the same controller)
+ */
+#define DMA_PRIORITY_LOW			0
+#define DMA_PRIORITY_MEDIUM			1
+#define DMA_PRIORITY_HIGH			2
+#define DMA_PRIORITY_VERY_HIGH		3
+
+/**
+ * FIFO options: direct mode (no FIFO, no burst) or the FIFO threshold
+ */
+#define DMA_FIFO_1_4				0
+#define DMA_FIFO_1_2				1
+#define DMA_FIFO_3_4				2
+#define DMA_FIFO_FULL				3
+#define DMA_FIFO_DIRECT				4
+
+/**
+ * Burst options (FIFO mode only, the burst must fit in the FIFO threshold)
+ */
+#define DMA_BURST_SINGLE			0
+#define DMA_BURST_INC4				1
+#define DMA_BURST_INC8				2
+#define DMA_BURST_INC16				3
+
+/**
+ * Callback events (can be ORed)
+ */
+#define DMA_EVENT_HALF				0x01	/* Half of the count transferred */
+#define DMA_EVENT_COMPLETE			0x02	/* Count transferred (end of a buffer in circular/double buffer mode) */
+#define DMA_EVENT_ERROR				0x04	/* Bus or direct mode error: the stream is stopped */
+#define DMA_EVENT_FIFO_ERROR		0x08	/* FIFO overrun/underrun */
+#define DMA_EVENT_MEMORY1			0x10	/* Set with HALF/COMPLETE when they concern memory 1 (double buffer) */
+
+#define DMA_STREAMS					16
+#define DMA_MAX_COUNT				0xFFFF
+
+/*===========================================================================================================*/
+/*												     Types		 										     */
+/*===========================================================================================================*/
+typedef enum
+{
+	DMA_enuDma1Stream0	,
+	DMA_enuDma1Stream1	,
+	DMA_enuDma1Stream2	,
+	DMA_enuDma1Stream3	,
+	DMA_enuDma1Stream4	,
+	DMA_enuDma1Stream5	,
+	DMA_enuDma1Stream6	,
+	DMA_enuDma1Stream7	,
+	DMA_enuDma2Stream0	,
+	DMA_enuDma2Stream1	,
+	DMA_enuDma2Stream2	,
+	DMA_enuDma2Stream3	,
+	DMA_enuDma2Stream4	,
+	DMA_enuDma2Stream5	,
+	DMA_enuDma2Stream6	,
+	DMA_enuDma2Stream7
+}DMA_enuStream_t;
+
+/* Stream callback: called from the stream interrupt with the DMA_EVENT_xxx that occurred */
+typedef void (*DMA_CBF_t)(DMA_enuStream_t Copy_enuStream, u8 Copy_u8Events);
+
+typedef struct
+{
+	/**
+	 * The request channel of the stream (see the request mapping tables of the reference manual)
+	 * Range: [0 - 7] (ignored for memory to memory)
+	 */
+	u8 Channel;
+
+	/**
+	 * Options: DMA_PERIPH_TO_MEM, DMA_MEM_TO_PERIPH, DMA_MEM_TO_MEM
+	 */
+	u32 Direction;
+
+	/**
+	 * ORed DMA_MODE_xxx options (0: fixed addresses, one shot)
+	 */
+	u32 Mode;
+
+	/**
+	 * Options: DMA_PRIORITY_LOW ... DMA_PRIORITY_VERY_HIGH
+	 */
+	u8 Priority;
+
+	/**
+	 * Options: DMA_SIZE_BYTE, DMA_SIZE_HALFWORD, DMA_SIZE_WORD
+	 * (the transfer count is in peripheral size items)
+	 */
+	u8 PeriphSize;
+	u8 MemSize;
+
+	/**
+	 * Options: DMA_FIFO_DIRECT, DMA_FIFO_1_4 ... DMA_FIFO_FULL
+	 * (memory to memory and different sizes need the FIFO)
+	 */
+	u8 Fifo;
+
+	/**
+	 * Options: DMA_BURST_SINGLE, DMA_BURST_INC4, DMA_BURST_INC8, DMA_BURST_INC16
+	 */
+	u8 PeriphBurst;
+	u8 MemBurst;
+
+	/**
+	 * ORed DMA_EVENT_xxx reported to the callback (DMA_EVENT_MEMORY1 is implied)
+	 */
+	u8 Events;
+
+	/**
+	 * Can be NULL (the stream is polled with DMA_u16GetRemaining)
+	 */
+	DMA_CBF_t Callback;
+}DMA_strConfig_t;
+
+/*===========================================================================================================*/
+/*											 Function Prototypes											 */
+/*===========================================================================================================*/
+
+/**
+ * @brief Reserves a stream for the caller and enables its controller clock
+ *
+ * The DMAx_StreamN_IRQn of the streams that report events must be enabled in NVIC_cfg.c.
+ *
+ * @param[in] Copy_enuStream	: the stream (DMA_enuDma1Stream0 ... DMA_enuDma2Stream7)
+ *
+ * @return STD_enuErrorStatus_t : STD_enuOk 			 : Successful Operation
+ * 								  STD_enuInvalidValue	 : Invalid stream
+ * 								  STD_enuInvalidState	 : The stream is already reserved
+ * 								  STD_enuOperationFailed : The controller clock could not be enabled
+ */
+STD_enuErrorStatus_t DMA_enuAcquireStream(DMA_enuStream_t Copy_enuStream);
+
+/**
+ * @brief Reserves the first free stream in a range (e.g. any DMA2 stream for memory to memory)
+ *
+ * @param[in]  Copy_enuFirst	: first stream of the range
+ * @param[in]  Copy_enuLast		: last stream of the range
+ * @param[out] Add_penuStream	: the reserved stream
+ *
+ * @return STD_enuErrorStatus_t : STD_enuOk 			 : Successful Operation
+ * 								  STD_enuNullPtr		 : Add_penuStream is a NULL pointer
+ * 								  STD_enuInvalidValue	 : Invalid range
+ * 								  STD_enuInvalidState	 : All the streams of the range are reserved
+ * 								  STD_enuOperationFailed : The controller clock could not be enabled
+ */
+STD_enuErrorStatus_t DMA_enuAcquireFreeStream(DMA_enuStream_t Copy_enuFirst, DMA_enuStream_t Copy_enuLast, DMA_enuStream_t* Add_penuStream);
+
+/**
+ * @brief Stops a reserved stream and frees it (the controller clock is released)
+ *
+ * @param[in] Copy_enuStream	: the stream
+ *
+ * @return STD_enuErrorStatus_t : STD_enuOk 			 : Successful Operation
+ * 								  STD_enuInvalidValue	 : Invalid stream
+ * 								  STD_enuInvalidState	 : The stream is not reserved
+ */
+STD_enuErrorStatus_t DMA_enuReleaseStream(DMA_enuStream_t Copy_enuStream);
+
+/**
+ * @brief Configures a reserved and stopped stream
+ *
+ * @param[in] Copy_enuStream	: the stream
+ * @param[in] Add_pstrConfig	: the stream configuration
+ *
+ * @return STD_enuErrorStatus_t : STD_enuOk 			 : Successful Operation
+ * 								  STD_enuNullPtr		 : Add_pstrConfig is a NULL pointer
+ * 								  STD_enuInvalidValue	 : Invalid stream
+ * 								  STD_enuInvalidState	 : The stream is not reserved / is running
+ * 								  STD_enuInvalidConfig	 : Invalid or unsupported combination of options
+ */
+STD_enuErrorStatus_t DMA_enuConfigure(DMA_enuStream_t Copy_enuStream, const DMA_strConfig_t* Add_pstrConfig);
+
+/**
+ * @brief Starts a transfer on a configured stream (the call does not wait)
+ *
+ * For memory to memory the peripheral address is the source and the memory address the destination.
+ *
+ * @param[in] Copy_enuStream		: the stream
+ * @param[in] Copy_u32PeriphAddress	: the peripheral data register (or the source)
+ * @param[in] Copy_u32MemAddress	: the memory buffer (memory 0 in double buffer mode)
+ * @param[in] Copy_u16Count			: number of peripheral size items [1 - 65535]
+ *
+ * @return STD_enuErrorStatus_t : STD_enuOk 			 : Successful Operation
+ * 								  STD_enuInvalidValue	 : Invalid stream / count / address alignment
+ * 								  STD_enuInvalidState	 : The stream is not configured / is running
+ */
+STD_enuErrorStatus_t DMA_enuStart(DMA_enuStream_t Copy_enuStream, u32 Copy_u32PeriphAddress, u32 Copy_u32MemAddress, u16 Copy_u16Count);
+
+/**
+ * @brief Starts a double buffer (ping-pong) transfer: the stream fills/drains memory 0 then
+ *        memory 1 and back, each end of buffer reports DMA_EVENT_COMPLETE (with DMA_EVENT_MEMORY1
+ *        for memory 1) while the other buffer is in use
+ *
+ * @param[in] Copy_enuStream		: the stream (configured with DMA_MODE_DOUBLE_BUFFER)
+ * @param[in] Copy_u32PeriphAddress	: the peripheral data register
+ * @param[in] Copy_u32Mem0Address	: memory 0
+ * @param[in] Copy_u32Mem1Address	: memory 1
+ * @param[in] Copy_u16Count			: number of peripheral size items per buffer [1 - 65535]
+ *
+ * @return STD_enuErrorStatus_t : STD_enuOk 			 : Successful Operation
+ * 								  STD_enuInvalidValue	 : Invalid stream / count / address alignment
+ * 								  STD_enuInvalidState	 : The stream is not configured for double buffer / is running
+ */
+STD_enuErrorStatus_t DMA_enuStartDoubleBuffer(DMA_enuStream_t Copy_enuStream, u32 Copy_u32PeriphAddress,
+											  u32 Copy_u32Mem0Address, u32 Copy_u32Mem1Address, u16 Copy_u16Count);
+
+/**
+ * @brief Replaces the buffer the stream is not using in double buffer mode
+ *        (typically from the DMA_EVENT_COMPLETE callback of that buffer)
+ *
+ * @param[in] Copy_enuStream		: the stream
+ * @param[in] Copy_u32MemAddress	: the new buffer
+ *
+ * @return STD_enuErrorStatus_t : STD_enuOk 			 : Successful Operation
+ * 								  STD_enuInvalidValue	 : Invalid stream / address alignment
+ * 								  STD_enuInvalidState	 : The stream is not running in double buffer mode
+ */
+STD_enuErrorStatus_t DMA_enuSetNextBuffer(DMA_enuStream_t Copy_enuStream, u32 Copy_u32MemAddress);
+
+/**
+ * @brief Stops a stream (the current data item completes first) and clears its events
+ *
+ * @param[in] Copy_enuStream	: the stream
+ *
+ * @return STD_enuErrorStatus_t : STD_enuOk 			 : Successful Operation
+ * 								  STD_enuInvalidValue	 : Invalid stream
+ * 								  STD_enuInvalidState	 : The stream is not reserved
+ * 								  STD_enuOperationFailed : The stream did not stop
+ */
+STD_enuErrorStatus_t DMA_enuStop(DMA_enuStream_t Copy_enuStream);
+
+/**
+ * @brief Returns the number of items left in the current buffer of a stream
+ *
+ * @param[in] Copy_enuStream	: the stream
+ *
+ * @return u16 : the NDTR register (0 for an invalid stream)
+ */
+u16 DMA_u16GetRemaining(DMA_enuStream_t Copy_enuStream);
+
+/**
+ * @brief Checks whether a stream is transferring
+ *
+ * @param[in] Copy_enuStream	: the stream
+ *
+ * @return u8 : 1 while the stream is enabled, 0 otherwise
+ */
+u8 DMA_u8IsBusy(DMA_enuStream_t Copy_enuStream);
+
+#endif /* DMA_H_ */
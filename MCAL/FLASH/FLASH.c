@@ -0,0 +1,204 @@
+/*
+ * @file  : FLASH.c
+ * @brief : API Implementations for the FLASH interface (wait states & ART accelerator)
+ * @author: Alaa Hisham
+ * @date  : 16-03-2024
+ */
+/*===========================================================================================================*/
+/*												    Includes		 										 */
+/*===========================================================================================================*/
+
+#include "STD_TYPES.h"
+#include "BIT_MATH.h"
+
+#include "FLASH.h"
+#include "FLASH_cfg.h"
+
+/*===========================================================================================================*/
+/*												     Macros		 										     */
+/*===========================================================================================================*/
+#define FLASH               ((volatile FLASH_t*)0x40023C00)
+
+#define ACR_LATENCY_MASK    0x0000000F
+#define ACR_ICRST_MASK      0x00000800
+#define ACR_DCRST_MASK      0x00001000
+
+#define ACCELERATORS_MASK   (FLASH_PREFETCH | FLASH_ICACHE | FLASH_DCACHE)
+
+#if ((FLASH_CFG_VOLTAGE_RANGE != FLASH_VOLTAGE_2V7_3V6) && (FLASH_CFG_VOLTAGE_RANGE != FLASH_VOLTAGE_2V4_2V7) \
+  && (FLASH_CFG_VOLTAGE_RANGE != FLASH_VOLTAGE_2V1_2V4) && (FLASH_CFG_VOLTAGE_RANGE != FLASH_VOLTAGE_1V7_2V1))
+#error "FLASH_CFG_VOLTAGE_RANGE: invalid voltage range option"
+#endif
+
+/*===========================================================================================================*/
+/*												     Types		 										     */
+/*===========================================================================================================*/
+typedef struct
+{
+    volatile u32 ACR;       /* Access control register */
+    volatile u32 KEYR;      /* Key register */
+    volatile u32 OPTKEYR;   /* Option key register */
+    volatile u32 SR;        /* Status register */
+    volatile u32 CR;        /* Control register */
+    volatile u32 OPTCR;     /* Option control register */
+} FLASH_t;
+
+/*===========================================================================================================*/
+/*										  	  API Implementations											 */
+/*===========================================================================================================*/
+/**
+ * @brief Enables the flash accelerators configured in FLASH_cfg.h
+ *        (prefetch buffer, instruction cache, data cache)
+ *
+ * @return STD_enuErrorStatus_t : STD_enuOk 			 : Successful Operation
+ * 								  STD_enuInvalidConfig	 : Invalid accelerators configuration
+ */
+STD_enuErrorStatus_t FLASH_Init(void)
+{
+    STD_enuErrorStatus_t loc_enuErrorStatus = STD_enuOk;
+
+    if(STD_enuOk != FLASH_enuEnableAccelerators(FLASH_CFG_ACCELERATORS))
+    {
+        loc_enuErrorStatus = STD_enuInvalidConfig;
+    }
+    else
+    {
+        /* Do Nothing */
+    }
+
+    return loc_enuErrorStatus;
+}
+
+/**
+ * @brief Sets the flash wait states (LATENCY) required by the given HCLK
+ *        for the voltage range configured in FLASH_cfg.h
+ *
+ * Must be called before raising HCLK and after lowering it.
+ *
+ * @param[in] Copy_u32HclkHz	: the HCLK frequency in Hz
+ *
+ * @return STD_enuErrorStatus_t : STD_enuOk 			 : Successful Operation
+ * 								  STD_enuInvalidValue	 : HCLK out of the flash interface range
+ * 								  STD_enuOperationFailed : The new latency was not taken into account
+ */
+STD_enuErrorStatus_t FLASH_enuSetLatencyForHclk(u32 Copy_u32HclkHz)
+{
+    STD_enuErrorStatus_t loc_enuErrorStatus = STD_enuOk;
+    u32 loc_u32Latency = ZERO;
+    u32 loc_u32Temp = ZERO;
+
+    if((ZERO == Copy_u32HclkHz) || (Copy_u32HclkHz > FLASH_MAX_HCLK_HZ))
+    {
+        loc_enuErrorStatus = STD_enuInvalidValue;
+    }
+    else
+    {
+        /* Each wait state covers one voltage range step of HCLK */
+        loc_u32Latency = (Copy_u32HclkHz - 1) / FLASH_CFG_VOLTAGE_RANGE;
+
+        loc_u32Temp = FLASH->ACR;
+
+        if((loc_u32Temp & ACR_LATENCY_MASK) != loc_u32Latency)
+        {
+            loc_u32Temp &= ~ACR_LATENCY_MASK;
+            loc_u32Temp |= loc_u32Latency;
+            FLASH->ACR = loc_u32Temp;
+
+            /* The new latency must be read back before HCLK is changed */
+            if((FLASH->ACR & ACR_LATENCY_MASK) != loc_u32Latency)
+            {
+                loc_enuErrorStatus = STD_enuOperationFailed;
+            }
+            else
+            {
+                /* Do Nothing */
+            }
+        }
+        else
+        {
+            /* Do Nothing */
+        }
+    }
+
+    return loc_enuErrorStatus;
+}
+
+/**
+ * @brief Returns the currently programmed number of flash wait states
+ *
+ * @return u8 : the LATENCY field of FLASH_ACR
+ */
+u8 FLASH_u8GetLatency(void)
+{
+    return (u8)(FLASH->ACR & ACR_LATENCY_MASK);
+}
+
+/**
+ * @brief Enables the given flash accelerators
+ *        (caches that were off are reset before being enabled)
+ *
+ * @param[in] Copy_u32Accelerators	: FLASH_PREFETCH | FLASH_ICACHE | FLASH_DCACHE
+ *
+ * @return STD_enuErrorStatus_t : STD_enuOk 			 : Successful Operation
+ * 								  STD_enuInvalidValue	 : Invalid accelerator option
+ */
+STD_enuErrorStatus_t FLASH_enuEnableAccelerators(u32 Copy_u32Accelerators)
+{
+    STD_enuErrorStatus_t loc_enuErrorStatus = STD_enuOk;
+    u32 loc_u32Reset = ZERO;
+
+    if(ZERO != (Copy_u32Accelerators & ~ACCELERATORS_MASK))
+    {
+        loc_enuErrorStatus = STD_enuInvalidValue;
+    }
+    else
+    {
+        /* A cache can only be reset while it's disabled */
+        if((Copy_u32Accelerators & FLASH_ICACHE) && !(FLASH->ACR & FLASH_ICACHE))
+        {
+            loc_u32Reset |= ACR_ICRST_MASK;
+        }
+        if((Copy_u32Accelerators & FLASH_DCACHE) && !(FLASH->ACR & FLASH_DCACHE))
+        {
+            loc_u32Reset |= ACR_DCRST_MASK;
+        }
+
+        if(ZERO != loc_u32Reset)
+        {
+            FLASH->ACR |= loc_u32Reset;
+            FLASH->ACR &= ~loc_u32Reset;
+        }
+        else
+        {
+            /* Do Nothing */
+        }
+
+        FLASH->ACR |= Copy_u32Accelerators;
+    }
+
+    return loc_enuErrorStatus;
+}
+
+/**
+ * @brief Disables the given flash accelerators
+ *
+ * @param[in] Copy_u32Accelerators	: FLASH_PREFETCH | FLASH_ICACHE | FLASH_DCACHE
+ *
+ * @return STD_enuErrorStatus_t : STD_enuOk 			 : Successful Operation
+ * 								  STD_enuInvalidValue	 : Invalid accelerator option
+ */
+STD_enuErrorStatus_t FLASH_enuDisableAccelerators(u32 Copy_u32Accelerators)
+{
+    STD_enuErrorStatus_t loc_enuErrorStatus = STD_enuOk;
+
+    if(ZERO != (Copy_u32Accelerators & ~ACCELERATORS_MASK))
+    {
+        loc_enuErrorStatus = STD_enuInvalidValue;
+    }
+    else
+    {
+        FLASH->ACR &= ~Copy_u32Accelerators;
+    }
+
+    return loc_enuErrorStatus;
+}
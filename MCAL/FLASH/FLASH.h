@@ -0,0 +1,94 @@
+/*
+ * @file  : FLASH.h
+ * @brief : user interface for the FLASH interface (wait states & ART accelerator)
+ * @author: Alaa Hisham
+ * @date  : 16-03-2024
+ */
+
+#ifndef FLASH_H_
+#define FLASH_H_
+
+/*===========================================================================================================*/
+/*												    Includes	 										     */
+/*===========================================================================================================*/
+#include "STD_TYPES.h"
+
+/*===========================================================================================================*/
+/*												     Macros		 										     */
+/*===========================================================================================================*/
+/**
+ * Supply voltage range options (HCLK covered by each wait state, in Hz)
+ */
+#define FLASH_VOLTAGE_2V7_3V6       30000000UL
+#define FLASH_VOLTAGE_2V4_2V7       24000000UL
+#define FLASH_VOLTAGE_2V1_2V4       18000000UL
+#define FLASH_VOLTAGE_1V7_2V1       16000000UL
+
+/**
+ * Flash accelerator options (can be ORed)
+ */
+#define FLASH_PREFETCH              0x00000100
+#define FLASH_ICACHE                0x00000200
+#define FLASH_DCACHE                0x00000400
+
+/**
+ * Maximum HCLK supported by the flash interface
+ */
+#define FLASH_MAX_HCLK_HZ           84000000UL
+
+/*===========================================================================================================*/
+/*											 Function Prototypes											 */
+/*===========================================================================================================*/
+
+/**
+ * @brief Enables the flash accelerators configured in FLASH_cfg.h
+ *        (prefetch buffer, instruction cache, data cache)
+ *
+ * @return STD_enuErrorStatus_t : STD_enuOk 			 : Successful Operation
+ * 								  STD_enuInvalidConfig	 : Invalid accelerators configuration
+ */
+STD_enuErrorStatus_t FLASH_Init(void);
+
+/**
+ * @brief Sets the flash wait states (LATENCY) required by the given HCLK
+ *        for the voltage range configured in FLASH_cfg.h
+ *
+ * Must be called before raising HCLK and after lowering it.
+ *
+ * @param[in] Copy_u32HclkHz	: the HCLK frequency in Hz
+ *
+ * @return STD_enuErrorStatus_t : STD_enuOk 			 : Successful Operation
+ * 								  STD_enuInvalidValue	 : HCLK out of the flash interface range
+ * 								  STD_enuOperationFailed : The new latency was not taken into account
+ */
+STD_enuErrorStatus_t FLASH_enuSetLatencyForHclk(u32 Copy_u32HclkHz);
+
+/**
+ * @brief Returns the currently programmed number of flash wait states
+ *
+ * @return u8 : the LATENCY field of FLASH_ACR
+ */
+u8 FLASH_u8GetLatency(void);
+
+/**
+ * @brief Enables the given flash accelerators
+ *        (caches that were off are reset before being enabled)
+ *
+ * @param[in] Copy_u32Accelerators	: FLASH_PREFETCH | FLASH_ICACHE | FLASH_DCACHE
+ *
+ * @return STD_enuErrorStatus_t : STD_enuOk 			 : Successful Operation
+ * 								  STD_enuInvalidValue	 : Invalid accelerator option
+ */
+STD_enuErrorStatus_t FLASH_enuEnableAccelerators(u32 Copy_u32Accelerators);
+
+/**
+ * @brief Disables the given flash accelerators
+ *
+ * @param[in] Copy_u32Accelerators	: FLASH_PREFETCH | FLASH_ICACHE | FLASH_DCACHE
+ *
+ * @return STD_enuErrorStatus_t : STD_enuOk 			 : Successful Operation
+ * 								  STD_enuInvalidValue	 : Invalid accelerator option
+ */
+STD_enuErrorStatus_t FLASH_enuDisableAccelerators(u32 Copy_u32Accelerators);
+
+#endif /* FLASH_H_ */
@@ -0,0 +1,24 @@
+/*
+ * @file  : FLASH_cfg.h
+ * @brief : pre-compile configurations for the FLASH interface
+ * @author: Alaa Hisham
+ * @date  : 16-03-2024
+ */
+
+#ifndef FLASH_CFG_H_
+#define FLASH_CFG_H_
+
+/**
+ * @brief The supply voltage range of the board (sets the HCLK step per wait state)
+ *        Options: FLASH_VOLTAGE_2V7_3V6, FLASH_VOLTAGE_2V4_2V7,
+ *                 FLASH_VOLTAGE_2V1_2V4, FLASH_VOLTAGE_1V7_2V1
+ */
+#define FLASH_CFG_VOLTAGE_RANGE         FLASH_VOLTAGE_2V7_3V6
+
+/**
+ * @brief Flash accelerators enabled by FLASH_Init
+ *        Options: any combination of FLASH_PREFETCH | FLASH_ICACHE | FLASH_DCACHE (or 0)
+ */
+#define FLASH_CFG_ACCELERATORS          (FLASH_PREFETCH | FLASH_ICACHE | FLASH_DCACHE)
+
+#endif /* FLASH_CFG_H_ */
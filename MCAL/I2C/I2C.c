@@ -0,0 +1,887 @@
+/*
+ * @file  : I2C.c
+ * @brief : API Implementations for the I2C peripherals (interrupt driven master, DMA reads, transaction queue)
+ * @author: Alaa Hisham
+ * @date  : 31-03-2024
+ */
+/*===========================================================================================================*/
+/*												    Includes		 										 */
+/*===========================================================================================================*/
+
+#include "STD_TYPES.h"
+#include "BIT_MATH.h"
+
+#include "RCC.h"
+#include "DMA.h"
+#include "GPIO.h"
+#include "I2C.h"
+#include "I2C_cfg.h"
+
+/*===========================================================================================================*/
+/*												     Macros		 										     */
+/*===========================================================================================================*/
+#define I2C1                ((volatile I2C_t*)0x40005400)
+#define I2C2                ((volatile I2C_t*)0x40005800)
+#define I2C3                ((volatile I2C_t*)0x40005C00)
+
+#define CR1_PE_MASK         0x00000001
+#define CR1_START_MASK      0x00000100
+#define CR1_STOP_MASK       0x00000200
+#define CR1_ACK_MASK        0x00000400
+#define CR1_SWRST_MASK      0x00008000
+
+#define CR2_ITERREN_MASK    0x00000100
+#define CR2_ITEVTEN_MASK    0x00000200
+#define CR2_ITBUFEN_MASK    0x00000400
+#define CR2_DMAEN_MASK      0x00000800
+#define CR2_LAST_MASK       0x00001000
+
+#define SR1_SB_MASK         0x00000001
+#define SR1_ADDR_MASK       0x00000002
+#define SR1_BTF_MASK        0x00000004
+#define SR1_RXNE_MASK       0x00000040
+#define SR1_TXE_MASK        0x00000080
+#define SR1_BERR_MASK       0x00000100
+#define SR1_ARLO_MASK       0x00000200
+#define SR1_AF_MASK         0x00000400
+#define SR1_OVR_MASK        0x00000800
+#define SR1_TIMEOUT_MASK    0x00004000
+#define SR1_ERRORS_MASK     (SR1_BERR_MASK | SR1_ARLO_MASK | SR1_AF_MASK | SR1_OVR_MASK | SR1_TIMEOUT_MASK)
+
+#define SR2_BUSY_MASK       0x00000002
+
+#define CCR_FS_MASK         0x00008000
+
+/* Timing limits (PCLK1 in MHz in CR2.FREQ) */
+#define FREQ_MIN_STANDARD   2
+#define FREQ_MIN_FAST       4
+#define FREQ_MAX            50
+#define CCR_MIN_STANDARD    4
+#define CCR_MIN_FAST        1
+#define CCR_MAX             0x0FFF
+#define HZ_PER_MHZ          1000000UL
+
+#define ADDRESS_MAX         0x7F
+#define READ_BIT            0x01
+
+/* Bus recovery: 9 clock pulses release any slave in the middle of a byte */
+#define RECOVERY_PULSES     9
+#define RECOVERY_LOOP_DIV   1600000UL       /* ~5 us per bus_delay (about 8 cycles per loop) */
+
+#define STOP_TIMEOUT        10000UL
+
+/* Transaction phases */
+#define PHASE_WRITE         0
+#define PHASE_READ          1
+
+/* PRIMASK save/restore around the state shared with the interrupts */
+#define ENTER_CRITICAL(STATE)   __asm volatile ("mrs %0, primask\n\tcpsid i" : "=r" (STATE) : : "memory")
+#define EXIT_CRITICAL(STATE)    __asm volatile ("msr primask, %0" : : "r" (STATE) : "memory")
+
+/* Active exception number: 0 in thread context */
+#define GET_IPSR(VALUE)         __asm volatile ("mrs %0, ipsr" : "=r" (VALUE))
+
+/*===========================================================================================================*/
+/*												     Types		 										     */
+/*===========================================================================================================*/
+typedef struct
+{
+    volatile u32 CR1;       /* Control register 1 */
+    volatile u32 CR2;       /* Control register 2 */
+    volatile u32 OAR1;      /* Own address register 1 */
+    volatile u32 OAR2;      /* Own address register 2 */
+    volatile u32 DR;        /* Data register */
+    volatile u32 SR1;       /* Status register 1 */
+    volatile u32 SR2;       /* Status register 2 */
+    volatile u32 CCR;       /* Clock control register */
+    volatile u32 TRISE;     /* Rise time register */
+    volatile u32 FLTR;      /* Filter register */
+} I2C_t;
+
+/* Fixed resources of a channel */
+typedef struct
+{
+    volatile I2C_t* I2c;
+    RCC_enuPeripheralIndex_t Clock;
+    DMA_enuStream_t RxStream;
+    u8 DmaChannel;
+} I2C_strChannelInfo_t;
+
+/* Bus timing registers for the current PCLK1 */
+typedef struct
+{
+    u32 Freq;
+    u32 Ccr;
+    u32 Trise;
+} I2C_strTiming_t;
+
+/* Run time state of a channel */
+typedef struct
+{
+    const I2C_strConfig_t* Config;      /* NULL while not initialized */
+    I2C_strTransaction_t* Head;         /* Transaction on the bus */
+    I2C_strTransaction_t* Tail;
+    I2C_strTiming_t Timing;
+    u8 Retime;                          /* Timing changed, applied before the next transaction */
+    u8 Phase;
+    u16 Index;                          /* Next byte written */
+} I2C_strChannelState_t;
+
+/*===========================================================================================================*/
+/*										  	   Global Variables											     */
+/*===========================================================================================================*/
+extern const I2C_strConfig_t I2C_strConfigArr[NUMBER_OF_CFG_I2CS];
+
+static const I2C_strChannelInfo_t I2C_strChannelInfo[I2C_CHANNELS] =
+{
+    [I2C_enuI2c1] = {I2C1, RCC_APB1_I2C1, DMA_enuDma1Stream0, 1},
+    [I2C_enuI2c2] = {I2C2, RCC_APB1_I2C2, DMA_enuDma1Stream2, 7},
+    [I2C_enuI2c3] = {I2C3, RCC_APB1_I2C3, DMA_enuDma1Stream1, 1}
+};
+
+static I2C_strChannelState_t I2C_strChannelState[I2C_CHANNELS];
+
+/*===========================================================================================================*/
+/*										  	   Private Functions											 */
+/*===========================================================================================================*/
+/**
+ * @brief Computes the timing registers of a bus speed for the given PCLK1
+ */
+static STD_enuErrorStatus_t compute_timing(u32 Copy_u32Pclk1Hz, u32 Copy_u32Speed, I2C_strTiming_t* Add_pstrTiming);
+
+/**
+ * @brief Resets the peripheral and programs the channel timing (the peripheral is left enabled)
+ */
+static void apply_timing(I2C_enuChannel_t Copy_enuChannel);
+
+static void clk_change(RCC_enuClkChangePhase_t Copy_enuPhase, const RCC_strClkTree_t* Add_pstrClkTree);
+
+static void bus_delay(void);
+
+/**
+ * @brief Clocks SCL by hand until SDA is released then generates a stop condition
+ *
+ * @return u8 : 1 if the bus is free afterwards
+ */
+static u8 recover_bus(I2C_enuChannel_t Copy_enuChannel);
+
+/**
+ * @brief Generates the start condition of the head transaction
+ *
+ * @return STD_enuErrorStatus_t : STD_enuOperationFailed if the bus is busy (not recovered here:
+ *                                this may run from interrupt context)
+ */
+static STD_enuErrorStatus_t start_transaction(I2C_enuChannel_t Copy_enuChannel);
+
+/**
+ * @brief Starts the queued transactions until one gets the bus (the others fail)
+ */
+static void run_queue(I2C_enuChannel_t Copy_enuChannel);
+
+/**
+ * @brief Completes the head transaction and starts the next one
+ */
+static void end_transaction(I2C_enuChannel_t Copy_enuChannel, I2C_enuState_t Copy_enuState);
+
+static void ev_irq(I2C_enuChannel_t Copy_enuChannel);
+
+static void er_irq(I2C_enuChannel_t Copy_enuChannel);
+
+/**
+ * @brief DMA callback of the reception streams of all the channels
+ */
+static void dma_event(DMA_enuStream_t Copy_enuStream, u8 Copy_u8Events);
+
+/*===========================================================================================================*/
+/*										  	  API Implementations											 */
+/*===========================================================================================================*/
+/**
+ * @brief Initializes the channels configured in I2C_cfg.c as masters, reserves their reception
+ *        DMA stream and recovers a bus left stuck by a slave
+ *
+ * @return STD_enuErrorStatus_t : STD_enuOk 			 : Successful Operation
+ * 								  STD_enuInvalidConfig	 : Invalid channel configuration / PCLK1 out of range (channel left disabled)
+ * 								  STD_enuOperationFailed : A peripheral clock or a DMA stream could not be reserved
+ */
+STD_enuErrorStatus_t I2C_Init(void)
+{
+    static RCC_strClkSubscriber_t loc_strClkSubscriber = {clk_change, NULL};
+    STD_enuErrorStatus_t loc_enuErrorStatus = STD_enuOk;
+    const I2C_strConfig_t* loc_pstrConfig = NULL;
+    const I2C_strChannelInfo_t* loc_pstrInfo = NULL;
+    DMA_strConfig_t loc_strDmaConfig = {ZERO};
+    I2C_strTiming_t loc_strTiming = {ZERO};
+    u8 loc_u8Iterator = ZERO;
+
+    for(loc_u8Iterator = ZERO; loc_u8Iterator < NUMBER_OF_CFG_I2CS; loc_u8Iterator++)
+    {
+        loc_pstrConfig = &I2C_strConfigArr[loc_u8Iterator];
+
+        if((loc_pstrConfig->Channel >= I2C_CHANNELS)
+        || (NULL != I2C_strChannelState[loc_pstrConfig->Channel].Config)
+        || (NULL == loc_pstrConfig->SclPort) || (NULL == loc_pstrConfig->SdaPort)
+        || (loc_pstrConfig->SclPin >= GPIO_TOTAL_PINS) || (loc_pstrConfig->SdaPin >= GPIO_TOTAL_PINS)
+        || (STD_enuOk != compute_timing(RCC_u32GetPclk1Hz(), loc_pstrConfig->Speed, &loc_strTiming)))
+        {
+            loc_enuErrorStatus = STD_enuInvalidConfig;
+        }
+        else
+        {
+            loc_pstrInfo = &I2C_strChannelInfo[loc_pstrConfig->Channel];
+
+            /* A channel left disabled keeps none of its resources */
+            if(STD_enuOk != RCC_enuAcquirePeripheralClk(loc_pstrInfo->Clock))
+            {
+                loc_enuErrorStatus = STD_enuOperationFailed;
+            }
+            else if(STD_enuOk != DMA_enuAcquireStream(loc_pstrInfo->RxStream))
+            {
+                RCC_enuReleasePeripheralClk(loc_pstrInfo->Clock);
+                loc_enuErrorStatus = STD_enuOperationFailed;
+            }
+            else
+            {
+                /* Reads of 2 bytes and more: the DMA fills RxData, the last byte is NACKed by the hardware (LAST) */
+                loc_strDmaConfig.Channel = loc_pstrInfo->DmaChannel;
+                loc_strDmaConfig.Direction = DMA_PERIPH_TO_MEM;
+                loc_strDmaConfig.Mode = DMA_MODE_MEM_INC;
+                loc_strDmaConfig.Priority = DMA_PRIORITY_HIGH;
+                loc_strDmaConfig.PeriphSize = DMA_SIZE_BYTE;
+                loc_strDmaConfig.MemSize = DMA_SIZE_BYTE;
+                loc_strDmaConfig.Fifo = DMA_FIFO_DIRECT;
+                loc_strDmaConfig.Events = DMA_EVENT_COMPLETE | DMA_EVENT_ERROR;
+                loc_strDmaConfig.Callback = dma_event;
+                DMA_enuConfigure(loc_pstrInfo->RxStream, &loc_strDmaConfig);
+
+                I2C_strChannelState[loc_pstrConfig->Channel].Head = NULL;
+                I2C_strChannelState[loc_pstrConfig->Channel].Tail = NULL;
+                I2C_strChannelState[loc_pstrConfig->Channel].Timing = loc_strTiming;
+                I2C_strChannelState[loc_pstrConfig->Channel].Config = loc_pstrConfig;
+
+                apply_timing(loc_pstrConfig->Channel);
+
+                /* A slave reset in the middle of a read may still hold SDA low */
+                if(loc_pstrInfo->I2c->SR2 & SR2_BUSY_MASK)
+                {
+                    recover_bus(loc_pstrConfig->Channel);
+                }
+                else
+                {
+                    /* Do Nothing */
+                }
+            }
+        }
+    }
+
+    /* The bus timing follows PCLK1 (subscribing twice is rejected by RCC) */
+    RCC_enuSubscribeClkChange(&loc_strClkSubscriber);
+
+    return loc_enuErrorStatus;
+}
+
+/**
+ * @brief Queues a transaction, it runs after the transactions already queued on the channel
+ *        (the call does not wait)
+ *
+ * @param[in] Copy_enuChannel		: the channel (I2C_enuI2c1 ... I2C_enuI2c3)
+ * @param[in] Add_pstrTransaction	: the transaction
+ *
+ * @return STD_enuErrorStatus_t : STD_enuOk 		  : Successful Operation
+ * 								  STD_enuNullPtr	  : Add_pstrTransaction or a buffer with a length is a NULL pointer
+ * 								  STD_enuInvalidValue : Invalid channel / address / no data
+ * 								  STD_enuInvalidState : The channel is not initialized / the transaction is still pending
+ */
+STD_enuErrorStatus_t I2C_enuSubmit(I2C_enuChannel_t Copy_enuChannel, I2C_strTransaction_t* Add_pstrTransaction)
+{
+    STD_enuErrorStatus_t loc_enuErrorStatus = STD_enuOk;
+    I2C_strChannelState_t* loc_pstrState = NULL;
+    u32 loc_u32Primask = ZERO;
+    u32 loc_u32Ipsr = ZERO;
+    u8 loc_u8Recover = ZERO;
+
+    if(NULL == Add_pstrTransaction)
+    {
+        loc_enuErrorStatus = STD_enuNullPtr;
+    }
+    else if(((ZERO != Add_pstrTransaction->TxLength) && (NULL == Add_pstrTransaction->TxData))
+         || ((ZERO != Add_pstrTransaction->RxLength) && (NULL == Add_pstrTransaction->RxData)))
+    {
+        loc_enuErrorStatus = STD_enuNullPtr;
+    }
+    else if((Copy_enuChannel >= I2C_CHANNELS) || (Add_pstrTransaction->Address > ADDRESS_MAX)
+         || ((ZERO == Add_pstrTransaction->TxLength) && (ZERO == Add_pstrTransaction->RxLength)))
+    {
+        loc_enuErrorStatus = STD_enuInvalidValue;
+    }
+    else if(NULL == I2C_strChannelState[Copy_enuChannel].Config)
+    {
+        loc_enuErrorStatus = STD_enuInvalidState;
+    }
+    else
+    {
+        loc_pstrState = &I2C_strChannelState[Copy_enuChannel];
+        GET_IPSR(loc_u32Ipsr);
+
+        ENTER_CRITICAL(loc_u32Primask);
+
+        if((I2C_enuQueued == Add_pstrTransaction->State) || (I2C_enuRunning == Add_pstrTransaction->State))
+        {
+            loc_enuErrorStatus = STD_enuInvalidState;
+        }
+        else
+        {
+            Add_pstrTransaction->State = I2C_enuQueued;
+            Add_pstrTransaction->Next = NULL;
+
+            if(NULL == loc_pstrState->Head)
+            {
+                loc_pstrState->Head = Add_pstrTransaction;
+                loc_pstrState->Tail = Add_pstrTransaction;
+
+                /* A stuck bus is only clocked out from thread context (the queued head keeps the channel) */
+                if((ZERO == loc_u32Ipsr) && (I2C_strChannelInfo[Copy_enuChannel].I2c->SR2 & SR2_BUSY_MASK))
+                {
+                    loc_u8Recover = 1;
+                }
+                else
+                {
+                    run_queue(Copy_enuChannel);
+                }
+            }
+            else
+            {
+                loc_pstrState->Tail->Next = Add_pstrTransaction;
+                loc_pstrState->Tail = Add_pstrTransaction;
+            }
+        }
+
+        EXIT_CRITICAL(loc_u32Primask);
+
+        if(loc_u8Recover)
+        {
+            recover_bus(Copy_enuChannel);
+
+            /* The transactions fail if the bus is still busy */
+            ENTER_CRITICAL(loc_u32Primask);
+            run_queue(Copy_enuChannel);
+            EXIT_CRITICAL(loc_u32Primask);
+        }
+        else
+        {
+            /* Do Nothing */
+        }
+    }
+
+    return loc_enuErrorStatus;
+}
+
+/**
+ * @brief Frees a bus held low by a slave: up to 9 SCL pulses then a stop condition, and resets
+ *        the peripheral
+ *
+ * @param[in] Copy_enuChannel	: the channel
+ *
+ * @return STD_enuErrorStatus_t : STD_enuOk 			 : Successful Operation (the bus is free)
+ * 								  STD_enuInvalidValue	 : Invalid channel
+ * 								  STD_enuInvalidState	 : The channel is not initialized / transactions are queued
+ * 								  STD_enuOperationFailed : SDA is still held low
+ */
+STD_enuErrorStatus_t I2C_enuRecoverBus(I2C_enuChannel_t Copy_enuChannel)
+{
+    STD_enuErrorStatus_t loc_enuErrorStatus = STD_enuOk;
+
+    if(Copy_enuChannel >= I2C_CHANNELS)
+    {
+        loc_enuErrorStatus = STD_enuInvalidValue;
+    }
+    else if((NULL == I2C_strChannelState[Copy_enuChannel].Config) || (NULL != I2C_strChannelState[Copy_enuChannel].Head))
+    {
+        loc_enuErrorStatus = STD_enuInvalidState;
+    }
+    else if(!recover_bus(Copy_enuChannel))
+    {
+        loc_enuErrorStatus = STD_enuOperationFailed;
+    }
+    else
+    {
+        /* Do Nothing */
+    }
+
+    return loc_enuErrorStatus;
+}
+
+/**
+ * @brief I2C interrupts: the event interrupt runs the transaction state machine, the error
+ *        interrupt ends the transaction
+ */
+void I2C1_EV_IRQHandler(void)
+{
+    ev_irq(I2C_enuI2c1);
+}
+
+void I2C1_ER_IRQHandler(void)
+{
+    er_irq(I2C_enuI2c1);
+}
+
+void I2C2_EV_IRQHandler(void)
+{
+    ev_irq(I2C_enuI2c2);
+}
+
+void I2C2_ER_IRQHandler(void)
+{
+    er_irq(I2C_enuI2c2);
+}
+
+void I2C3_EV_IRQHandler(void)
+{
+    ev_irq(I2C_enuI2c3);
+}
+
+void I2C3_ER_IRQHandler(void)
+{
+    er_irq(I2C_enuI2c3);
+}
+
+/*===========================================================================================================*/
+/*										  	 Private Implementations										 */
+/*===========================================================================================================*/
+static STD_enuErrorStatus_t compute_timing(u32 Copy_u32Pclk1Hz, u32 Copy_u32Speed, I2C_strTiming_t* Add_pstrTiming)
+{
+    STD_enuErrorStatus_t loc_enuErrorStatus = STD_enuOk;
+    u32 loc_u32Freq = Copy_u32Pclk1Hz / HZ_PER_MHZ;
+    u32 loc_u32Ccr = ZERO;
+
+    if(I2C_SPEED_STANDARD == Copy_u32Speed)
+    {
+        /* Thigh = Tlow = CCR x TPCLK1, rounded up so the bus is never faster than asked */
+        loc_u32Ccr = (Copy_u32Pclk1Hz + (2 * Copy_u32Speed) - 1) / (2 * Copy_u32Speed);
+        loc_u32Ccr = (loc_u32Ccr < CCR_MIN_STANDARD) ? CCR_MIN_STANDARD : loc_u32Ccr;
+
+        if((loc_u32Freq < FREQ_MIN_STANDARD) || (loc_u32Freq > FREQ_MAX) || (loc_u32Ccr > CCR_MAX))
+        {
+            loc_enuErrorStatus = STD_enuInvalidValue;
+        }
+        else
+        {
+            Add_pstrTiming->Freq = loc_u32Freq;
+            Add_pstrTiming->Ccr = loc_u32Ccr;
+            Add_pstrTiming->Trise = loc_u32Freq + 1;            /* 1000 ns maximum rise time */
+        }
+    }
+    else if(I2C_SPEED_FAST == Copy_u32Speed)
+    {
+        /* Tlow = 2 x Thigh = 2 x CCR x TPCLK1 */
+        loc_u32Ccr = (Copy_u32Pclk1Hz + (3 * Copy_u32Speed) - 1) / (3 * Copy_u32Speed);
+        loc_u32Ccr = (loc_u32Ccr < CCR_MIN_FAST) ? CCR_MIN_FAST : loc_u32Ccr;
+
+        if((loc_u32Freq < FREQ_MIN_FAST) || (loc_u32Freq > FREQ_MAX) || (loc_u32Ccr > CCR_MAX))
+        {
+            loc_enuErrorStatus = STD_enuInvalidValue;
+        }
+        else
+        {
+            Add_pstrTiming->Freq = loc_u32Freq;
+            Add_pstrTiming->Ccr = CCR_FS_MASK | loc_u32Ccr;
+            Add_pstrTiming->Trise = ((loc_u32Freq * 300) / 1000) + 1;   /* 300 ns maximum rise time */
+        }
+    }
+    else
+    {
+        loc_enuErrorStatus = STD_enuInvalidValue;
+    }
+
+    return loc_enuErrorStatus;
+}
+
+static void apply_timing(I2C_enuChannel_t Copy_enuChannel)
+{
+    volatile I2C_t* loc_pstrI2c = I2C_strChannelInfo[Copy_enuChannel].I2c;
+    const I2C_strTiming_t* loc_pstrTiming = &I2C_strChannelState[Copy_enuChannel].Timing;
+
+    /* The timing registers can only be written while the peripheral is disabled */
+    loc_pstrI2c->CR1   = CR1_SWRST_MASK;
+    loc_pstrI2c->CR1   = ZERO;
+    loc_pstrI2c->CR2   = loc_pstrTiming->Freq | CR2_ITERREN_MASK | CR2_ITEVTEN_MASK;
+    loc_pstrI2c->CCR   = loc_pstrTiming->Ccr;
+    loc_pstrI2c->TRISE = loc_pstrTiming->Trise;
+    loc_pstrI2c->CR1   = CR1_PE_MASK;
+
+    I2C_strChannelState[Copy_enuChannel].Retime = ZERO;
+}
+
+static void clk_change(RCC_enuClkChangePhase_t Copy_enuPhase, const RCC_strClkTree_t* Add_pstrClkTree)
+{
+    I2C_strTiming_t loc_strTiming = {ZERO};
+    u8 loc_u8Channel = ZERO;
+
+    if(RCC_enuClkPostChange == Copy_enuPhase)
+    {
+        for(loc_u8Channel = ZERO; loc_u8Channel < I2C_CHANNELS; loc_u8Channel++)
+        {
+            /* A speed the new clock can't generate keeps the old timing */
+            if((NULL != I2C_strChannelState[loc_u8Channel].Config)
+            && (STD_enuOk == compute_timing(Add_pstrClkTree->Pclk1Hz, I2C_strChannelState[loc_u8Channel].Config->Speed, &loc_strTiming)))
+            {
+                /* Applied between two transactions */
+                I2C_strChannelState[loc_u8Channel].Timing = loc_strTiming;
+                I2C_strChannelState[loc_u8Channel].Retime = 1;
+            }
+            else
+            {
+                /* Do Nothing */
+            }
+        }
+    }
+    else
+    {
+        /* Do Nothing */
+    }
+}
+
+static void bus_delay(void)
+{
+    volatile u32 loc_u32Loops = RCC_u32GetHclkHz() / RECOVERY_LOOP_DIV;
+
+    while(loc_u32Loops > ZERO)
+    {
+        loc_u32Loops--;
+    }
+}
+
+static u8 recover_bus(I2C_enuChannel_t Copy_enuChannel)
+{
+    const I2C_strConfig_t* loc_pstrConfig = I2C_strChannelState[Copy_enuChannel].Config;
+    GPIO_strPinConfig_t loc_strScl = {ZERO};
+    GPIO_strPinConfig_t loc_strSda = {ZERO};
+    u8 loc_u8Sda = ZERO;
+    u8 loc_u8Pulse = ZERO;
+
+    I2C_strChannelInfo[Copy_enuChannel].I2c->CR1 = ZERO;
+
+    /* Both lines released as open drain GPIOs */
+    loc_strScl.port = loc_pstrConfig->SclPort;
+    loc_strScl.pin = loc_pstrConfig->SclPin;
+    loc_strScl.mode = OUTPUT_PIN;
+    loc_strScl.modeCfg.outputCfg.type = OUTPUT_OPEN_DRAIN;
+    loc_strScl.modeCfg.outputCfg.speed = OUTPUT_MEDIUM_SPEED;
+    loc_strScl.modeCfg.outputCfg.pull = FLOATING;
+
+    loc_strSda = loc_strScl;
+    loc_strSda.port = loc_pstrConfig->SdaPort;
+    loc_strSda.pin = loc_pstrConfig->SdaPin;
+
+    GPIO_enuSetPin(loc_strScl.port, loc_strScl.pin, GPIO_PIN_HIGH);
+    GPIO_enuSetPin(loc_strSda.port, loc_strSda.pin, GPIO_PIN_HIGH);
+    GPIO_enuInitPin(&loc_strScl);
+    GPIO_enuInitPin(&loc_strSda);
+    bus_delay();
+
+    /* The slave shifts out the rest of its byte and releases SDA on a high bit or the NACK clock */
+    GPIO_enuGetPin(loc_strSda.port, loc_strSda.pin, &loc_u8Sda);
+    for(loc_u8Pulse = ZERO; (loc_u8Pulse < RECOVERY_PULSES) && (GPIO_PIN_LOW == loc_u8Sda); loc_u8Pulse++)
+    {
+        GPIO_enuSetPin(loc_strScl.port, loc_strScl.pin, GPIO_PIN_LOW);
+        bus_delay();
+        GPIO_enuSetPin(loc_strScl.port, loc_strScl.pin, GPIO_PIN_HIGH);
+        bus_delay();
+        GPIO_enuGetPin(loc_strSda.port, loc_strSda.pin, &loc_u8Sda);
+    }
+
+    /* Stop condition: SDA rises while SCL is high */
+    GPIO_enuSetPin(loc_strScl.port, loc_strScl.pin, GPIO_PIN_LOW);
+    bus_delay();
+    GPIO_enuSetPin(loc_strSda.port, loc_strSda.pin, GPIO_PIN_LOW);
+    bus_delay();
+    GPIO_enuSetPin(loc_strScl.port, loc_strScl.pin, GPIO_PIN_HIGH);
+    bus_delay();
+    GPIO_enuSetPin(loc_strSda.port, loc_strSda.pin, GPIO_PIN_HIGH);
+    bus_delay();
+    GPIO_enuGetPin(loc_strSda.port, loc_strSda.pin, &loc_u8Sda);
+
+    /* Back to the peripheral (the open drain output type is kept) */
+    loc_strScl.mode = AF_PIN;
+    loc_strScl.modeCfg.afCfg.index = loc_pstrConfig->SclAf;
+    loc_strSda.mode = AF_PIN;
+    loc_strSda.modeCfg.afCfg.index = loc_pstrConfig->SdaAf;
+    GPIO_enuInitPin(&loc_strScl);
+    GPIO_enuInitPin(&loc_strSda);
+
+    /* The busy flag of a stuck bus is only cleared by a software reset */
+    apply_timing(Copy_enuChannel);
+
+    return (u8)((GPIO_PIN_HIGH == loc_u8Sda) && !(I2C_strChannelInfo[Copy_enuChannel].I2c->SR2 & SR2_BUSY_MASK));
+}
+
+static STD_enuErrorStatus_t start_transaction(I2C_enuChannel_t Copy_enuChannel)
+{
+    STD_enuErrorStatus_t loc_enuErrorStatus = STD_enuOk;
+    volatile I2C_t* loc_pstrI2c = I2C_strChannelInfo[Copy_enuChannel].I2c;
+    I2C_strChannelState_t* loc_pstrState = &I2C_strChannelState[Copy_enuChannel];
+    u32 loc_u32Timeout = STOP_TIMEOUT;
+
+    /* The stop condition of the previous transaction goes out first */
+    while((loc_pstrI2c->CR1 & CR1_STOP_MASK) && (loc_u32Timeout > ZERO))
+    {
+        loc_u32Timeout--;
+    }
+
+    if(loc_pstrState->Retime)
+    {
+        apply_timing(Copy_enuChannel);
+    }
+    else
+    {
+        /* Do Nothing */
+    }
+
+    if(loc_pstrI2c->SR2 & SR2_BUSY_MASK)
+    {
+        loc_enuErrorStatus = STD_enuOperationFailed;
+    }
+    else
+    {
+        loc_pstrState->Head->State = I2C_enuRunning;
+        loc_pstrState->Phase = (ZERO != loc_pstrState->Head->TxLength) ? PHASE_WRITE : PHASE_READ;
+        loc_pstrState->Index = ZERO;
+
+        loc_pstrI2c->CR1 |= CR1_START_MASK;
+    }
+
+    return loc_enuErrorStatus;
+}
+
+static void run_queue(I2C_enuChannel_t Copy_enuChannel)
+{
+    I2C_strChannelState_t* loc_pstrState = &I2C_strChannelState[Copy_enuChannel];
+    I2C_strTransaction_t* loc_pstrFailed = NULL;
+
+    while((NULL != loc_pstrState->Head) && (STD_enuOk != start_transaction(Copy_enuChannel)))
+    {
+        loc_pstrFailed = loc_pstrState->Head;
+        loc_pstrState->Head = loc_pstrFailed->Next;
+        loc_pstrFailed->State = I2C_enuFailed;
+
+        if(NULL == loc_pstrState->Head)
+        {
+            loc_pstrState->Tail = NULL;
+        }
+        else
+        {
+            /* Do Nothing */
+        }
+
+        if(NULL != loc_pstrFailed->Callback)
+        {
+            loc_pstrFailed->Callback(Copy_enuChannel, loc_pstrFailed);
+        }
+        else
+        {
+            /* Do Nothing */
+        }
+    }
+}
+
+static void end_transaction(I2C_enuChannel_t Copy_enuChannel, I2C_enuState_t Copy_enuState)
+{
+    volatile I2C_t* loc_pstrI2c = I2C_strChannelInfo[Copy_enuChannel].I2c;
+    I2C_strChannelState_t* loc_pstrState = &I2C_strChannelState[Copy_enuChannel];
+    I2C_strTransaction_t* loc_pstrTransaction = loc_pstrState->Head;
+
+    loc_pstrI2c->CR2 &= ~(CR2_ITBUFEN_MASK | CR2_DMAEN_MASK | CR2_LAST_MASK);
+    loc_pstrI2c->CR1 &= ~CR1_ACK_MASK;
+    DMA_enuStop(I2C_strChannelInfo[Copy_enuChannel].RxStream);
+
+    /* The next transaction starts before the callback, which may queue this one again */
+    loc_pstrState->Head = loc_pstrTransaction->Next;
+    loc_pstrTransaction->State = Copy_enuState;
+
+    if(NULL == loc_pstrState->Head)
+    {
+        loc_pstrState->Tail = NULL;
+    }
+    else
+    {
+        run_queue(Copy_enuChannel);
+    }
+
+    if(NULL != loc_pstrTransaction->Callback)
+    {
+        loc_pstrTransaction->Callback(Copy_enuChannel, loc_pstrTransaction);
+    }
+    else
+    {
+        /* Do Nothing */
+    }
+}
+
+static void ev_irq(I2C_enuChannel_t Copy_enuChannel)
+{
+    volatile I2C_t* loc_pstrI2c = I2C_strChannelInfo[Copy_enuChannel].I2c;
+    I2C_strChannelState_t* loc_pstrState = &I2C_strChannelState[Copy_enuChannel];
+    I2C_strTransaction_t* loc_pstrTransaction = loc_pstrState->Head;
+    u32 loc_u32Sr1 = loc_pstrI2c->SR1;
+    volatile u32 loc_u32Dummy = ZERO;
+    u32 loc_u32Primask = ZERO;
+
+    if((NULL == loc_pstrTransaction) || (I2C_enuRunning != loc_pstrTransaction->State))
+    {
+        /* Nothing on the bus: the event is dropped (ADDR cleared by SR1 then SR2) */
+        loc_u32Dummy = loc_pstrI2c->SR2;
+        loc_pstrI2c->CR2 &= ~CR2_ITBUFEN_MASK;
+    }
+    else if(loc_u32Sr1 & SR1_SB_MASK)
+    {
+        if(PHASE_WRITE == loc_pstrState->Phase)
+        {
+            loc_pstrI2c->DR = (u32)loc_pstrTransaction->Address << 1;
+        }
+        else if(loc_pstrTransaction->RxLength > 1)
+        {
+            /* DMA reception, the hardware NACKs the last byte */
+            DMA_enuStart(I2C_strChannelInfo[Copy_enuChannel].RxStream, (u32)&loc_pstrI2c->DR,
+                         (u32)loc_pstrTransaction->RxData, loc_pstrTransaction->RxLength);
+            loc_pstrI2c->CR2 |= CR2_DMAEN_MASK | CR2_LAST_MASK;
+            loc_pstrI2c->CR1 |= CR1_ACK_MASK;
+            loc_pstrI2c->DR = ((u32)loc_pstrTransaction->Address << 1) | READ_BIT;
+        }
+        else
+        {
+            /* A single byte is NACKed: ACK cleared before ADDR is */
+            loc_pstrI2c->CR1 &= ~CR1_ACK_MASK;
+            loc_pstrI2c->DR = ((u32)loc_pstrTransaction->Address << 1) | READ_BIT;
+        }
+    }
+    else if(loc_u32Sr1 & SR1_ADDR_MASK)
+    {
+        if((PHASE_READ == loc_pstrState->Phase) && (1 == loc_pstrTransaction->RxLength))
+        {
+            /* The stop goes out after the byte being received: ADDR cleared and STOP set back to back
+               (a preemption in between would let a second byte be clocked) */
+            ENTER_CRITICAL(loc_u32Primask);
+            loc_u32Dummy = loc_pstrI2c->SR2;
+            loc_pstrI2c->CR1 |= CR1_STOP_MASK;
+            EXIT_CRITICAL(loc_u32Primask);
+
+            loc_pstrI2c->CR2 |= CR2_ITBUFEN_MASK;
+        }
+        else
+        {
+            loc_u32Dummy = loc_pstrI2c->SR2;
+
+            if(PHASE_WRITE == loc_pstrState->Phase)
+            {
+                loc_pstrI2c->CR2 |= CR2_ITBUFEN_MASK;
+            }
+            else
+            {
+                /* Do Nothing */
+            }
+        }
+    }
+    else if(PHASE_WRITE == loc_pstrState->Phase)
+    {
+        if((loc_u32Sr1 & SR1_TXE_MASK) && (loc_pstrState->Index < loc_pstrTransaction->TxLength))
+        {
+            loc_pstrI2c->DR = loc_pstrTransaction->TxData[loc_pstrState->Index];
+            loc_pstrState->Index++;
+
+            if(loc_pstrState->Index == loc_pstrTransaction->TxLength)
+            {
+                /* The end of the last byte is the byte transfer finished event */
+                loc_pstrI2c->CR2 &= ~CR2_ITBUFEN_MASK;
+            }
+            else
+            {
+                /* Do Nothing */
+            }
+        }
+        else if(loc_u32Sr1 & SR1_BTF_MASK)
+        {
+            if(ZERO != loc_pstrTransaction->RxLength)
+            {
+                /* Repeated start for the read part */
+                loc_pstrState->Phase = PHASE_READ;
+                loc_pstrI2c->CR1 |= CR1_START_MASK;
+            }
+            else
+            {
+                loc_pstrI2c->CR1 |= CR1_STOP_MASK;
+                end_transaction(Copy_enuChannel, I2C_enuDone);
+            }
+        }
+        else
+        {
+            /* Do Nothing */
+        }
+    }
+    else if((1 == loc_pstrTransaction->RxLength) && (loc_u32Sr1 & SR1_RXNE_MASK))
+    {
+        loc_pstrTransaction->RxData[0] = (u8)loc_pstrI2c->DR;
+        end_transaction(Copy_enuChannel, I2C_enuDone);
+    }
+    else
+    {
+        /* Do Nothing */
+    }
+
+    (void)loc_u32Dummy;
+}
+
+static void er_irq(I2C_enuChannel_t Copy_enuChannel)
+{
+    volatile I2C_t* loc_pstrI2c = I2C_strChannelInfo[Copy_enuChannel].I2c;
+    I2C_strChannelState_t* loc_pstrState = &I2C_strChannelState[Copy_enuChannel];
+    u32 loc_u32Sr1 = loc_pstrI2c->SR1;
+
+    /* Error flags are cleared by writing 0 */
+    loc_pstrI2c->SR1 = ~(loc_u32Sr1 & SR1_ERRORS_MASK);
+
+    /* An arbitration loss already released the bus */
+    if(ZERO == (loc_u32Sr1 & SR1_ARLO_MASK))
+    {
+        loc_pstrI2c->CR1 |= CR1_STOP_MASK;
+    }
+    else
+    {
+        /* Do Nothing */
+    }
+
+    if((NULL == loc_pstrState->Head) || (I2C_enuRunning != loc_pstrState->Head->State))
+    {
+        /* Do Nothing */
+    }
+    else if(ZERO != (loc_u32Sr1 & (SR1_BERR_MASK | SR1_ARLO_MASK | SR1_OVR_MASK | SR1_TIMEOUT_MASK)))
+    {
+        end_transaction(Copy_enuChannel, I2C_enuFailed);
+    }
+    else if(loc_u32Sr1 & SR1_AF_MASK)
+    {
+        end_transaction(Copy_enuChannel, I2C_enuNack);
+    }
+    else
+    {
+        /* Do Nothing */
+    }
+}
+
+static void dma_event(DMA_enuStream_t Copy_enuStream, u8 Copy_u8Events)
+{
+    u8 loc_u8Channel = ZERO;
+
+    for(loc_u8Channel = ZERO; loc_u8Channel < I2C_CHANNELS; loc_u8Channel++)
+    {
+        if((NULL == I2C_strChannelState[loc_u8Channel].Config) || (NULL == I2C_strChannelState[loc_u8Channel].Head)
+        || (Copy_enuStream != I2C_strChannelInfo[loc_u8Channel].RxStream))
+        {
+            /* Do Nothing */
+        }
+        else
+        {
+            /* All the bytes read (the last one NACKed): release the bus */
+            I2C_strChannelInfo[loc_u8Channel].I2c->CR1 |= CR1_STOP_MASK;
+            end_transaction((I2C_enuChannel_t)loc_u8Channel, (Copy_u8Events & DMA_EVENT_ERROR) ? I2C_enuFailed : I2C_enuDone);
+        }
+    }
+}
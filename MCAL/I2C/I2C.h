@@ -0,0 +1,121 @@
+/*
+ * @file  : I2C.h
+ * @brief : user interface for the I2C peripherals (interrupt driven master, DMA reads, transaction queue)
+ * @author: Alaa Hisham
+ * @date  : 31-03-2024
+ */
+
+#ifndef I2C_H_
+#define I2C_H_
+
+/*===========================================================================================================*/
+/*												    Includes	 										     */
+/*===========================================================================================================*/
+#include "STD_TYPES.h"
+
+/*===========================================================================================================*/
+/*												     Macros		 										     */
+/*===========================================================================================================*/
+/**
+ * Bus speed options
+ */
+#define I2C_SPEED_STANDARD		100000UL
+#define I2C_SPEED_FAST			400000UL
+
+#define I2C_CHANNELS			3
+
+/*===========================================================================================================*/
+/*												     Types		 										     */
+/*===========================================================================================================*/
+typedef enum
+{
+	I2C_enuI2c1	,	/* DMA1 stream 0 channel 1 (RX) */
+	I2C_enuI2c2	,	/* DMA1 stream 2 channel 7 (RX) */
+	I2C_enuI2c3		/* DMA1 stream 1 channel 1 (RX) */
+}I2C_enuChannel_t;
+
+typedef enum
+{
+	I2C_enuIdle		,	/* Never queued */
+	I2C_enuQueued	,	/* Waiting for the previous transactions */
+	I2C_enuRunning	,	/* On the bus */
+	I2C_enuDone		,	/* Completed: the read data can be used */
+	I2C_enuNack		,	/* The slave did not acknowledge its address or a written byte */
+	I2C_enuFailed		/* Bus error / arbitration lost / bus stuck low */
+}I2C_enuState_t;
+
+struct I2C_strTransaction;
+
+/* Transaction callback: called from interrupt context once the transaction buffers can be reused */
+typedef void (*I2C_CBF_t)(I2C_enuChannel_t Copy_enuChannel, struct I2C_strTransaction* Add_pstrTransaction);
+
+/**
+ * Transaction (statically allocated by the sender): TxLength bytes are written, then
+ * RxLength bytes are read after a repeated start (e.g. a register address then its value)
+ * The transaction and its buffers must stay untouched until it completes.
+ */
+typedef struct I2C_strTransaction
+{
+	u8 Address;									/* 7 bits slave address */
+	const u8* TxData;
+	u16 TxLength;								/* 0: read only */
+	u8* RxData;
+	u16 RxLength;								/* 0: write only, 2 bytes and more are read by DMA */
+	I2C_CBF_t Callback;							/* Can be NULL */
+	volatile I2C_enuState_t State;				/* Managed by I2C */
+	struct I2C_strTransaction* Next;			/* Managed by I2C */
+}I2C_strTransaction_t;
+
+/*===========================================================================================================*/
+/*											 Function Prototypes											 */
+/*===========================================================================================================*/
+
+/**
+ * @brief Initializes the channels configured in I2C_cfg.c as masters, reserves their reception
+ *        DMA stream and recovers a bus left stuck by a slave
+ *
+ * The bus timing follows PCLK1 (it is recomputed after every system clock change).
+ * The SCL/SDA pins are set by the application to open drain then to their alternate function
+ * (the same pins are given in I2C_cfg.c for the bus recovery). The I2Cx_EV_IRQn, I2Cx_ER_IRQn
+ * and the reception DMA stream interrupt of the used channels must be enabled in NVIC_cfg.c
+ * (a channel's interrupts at the same priority).
+ *
+ * @return STD_enuErrorStatus_t : STD_enuOk 			 : Successful Operation
+ * 								  STD_enuInvalidConfig	 : Invalid channel configuration / PCLK1 out of range (channel left disabled)
+ * 								  STD_enuOperationFailed : A peripheral clock or a DMA stream could not be reserved
+ */
+STD_enuErrorStatus_t I2C_Init(void);
+
+/**
+ * @brief Queues a transaction, it runs after the transactions already queued on the channel
+ *        (the call does not wait)
+ *
+ * A bus found busy when a transaction is submitted to an idle channel from thread context is
+ * recovered first (the transaction fails if it stays stuck). A transaction started from interrupt
+ * context (after the previous one) fails on a busy bus: submitting it again from thread context
+ * recovers the bus.
+ *
+ * @param[in] Copy_enuChannel		: the channel (I2C_enuI2c1 ... I2C_enuI2c3)
+ * @param[in] Add_pstrTransaction	: the transaction
+ *
+ * @return STD_enuErrorStatus_t : STD_enuOk 		  : Successful Operation
+ * 								  STD_enuNullPtr	  : Add_pstrTransaction or a buffer with a length is a NULL pointer
+ * 								  STD_enuInvalidValue : Invalid channel / address / no data
+ * 								  STD_enuInvalidState : The channel is not initialized / the transaction is still pending
+ */
+STD_enuErrorStatus_t I2C_enuSubmit(I2C_enuChannel_t Copy_enuChannel, I2C_strTransaction_t* Add_pstrTransaction);
+
+/**
+ * @brief Frees a bus held low by a slave: up to 9 SCL pulses then a stop condition, and resets
+ *        the peripheral
+ *
+ * @param[in] Copy_enuChannel	: the channel
+ *
+ * @return STD_enuErrorStatus_t : STD_enuOk 			 : Successful Operation (the bus is free)
+ * 								  STD_enuInvalidValue	 : Invalid channel
+ * 								  STD_enuInvalidState	 : The channel is not initialized / transactions are queued
+ * 								  STD_enuOperationFailed : SDA is still held low
+ */
+STD_enuErrorStatus_t I2C_enuRecoverBus(I2C_enuChannel_t Copy_enuChannel);
+
+#endif /* I2C_H_ */
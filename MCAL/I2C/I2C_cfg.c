@@ -0,0 +1,32 @@
+/*
+ * @file  : I2C_cfg.c
+ * @brief : I2C post-compile configurations (channels table)
+ * @author: Alaa Hisham
+ * @date  : 31-03-2024
+ */
+/*===========================================================================================================*/
+/*												    Includes		 										 */
+/*===========================================================================================================*/
+#include "STD_TYPES.h"
+
+#include "GPIO.h"
+#include "I2C.h"
+#include "I2C_cfg.h"
+
+/*===========================================================================================================*/
+/*								 	 		  Channels Configuration										 */
+/*===========================================================================================================*/
+const I2C_strConfig_t I2C_strConfigArr[NUMBER_OF_CFG_I2CS] =
+{
+	/* Sensors bus (PB8 SCL / PB9 SDA) */
+	{
+		.Channel = I2C_enuI2c1		,
+		.Speed   = I2C_SPEED_FAST	,
+		.SclPort = GPIOB			,
+		.SclPin  = GPIO_enuPin8		,
+		.SdaPort = GPIOB			,
+		.SdaPin  = GPIO_enuPin9		,
+		.SclAf   = AF4				,
+		.SdaAf   = AF4
+	}
+};
@@ -0,0 +1,55 @@
+/*
+ * @file  : I2C_cfg.h
+ * @brief : pre-compile configurations for the I2C peripherals
+ * @author: Alaa Hisham
+ * @date  : 31-03-2024
+ */
+
+#ifndef I2C_CFG_H_
+#define I2C_CFG_H_
+
+/*===========================================================================================================*/
+/*												    Includes	 										     */
+/*===========================================================================================================*/
+#include "STD_TYPES.h"
+#include "I2C.h"
+
+/*===========================================================================================================*/
+/*												     Macros		 										     */
+/*===========================================================================================================*/
+/**
+ * @brief The number of channels configured in I2C_cfg.c
+ */
+#define NUMBER_OF_CFG_I2CS			1
+
+/*===========================================================================================================*/
+/*												     Types		 										     */
+/*===========================================================================================================*/
+typedef struct
+{
+	/**
+	 * The I2C peripheral
+	 * Options: I2C_enuI2c1, I2C_enuI2c2, I2C_enuI2c3
+	 */
+	I2C_enuChannel_t Channel;
+
+	/**
+	 * The SCL frequency
+	 * Options: I2C_SPEED_STANDARD (PCLK1 [2 - 50] MHz), I2C_SPEED_FAST (PCLK1 [4 - 50] MHz)
+	 */
+	u32 Speed;
+
+	/**
+	 * The bus pins, driven as GPIOs during the bus recovery
+	 * Range: ports GPIOA ... GPIOH, pins GPIO_enuPin0 ... GPIO_enuPin15
+	 * SclAf/SdaAf: the alternate function of the pins (AF4, AF9 for I2C2/I2C3 SDA on PB3/PB4)
+	 */
+	void* SclPort;
+	u8 SclPin;
+	void* SdaPort;
+	u8 SdaPin;
+	u8 SclAf;
+	u8 SdaAf;
+}I2C_strConfig_t;
+
+#endif /* I2C_CFG_H_ */
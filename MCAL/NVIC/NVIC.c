@@ -12,11 +12,13 @@
 #include "BIT_MATH.h"
 
 #include "NVIC.h"
+#include "NVIC_cfg.h"
 
 /*===========================================================================================================*/
 /*												     Macros		 										     */
 /*===========================================================================================================*/
 #define SCB_AIRCR           *((volatile u32*)0xE000ED0C)
+#define SCB_SHPR            ((volatile u32*)0xE000ED18)     /* System Handler Priority Registers 1..3 */
 #define NVIC                ((void*)0xE000E100)
 
 #define VECT_KEY            0x05FA0000
@@ -33,6 +35,11 @@
 #define IRQ_PER_PRI_REG     4
 #define MIN_PRI_VAL         15
 
+#define IPR_USED_REGS       ((TOTAL_IRQs + IRQ_PER_PRI_REG - 1) / IRQ_PER_PRI_REG)
+#define ISER_USED_REGS      ((TOTAL_IRQs + REG_SIZE - 1) / REG_SIZE)
+#define SHPR_REGS           3
+#define SHPR_IRQ_OFFSET     12  /* SHPR byte index = IRQn + 12 (MemoryManagement_IRQn -> byte 0) */
+
 /*===========================================================================================================*/
 /*												     Types		 										     */
 /*===========================================================================================================*/
@@ -53,9 +60,89 @@ typedef struct
     volatile u32 STIR;         /* Software Trigger Interrupt Register */
 } NVIC_t;
 
+/*===========================================================================================================*/
+/*										  	   Global Variables											     */
+/*===========================================================================================================*/
+extern const NVIC_strIrqConfig_t NVIC_strIrqConfigArr[NUMBER_OF_CFG_IRQS];
+
 /*===========================================================================================================*/
 /*										  	  API Implementations											 */
 /*===========================================================================================================*/
+/**
+ * @brief Applies the priority grouping and the interrupt table configured in NVIC_cfg.c
+ *
+ * The register images are built first then every IPR/SHPR/ISER/ICER word is written once,
+ * so interrupts that are not in the table are left at the reset priority (0) and state.
+ * Entry values are validated at compile time by the NVIC_CFG_* wrappers.
+ *
+ * @return STD_enuErrorStatus_t : STD_enuOk 			 : Successful Operation
+ * 								  STD_enuInvalidConfig	 : Invalid priority grouping option
+ */
+STD_enuErrorStatus_t NVIC_Init(void)
+{
+    STD_enuErrorStatus_t loc_enuErrorStatus = STD_enuOk;
+    u32 loc_u32IPR[IPR_USED_REGS]   = {ZERO};
+    u32 loc_u32SHPR[SHPR_REGS]      = {ZERO};
+    u32 loc_u32ISER[ISER_USED_REGS] = {ZERO};
+    u32 loc_u32ICER[ISER_USED_REGS] = {ZERO};
+    u32 loc_u32Priority = ZERO;
+    s32 loc_s32IRQn = ZERO;
+    u8 loc_u8Iterator = ZERO;
+
+    if(STD_enuOk != NVIC_ConfigPriorityBits(NVIC_CFG_PRIORITY_GROUPING))
+    {
+        loc_enuErrorStatus = STD_enuInvalidConfig;
+    }
+    else
+    {
+        for(loc_u8Iterator = ZERO; loc_u8Iterator < NUMBER_OF_CFG_IRQS; loc_u8Iterator++)
+        {
+            loc_s32IRQn = NVIC_strIrqConfigArr[loc_u8Iterator].IRQn;
+            loc_u32Priority = ((NVIC_strIrqConfigArr[loc_u8Iterator].GroupPriority << NVIC_SUB_PRI_BITS)
+                             | NVIC_strIrqConfigArr[loc_u8Iterator].SubPriority) << PRIORITY_BITS;
+
+            if(loc_s32IRQn < ZERO)
+            {
+                /* System exception: priority lives in the SCB, enabling is up to its peripheral */
+                loc_s32IRQn += SHPR_IRQ_OFFSET;
+                loc_u32SHPR[loc_s32IRQn/IRQ_PER_PRI_REG] |= loc_u32Priority << ((loc_s32IRQn%IRQ_PER_PRI_REG)*8);
+            }
+            else
+            {
+                loc_u32IPR[loc_s32IRQn/IRQ_PER_PRI_REG] |= loc_u32Priority << ((loc_s32IRQn%IRQ_PER_PRI_REG)*8);
+
+                if(NVIC_enuIrqEnabled == NVIC_strIrqConfigArr[loc_u8Iterator].State)
+                {
+                    loc_u32ISER[loc_s32IRQn/REG_SIZE] |= (1UL << (loc_s32IRQn%REG_SIZE));
+                }
+                else
+                {
+                    loc_u32ICER[loc_s32IRQn/REG_SIZE] |= (1UL << (loc_s32IRQn%REG_SIZE));
+                }
+            }
+        }
+
+        /* Priorities are written before any interrupt gets enabled */
+        for(loc_u8Iterator = ZERO; loc_u8Iterator < SHPR_REGS; loc_u8Iterator++)
+        {
+            SCB_SHPR[loc_u8Iterator] = loc_u32SHPR[loc_u8Iterator];
+        }
+
+        for(loc_u8Iterator = ZERO; loc_u8Iterator < IPR_USED_REGS; loc_u8Iterator++)
+        {
+            ((NVIC_t*)NVIC)->IPR[loc_u8Iterator] = loc_u32IPR[loc_u8Iterator];
+        }
+
+        for(loc_u8Iterator = ZERO; loc_u8Iterator < ISER_USED_REGS; loc_u8Iterator++)
+        {
+            ((NVIC_t*)NVIC)->ICER[loc_u8Iterator] = loc_u32ICER[loc_u8Iterator];
+            ((NVIC_t*)NVIC)->ISER[loc_u8Iterator] = loc_u32ISER[loc_u8Iterator];
+        }
+    }
+
+    return loc_enuErrorStatus;
+}
+
 /**
  * @brief Function to enable the given Interrupt Request
  *
@@ -233,7 +320,7 @@ STD_enuErrorStatus_t NVIC_SetPriority(NVIC_IRQn_t Copy_enuIRQn, u8 Copy_u8Priori
 
     if(Copy_enuIRQn < TOTAL_IRQs && Copy_u8Priority <= MIN_PRI_VAL)
     {
-        ((NVIC_t*)NVIC)->IPR[loc_u8PriRegIndex] &= (PRIORITY_MASK << (loc_u8PriByteOffset*8));
+        ((NVIC_t*)NVIC)->IPR[loc_u8PriRegIndex] &= ~(PRIORITY_MASK << (loc_u8PriByteOffset*8));
         ((NVIC_t*)NVIC)->IPR[loc_u8PriRegIndex] |= (Copy_u8Priority << (loc_u8PriByteOffset*8 + PRIORITY_BITS));
     }
     else
@@ -111,6 +111,15 @@ typedef enum
 /*											 Function Prototypes											 */
 /*===========================================================================================================*/
 
+/**
+ * @brief Applies the priority grouping and the interrupt table configured in NVIC_cfg.c
+ *        (should be called once at startup, before the other modules are initialized)
+ *
+ * @return STD_enuErrorStatus_t : STD_enuOk 			 : Successful Operation
+ * 								  STD_enuInvalidConfig	 : Invalid priority grouping option
+ */
+STD_enuErrorStatus_t NVIC_Init(void);
+
 /**
  * @brief Function to enable the given Interrupt Request
  *
@@ -0,0 +1,101 @@
+/*
+ * @file  : NVIC_cfg.c
+ * @brief : NVIC post-compile configurations (interrupt priority table)
+ * @author: Alaa Hisham
+ * @date  : 12-03-2024
+ */
+/*===========================================================================================================*/
+/*												    Includes		 										 */
+/*===========================================================================================================*/
+#include "STD_TYPES.h"
+
+#include "NVIC.h"
+#include "NVIC_cfg.h"
+
+/*===========================================================================================================*/
+/*								 Interrupt Priorities & Initial States										 */
+/*===========================================================================================================*/
+const NVIC_strIrqConfig_t NVIC_strIrqConfigArr[NUMBER_OF_CFG_IRQS] =
+{
+	{
+		.IRQn          = NVIC_CFG_IRQ(SysTick_IRQn)	,
+		.GroupPriority = NVIC_CFG_GROUP_PRI(1)		,
+		.SubPriority   = NVIC_CFG_SUB_PRI(0)		,
+		.State         = NVIC_enuIrqEnabled
+	},
+	{
+		.IRQn          = NVIC_CFG_IRQ(RCC_IRQn)		,
+		.GroupPriority = NVIC_CFG_GROUP_PRI(0)		,
+		.SubPriority   = NVIC_CFG_SUB_PRI(0)		,
+		.State         = NVIC_enuIrqEnabled
+	},
+	/* USART1 (telemetry) and USART2 (console): each USART with its DMA streams at the same priority */
+	{
+		.IRQn          = NVIC_CFG_IRQ(USART1_IRQn)	,
+		.GroupPriority = NVIC_CFG_GROUP_PRI(2)		,
+		.SubPriority   = NVIC_CFG_SUB_PRI(1)		,
+		.State         = NVIC_enuIrqEnabled
+	},
+	{
+		.IRQn          = NVIC_CFG_IRQ(DMA2_Stream2_IRQn)	,
+		.GroupPriority = NVIC_CFG_GROUP_PRI(2)				,
+		.SubPriority   = NVIC_CFG_SUB_PRI(1)				,
+		.State         = NVIC_enuIrqEnabled
+	},
+	{
+		.IRQn          = NVIC_CFG_IRQ(DMA2_Stream7_IRQn)	,
+		.GroupPriority = NVIC_CFG_GROUP_PRI(2)				,
+		.SubPriority   = NVIC_CFG_SUB_PRI(1)				,
+		.State         = NVIC_enuIrqEnabled
+	},
+	{
+		.IRQn          = NVIC_CFG_IRQ(USART2_IRQn)	,
+		.GroupPriority = NVIC_CFG_GROUP_PRI(2)		,
+		.SubPriority   = NVIC_CFG_SUB_PRI(1)		,
+		.State         = NVIC_enuIrqEnabled
+	},
+	{
+		.IRQn          = NVIC_CFG_IRQ(DMA1_Stream5_IRQn)	,
+		.GroupPriority = NVIC_CFG_GROUP_PRI(2)				,
+		.SubPriority   = NVIC_CFG_SUB_PRI(1)				,
+		.State         = NVIC_enuIrqEnabled
+	},
+	{
+		.IRQn          = NVIC_CFG_IRQ(DMA1_Stream6_IRQn)	,
+		.GroupPriority = NVIC_CFG_GROUP_PRI(2)				,
+		.SubPriority   = NVIC_CFG_SUB_PRI(1)				,
+		.State         = NVIC_enuIrqEnabled
+	},
+	/* I2C1 (sensors): event, error and reception DMA stream at the same priority */
+	{
+		.IRQn          = NVIC_CFG_IRQ(I2C1_EV_IRQn)	,
+		.GroupPriority = NVIC_CFG_GROUP_PRI(1)		,
+		.SubPriority   = NVIC_CFG_SUB_PRI(1)		,
+		.State         = NVIC_enuIrqEnabled
+	},
+	{
+		.IRQn          = NVIC_CFG_IRQ(I2C1_ER_IRQn)	,
+		.GroupPriority = NVIC_CFG_GROUP_PRI(1)		,
+		.SubPriority   = NVIC_CFG_SUB_PRI(1)		,
+		.State         = NVIC_enuIrqEnabled
+	},
+	{
+		.IRQn          = NVIC_CFG_IRQ(DMA1_Stream0_IRQn)	,
+		.GroupPriority = NVIC_CFG_GROUP_PRI(1)				,
+		.SubPriority   = NVIC_CFG_SUB_PRI(1)				,
+		.State         = NVIC_enuIrqEnabled
+	},
+	/* SPI1 (flash and ADC): reception and transmission DMA streams at the same priority */
+	{
+		.IRQn          = NVIC_CFG_IRQ(DMA2_Stream0_IRQn)	,
+		.GroupPriority = NVIC_CFG_GROUP_PRI(2)				,
+		.SubPriority   = NVIC_CFG_SUB_PRI(0)				,
+		.State         = NVIC_enuIrqEnabled
+	},
+	{
+		.IRQn          = NVIC_CFG_IRQ(DMA2_Stream3_IRQn)	,
+		.GroupPriority = NVIC_CFG_GROUP_PRI(2)				,
+		.SubPriority   = NVIC_CFG_SUB_PRI(0)				,
+		.State         = NVIC_enuIrqEnabled
+	}
+};
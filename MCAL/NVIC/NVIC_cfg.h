@@ -0,0 +1,87 @@
+/*
+ * @file  : NVIC_cfg.h
+ * @brief : pre-compile configurations for the NVIC peripheral
+ * @author: Alaa Hisham
+ * @date  : 12-03-2024
+ */
+
+#ifndef NVIC_CFG_H_
+#define NVIC_CFG_H_
+
+/*===========================================================================================================*/
+/*												    Includes	 										     */
+/*===========================================================================================================*/
+#include "STD_TYPES.h"
+#include "NVIC.h"
+
+/*===========================================================================================================*/
+/*												     Macros		 										     */
+/*===========================================================================================================*/
+/**
+ * @brief The priority grouping applied by NVIC_Init
+ *        Options: FOUR_GROUP_PRI_BITS, THREE_GROUP_PRI_BITS, TWO_GROUP_PRI_BITS,
+ *                 ONE_GROUP_PRI_BITS, ZERO_GROUP_PRI_BITS
+ */
+#define NVIC_CFG_PRIORITY_GROUPING      TWO_GROUP_PRI_BITS
+
+/**
+ * @brief The number of interrupts/exceptions configured in NVIC_cfg.c
+ */
+#define NUMBER_OF_CFG_IRQS              13
+
+/**
+ * Number of group/sub priority bits derived from the grouping option (do not edit)
+ */
+#define NVIC_SUB_PRI_BITS               ((FOUR_GROUP_PRI_BITS == NVIC_CFG_PRIORITY_GROUPING) ? 0 \
+                                        : ((NVIC_CFG_PRIORITY_GROUPING >> 8) - 3))
+#define NVIC_GROUP_PRI_BITS             (4 - NVIC_SUB_PRI_BITS)
+
+/**
+ * Compile-time checks for the configuration table entries (do not edit)
+ * A failing check declares a negative size array and stops the build.
+ */
+#define NVIC_CFG_ASSERT(COND)           ((int)(0 * sizeof(char[(COND) ? 1 : -1])))
+
+#define NVIC_CFG_IRQ(IRQ)               ((NVIC_IRQn_t)((IRQ) + NVIC_CFG_ASSERT(((IRQ) >= MemoryManagement_IRQn) \
+                                                                             && ((IRQ) < TOTAL_IRQs))))
+#define NVIC_CFG_GROUP_PRI(PRI)         ((u8)((PRI) + NVIC_CFG_ASSERT((PRI) < (1 << NVIC_GROUP_PRI_BITS))))
+#define NVIC_CFG_SUB_PRI(PRI)           ((u8)((PRI) + NVIC_CFG_ASSERT((PRI) < (1 << NVIC_SUB_PRI_BITS))))
+
+/*===========================================================================================================*/
+/*												     Types		 										     */
+/*===========================================================================================================*/
+typedef enum
+{
+    NVIC_enuIrqDisabled ,
+    NVIC_enuIrqEnabled
+} NVIC_enuIrqState_t;
+
+typedef struct
+{
+    /**
+     * The interrupt/exception index
+     * Range: MemoryManagement_IRQn ... SPI4_IRQn (wrap with NVIC_CFG_IRQ)
+     */
+    NVIC_IRQn_t IRQn;
+
+    /**
+     * The group (preemption) priority
+     * Range: [0 - (2^NVIC_GROUP_PRI_BITS)-1] (wrap with NVIC_CFG_GROUP_PRI)
+     */
+    u8 GroupPriority;
+
+    /**
+     * The sub priority
+     * Range: [0 - (2^NVIC_SUB_PRI_BITS)-1] (wrap with NVIC_CFG_SUB_PRI)
+     */
+    u8 SubPriority;
+
+    /**
+     * The interrupt state after NVIC_Init
+     * Options: NVIC_enuIrqDisabled, NVIC_enuIrqEnabled
+     * (ignored for system exceptions, they are enabled by their own peripheral)
+     */
+    NVIC_enuIrqState_t State;
+} NVIC_strIrqConfig_t;
+
+#endif /* NVIC_CFG_H_ */
@@ -0,0 +1,126 @@
+/*
+ * @file  : PWR.c
+ * @brief : API Implementations for the PWR peripheral (sleep & stop modes)
+ * @author: Alaa Hisham
+ * @date  : 19-03-2024
+ */
+/*===========================================================================================================*/
+/*												    Includes		 										 */
+/*===========================================================================================================*/
+
+#include "STD_TYPES.h"
+#include "BIT_MATH.h"
+
+#include "RCC.h"
+#include "PWR.h"
+
+/*===========================================================================================================*/
+/*												     Macros		 										     */
+/*===========================================================================================================*/
+#define PWR                 ((volatile PWR_t*)0x40007000)
+#define SCB_SCR             (*((volatile u32*)0xE000ED10))
+
+#define CR_LPDS_MASK        0x00000001  /* Low-power regulator in stop mode */
+#define CR_PDDS_MASK        0x00000002  /* Standby instead of stop on deepsleep */
+#define CR_FPDS_MASK        0x00000200  /* Flash powered down in stop mode */
+#define CR_STOP_MASK        (CR_LPDS_MASK | CR_PDDS_MASK | CR_FPDS_MASK)
+
+#define SCR_SLEEPDEEP_MASK  0x00000004
+
+/*===========================================================================================================*/
+/*												     Types		 										     */
+/*===========================================================================================================*/
+typedef struct
+{
+    volatile u32 CR;        /* Power control register */
+    volatile u32 CSR;       /* Power control/status register */
+} PWR_t;
+
+/*===========================================================================================================*/
+/*										  	  API Implementations											 */
+/*===========================================================================================================*/
+/**
+ * @brief Enables the PWR peripheral clock (needed to program the stop modes)
+ *
+ * @return STD_enuErrorStatus_t : STD_enuOk 			 : Successful Operation
+ * 								  STD_enuOperationFailed : The PWR clock could not be enabled
+ */
+STD_enuErrorStatus_t PWR_Init(void)
+{
+    STD_enuErrorStatus_t loc_enuErrorStatus = STD_enuOk;
+
+    if(STD_enuOk != RCC_enuAcquirePeripheralClk(RCC_APB1_PWR))
+    {
+        loc_enuErrorStatus = STD_enuOperationFailed;
+    }
+    else
+    {
+        /* Do Nothing */
+    }
+
+    return loc_enuErrorStatus;
+}
+
+/**
+ * @brief Enters a low power mode and returns once woken up
+ *
+ * After a stop mode the system runs from HSI: the caller has to restore the clocks
+ * (RCC_enuRestoreAfterStop).
+ *
+ * @param[in] Copy_enuMode      : PWR_enuSleep / PWR_enuStop / PWR_enuStopLowPower
+ * @param[in] Copy_enuEntry     : PWR_enuWFI / PWR_enuWFE
+ *
+ * @return STD_enuErrorStatus_t : STD_enuOk 			 : Successful Operation (woken up)
+ * 								  STD_enuInvalidValue	 : Invalid mode or entry instruction
+ */
+STD_enuErrorStatus_t PWR_enuEnterMode(PWR_enuMode_t Copy_enuMode, PWR_enuEntry_t Copy_enuEntry)
+{
+    STD_enuErrorStatus_t loc_enuErrorStatus = STD_enuOk;
+    u32 loc_u32Temp = ZERO;
+
+    if((Copy_enuMode > PWR_enuStopLowPower) || (Copy_enuEntry > PWR_enuWFE))
+    {
+        loc_enuErrorStatus = STD_enuInvalidValue;
+    }
+    else
+    {
+        if(PWR_enuSleep == Copy_enuMode)
+        {
+            SCB_SCR &= ~SCR_SLEEPDEEP_MASK;
+        }
+        else
+        {
+            /* Stop (never standby): the regulator and flash setting picks the depth */
+            loc_u32Temp = PWR->CR & ~CR_STOP_MASK;
+
+            if(PWR_enuStopLowPower == Copy_enuMode)
+            {
+                loc_u32Temp |= (CR_LPDS_MASK | CR_FPDS_MASK);
+            }
+            else
+            {
+                /* Do Nothing */
+            }
+
+            PWR->CR = loc_u32Temp;
+            SCB_SCR |= SCR_SLEEPDEEP_MASK;
+        }
+
+        if(PWR_enuWFI == Copy_enuEntry)
+        {
+            __asm volatile ("wfi");
+        }
+        else
+        {
+            /* Set then clear the event register so the second WFE really waits */
+            __asm volatile ("sev");
+            __asm volatile ("wfe");
+            __asm volatile ("wfe");
+        }
+
+        /* Back to plain sleep for any other WFI/WFE */
+        SCB_SCR &= ~SCR_SLEEPDEEP_MASK;
+    }
+
+    return loc_enuErrorStatus;
+}
@@ -0,0 +1,58 @@
+/*
+ * @file  : PWR.h
+ * @brief : user interface for the PWR peripheral (sleep & stop modes)
+ * @author: Alaa Hisham
+ * @date  : 19-03-2024
+ */
+
+#ifndef PWR_H_
+#define PWR_H_
+
+/*===========================================================================================================*/
+/*												    Includes	 										     */
+/*===========================================================================================================*/
+#include "STD_TYPES.h"
+
+/*===========================================================================================================*/
+/*												     Types		 										     */
+/*===========================================================================================================*/
+typedef enum
+{
+    PWR_enuSleep        ,   /* Core clock stopped, peripherals running */
+    PWR_enuStop         ,   /* All 1.2V domain clocks stopped, main regulator on */
+    PWR_enuStopLowPower     /* Stop with the low-power regulator and the flash powered down */
+} PWR_enuMode_t;
+
+typedef enum
+{
+    PWR_enuWFI  ,   /* Wake up on any enabled interrupt */
+    PWR_enuWFE      /* Wake up on an event (or a pending interrupt with SEVONPEND) */
+} PWR_enuEntry_t;
+
+/*===========================================================================================================*/
+/*											 Function Prototypes											 */
+/*===========================================================================================================*/
+
+/**
+ * @brief Enables the PWR peripheral clock (needed to program the stop modes)
+ *
+ * @return STD_enuErrorStatus_t : STD_enuOk 			 : Successful Operation
+ * 								  STD_enuOperationFailed : The PWR clock could not be enabled
+ */
+STD_enuErrorStatus_t PWR_Init(void);
+
+/**
+ * @brief Enters a low power mode and returns once woken up
+ *
+ * After a stop mode the system runs from HSI: the caller has to restore the clocks
+ * (RCC_enuRestoreAfterStop).
+ *
+ * @param[in] Copy_enuMode      : PWR_enuSleep / PWR_enuStop / PWR_enuStopLowPower
+ * @param[in] Copy_enuEntry     : PWR_enuWFI / PWR_enuWFE
+ *
+ * @return STD_enuErrorStatus_t : STD_enuOk 			 : Successful Operation (woken up)
+ * 								  STD_enuInvalidValue	 : Invalid mode or entry instruction
+ */
+STD_enuErrorStatus_t PWR_enuEnterMode(PWR_enuMode_t Copy_enuMode, PWR_enuEntry_t Copy_enuEntry);
+
+#endif /* PWR_H_ */
@@ -13,6 +13,8 @@
 
 #include "RCC_private.h"
 #include "RCC.h"
+#include "RCC_cfg.h"
+#include "FLASH.h"
 
 /*===========================================================================================================*/
 /*												     Macros		 										     */
@@ -21,7 +23,103 @@
 /*===========================================================================================================*/
 /*										  	   Global Variables											     */
 /*===========================================================================================================*/
-void (*Add_TimClkUpdate[NUMBER_OF_SYSTEM_TIMERS])(void) = {NULL};
+/* Cached clock tree (reset state: HSI selected, all bus prescalers = 1, PLL not configured) */
+static RCC_strClkTree_t RCC_strClkTree =
+{
+	.SysClkHz	  = HSI_CLK_SPEED_HZ,
+	.HclkHz		  = HSI_CLK_SPEED_HZ,
+	.Pclk1Hz	  = HSI_CLK_SPEED_HZ,
+	.Pclk2Hz	  = HSI_CLK_SPEED_HZ,
+	.Apb1TimClkHz = HSI_CLK_SPEED_HZ,
+	.Apb2TimClkHz = HSI_CLK_SPEED_HZ,
+	.PllClkHz	  = ZERO,
+	.PllQClkHz	  = ZERO
+};
+
+static RCC_enuClkIndex_t RCC_enuSysClkSrc = RCC_HSI_CLK;
+static u8 RCC_u8AhbShift  = ZERO;
+static u8 RCC_u8Apb1Shift = ZERO;
+static u8 RCC_u8Apb2Shift = ZERO;
+
+/* Head of the clock change subscribers list (nodes are owned by the subscribers) */
+static RCC_strClkSubscriber_t* RCC_pstrClkSubscribers = NULL;
+
+/* Set while an operating point switch runs: the intermediate steps are not notified */
+static u8 RCC_u8HoldClkNotify = ZERO;
+
+/* Duration of the last operating point switch (microseconds), summed at every HCLK change
+   from the DWT cycles counted since the previous change (set while a switch is measured) */
+static u32 RCC_u32OpPointSwitchUs = ZERO;
+static u32 RCC_u32SwitchMarkCycles = ZERO;
+static u8 RCC_u8MeasureSwitch = ZERO;
+
+extern const RCC_strOpPoint_t RCC_strOpPointArr[NUMBER_OF_OP_POINTS];
+
+/* CR enable/ready bits of each clock (indexed by RCC_enuClkIndex_t) */
+static const u8 RCC_u8ClkOnBit[NUMBER_OF_SYS_CLKS]  = {CR_HSI_ON, CR_HSE_ON, CR_PLL_ON};
+static const u8 RCC_u8ClkRdyBit[NUMBER_OF_SYS_CLKS] = {CR_HSI_RDY, CR_HSE_RDY, CR_PLL_RDY};
+
+/* Asynchronous clock start bookkeeping (shared with RCC_IRQHandler) */
+static volatile RCC_enuClkStartState_t RCC_enuClkStartState[NUMBER_OF_SYS_CLKS] = {RCC_enuClkReady, RCC_enuClkOff, RCC_enuClkOff};
+static volatile u32 RCC_u32ClkStartPolls[NUMBER_OF_SYS_CLKS] = {ZERO};
+static RCC_ClkStartCBF_t RCC_ClkStartCallback[NUMBER_OF_SYS_CLKS] = {NULL};
+
+/* Peripheral clock reference counts (indexed by bus then enable bit) */
+static u8 RCC_u8PeriphClkRefs[NUMBER_OF_PERIPH_BUSES][BUS_ENR_BITS] = {{ZERO}};
+static const u32 RCC_u32EnrValidMask[NUMBER_OF_PERIPH_BUSES] =
+{
+	AHB1ENR_VALID_MASK, AHB2ENR_VALID_MASK, APB1ENR_VALID_MASK, APB2ENR_VALID_MASK
+};
+
+static const u8 RCC_u8AhbShiftLUT[] = AHB_PRSCLR_SHIFTS;
+static const u8 RCC_u8ApbShiftLUT[] = APB_PRSCLR_SHIFTS;
+
+/*===========================================================================================================*/
+/*										  	   Private Functions											 */
+/*===========================================================================================================*/
+/**
+ * @brief Computes the clock tree resulting from the given SYSCLK and prescaler shifts
+ *        (PLL outputs are taken from the cache, no register reads)
+ */
+static void compute_clock_tree(RCC_strClkTree_t* Add_pstrTree, u32 Copy_u32SysClkHz,
+							   u8 Copy_u8AhbShift, u8 Copy_u8Apb1Shift, u8 Copy_u8Apb2Shift);
+
+/**
+ * @brief Applies the three bus prescalers of an operating point
+ */
+static STD_enuErrorStatus_t apply_bus_prescalers(const RCC_strOpPoint_t* Add_pstrOpPoint);
+
+/**
+ * @brief Validates a bus prescaler option and returns log2 of its division factor
+ */
+static STD_enuErrorStatus_t get_prescaler_shift(RCC_enuBusIndex_t Copy_enuBusClk, u8 Copy_u8Prescaler, u8* Add_pu8Shift);
+
+/**
+ * @brief Adds the core cycles counted since the last mark to the switch duration (converted with
+ *        the HCLK they ran at) and moves the mark, called before every HCLK change of a switch
+ */
+static void measure_switch(void);
+
+/**
+ * @brief Calls every clock change subscriber with the given phase and clock tree
+ */
+static void notify_clk_change(RCC_enuClkChangePhase_t Copy_enuPhase, const RCC_strClkTree_t* Add_pstrTree);
+
+/**
+ * @brief Returns the cached frequency of the given system clock source (0 if unknown)
+ */
+static u32 get_src_clk_hz(RCC_enuClkIndex_t Copy_enuClock);
+
+/**
+ * @brief Returns the address of the clock enable register of the given bus
+ */
+static volatile u32* get_enable_reg(RCC_enuPeriphBus_t Copy_enuBus);
+
+/**
+ * @brief Ends an asynchronous clock start: disables/clears its ready interrupt,
+ *        records the final state and calls the user callback
+ */
+static void complete_clk_start(RCC_enuClkIndex_t Copy_enuClk, RCC_enuClkStartState_t Copy_enuState);
 
 /*===========================================================================================================*/
 /*										  	  API Implementations											 */
@@ -34,14 +132,19 @@ void (*Add_TimClkUpdate[NUMBER_OF_SYSTEM_TIMERS])(void) = {NULL};
  * 			  					  RCC_HSE_CLK
  * 			  					  RCC_PLL_CLK
  *
+ * The flash wait states are raised before switching to a faster clock and
+ * lowered after switching to a slower one.
+ *
  * @return STD_enuErrorStatus_t : STD_enuOk 			 : Successful Operation
  * 								  STD_enuInvalidValue	 : Invalid Clock index
+ * 								  STD_enuInvalidConfig	 : PLL not configured through RCC_enuConfigurePLL
  * 								  STD_enuOperationFailed : Selected clock is not running
  */
 STD_enuErrorStatus_t RCC_enuSelectSysClk(RCC_enuClkIndex_t Copy_enuClock)
 {
 	STD_enuErrorStatus_t Local_enuErrorStatus = STD_enuOk;
 	u8 Loc_u8ClockState = CLK_DISABLED;
+	RCC_strClkTree_t Loc_strNewTree;
 
 	switch(Copy_enuClock)
 	{
@@ -70,23 +173,53 @@ STD_enuErrorStatus_t RCC_enuSelectSysClk(RCC_enuClkIndex_t Copy_enuClock)
 		else
 		{
 			/* Select clock if not already selected */
-			if(Copy_enuClock != (RCC->CR & CR_SWS_READ_MASK)>>CR_SWS_READ_OFFSET)
+			if(Copy_enuClock != (RCC->CFGR & CFGR_SWS_READ_MASK)>>CFGR_SWS_READ_OFFSET)
+			{
+				compute_clock_tree(&Loc_strNewTree, get_src_clk_hz(Copy_enuClock), RCC_u8AhbShift, RCC_u8Apb1Shift, RCC_u8Apb2Shift);
+
+				if(ZERO == Loc_strNewTree.HclkHz)
+				{
+					Local_enuErrorStatus = STD_enuInvalidConfig;
+				}
+				else if(Loc_strNewTree.HclkHz > RCC_strClkTree.HclkHz)
+				{
+					/* Raise the wait states before speeding up */
+					Local_enuErrorStatus = FLASH_enuSetLatencyForHclk(Loc_strNewTree.HclkHz);
+				}
+				else
+				{
+					/* Do Nothing */
+				}
+			}
+			else
 			{
+				Local_enuErrorStatus = STD_enuInvalidState;
+			}
+
+			if(STD_enuOk == Local_enuErrorStatus)
+			{
+				notify_clk_change(RCC_enuClkPreChange, &Loc_strNewTree);
+
 				RCC->CFGR &= (SYS_CLK_SELECT_MASK<<SYS_CLK_REG_OFFSET);
 				RCC->CFGR |= Copy_enuClock;
 
+				/* Wait for the switch before relaxing the flash latency */
+				while(Copy_enuClock != (RCC->CFGR & CFGR_SWS_READ_MASK)>>CFGR_SWS_READ_OFFSET);
+
+				measure_switch();
+				RCC_enuSysClkSrc = Copy_enuClock;
+				RCC_strClkTree = Loc_strNewTree;
+
+				/* Lower the wait states after slowing down (no change if already right) */
+				FLASH_enuSetLatencyForHclk(RCC_strClkTree.HclkHz);
+
 				/* Update Clock Value in Relevant Modules */
-				for(int i=ZERO; i<NUMBER_OF_SYSTEM_TIMERS; i++)
-				{
-					if(NULL != Add_TimClkUpdate[i])
-					{
-						Add_TimClkUpdate[i]();
-					}
-					else
-					{
-						/* Do Nothing */
-					}
-				}
+				notify_clk_change(RCC_enuClkPostChange, &RCC_strClkTree);
+			}
+			else if(STD_enuInvalidState == Local_enuErrorStatus)
+			{
+				/* Already selected */
+				Local_enuErrorStatus = STD_enuOk;
 			}
 			else
 			{
@@ -120,206 +253,151 @@ STD_enuErrorStatus_t RCC_enuSelectSysClk(RCC_enuClkIndex_t Copy_enuClock)
 STD_enuErrorStatus_t RCC_enuConfigBusClk(RCC_enuBusIndex_t Copy_enuBusClk, u8 Copy_u8Prescaler)
 {
 	STD_enuErrorStatus_t Local_enuErrorStatus = STD_enuOk;
+	u8 Loc_u8AhbShift  = RCC_u8AhbShift;
+	u8 Loc_u8Apb1Shift = RCC_u8Apb1Shift;
+	u8 Loc_u8Apb2Shift = RCC_u8Apb2Shift;
+	u32 Loc_u32ClrMask = ZERO;
+	u8 Loc_u8Offset = ZERO;
+	u8 Loc_u8Shift = ZERO;
+	RCC_strClkTree_t Loc_strNewTree;
+
+	Local_enuErrorStatus = get_prescaler_shift(Copy_enuBusClk, Copy_u8Prescaler, &Loc_u8Shift);
 
-	if((Copy_u8Prescaler == ZERO)
-	||((Copy_u8Prescaler >= APB_PRSCLR_MIN)
-	 &&(Copy_u8Prescaler <= AHB_PRSCLR_MAX)))
+	if(STD_enuOk == Local_enuErrorStatus)
 	{
 		switch(Copy_enuBusClk)
 		{
 		case RCC_AHB_CLK:
-			if(Copy_u8Prescaler >= AHB_PRSCLR_MIN)
-			{
-				RCC->CFGR &= CFGR_AHB_PRSCLR_MASK;
-				RCC->CFGR |= (Copy_u8Prescaler << CFGR_AHB_PRSCLR_OFFSET);
-			}
-			else
-			{
-				Local_enuErrorStatus = STD_enuInvalidConfig;
-			}
+			Loc_u8AhbShift = Loc_u8Shift;
+			Loc_u32ClrMask = CFGR_AHB_PRSCLR_MASK;
+			Loc_u8Offset = CFGR_AHB_PRSCLR_OFFSET;
 			break;
 		case RCC_APB1_CLK:
-			if(Copy_u8Prescaler <= APB_PRSCLR_MAX)
-			{
-				RCC->CFGR &= CFGR_APB1_PRSCLR_MASK;
-				RCC->CFGR |= (Copy_u8Prescaler << CFGR_APB1_PRSCLR_OFFSET);
-			}
-			else
-			{
-				Local_enuErrorStatus = STD_enuInvalidConfig;
-			}
+			Loc_u8Apb1Shift = Loc_u8Shift;
+			Loc_u32ClrMask = CFGR_APB1_PRSCLR_MASK;
+			Loc_u8Offset = CFGR_APB1_PRSCLR_OFFSET;
 			break;
-		case RCC_APB2_CLK:
-			if(Copy_u8Prescaler <= APB_PRSCLR_MAX)
-			{
-				RCC->CFGR &= CFGR_APB2_PRSCLR_MASK;
-				RCC->CFGR |= (Copy_u8Prescaler << CFGR_APB2_PRSCLR_OFFSET);
-			}
-			else
-			{
-				Local_enuErrorStatus = STD_enuInvalidConfig;
-			}
+		default:
+			Loc_u8Apb2Shift = Loc_u8Shift;
+			Loc_u32ClrMask = CFGR_APB2_PRSCLR_MASK;
+			Loc_u8Offset = CFGR_APB2_PRSCLR_OFFSET;
 			break;
-		default : Local_enuErrorStatus = STD_enuInvalidValue;
 		}
-
 	}
 	else
 	{
-		Local_enuErrorStatus = STD_enuInvalidConfig;
+		/* Do Nothing */
 	}
 
-	return Local_enuErrorStatus;
-}
-
-/**
- * @brief Function to Enable/Disable a certain clock
- *
- * @param[in] Copy_enuClk		: Index of the clock
- * @param[in] Copy_enuClkState	: the state of the clock
- * 								  Options: RCC_ENABLE
- * 								  		   RCC_DISABLE
- * @return STD_enuErrorStatus_t : STD_enuOk 			 : Successful Operation
- * 								  STD_enuInvalidState	 : Invalid Clock State
- * 								  STD_enuInvalidValue	 : Invalid Clock index
- */
-
-STD_enuErrorStatus_t RCC_enuSetClkState(RCC_enuClkIndex_t Copy_enuClk, u8 Copy_enuClkState)
-{
-	STD_enuErrorStatus_t Local_enuErrorStatus = STD_enuOk;
-
-	if(RCC_ENABLE == Copy_enuClkState)
+	if(STD_enuOk == Local_enuErrorStatus)
 	{
-		switch(Copy_enuClk)
-		{
-		case RCC_HSI_CLK:
-			/* Enable HSI Clock */
-			SET_BIT(RCC->CR, CR_HSI_ON);
-
-			/* Wait until Clock is ready */
-			while(!GET_BIT(RCC->CR, CR_HSI_RDY));
-			break;
-
-		case RCC_HSE_CLK:
-			/* Enable HSE Clock */
-			SET_BIT(RCC->CR, CR_HSE_ON);
-			//RCC->CR = 0x12345678;
-			/* Wait until Clock is ready */
-			while(!GET_BIT(RCC->CR, CR_HSE_RDY));
-			break;
-
-		case RCC_PLL_CLK:
-			/* Enable PLL Clock */
-			SET_BIT(RCC->CR, CR_PLL_ON);
-
-			/* Wait until Clock is ready */
-			while(!GET_BIT(RCC->CR, CR_PLL_RDY));
-			break;
+		compute_clock_tree(&Loc_strNewTree, get_src_clk_hz(RCC_enuSysClkSrc), Loc_u8AhbShift, Loc_u8Apb1Shift, Loc_u8Apb2Shift);
 
-		default:
-			Local_enuErrorStatus = STD_enuInvalidValue;
+		/* Raise the wait states before speeding up HCLK */
+		if(Loc_strNewTree.HclkHz > RCC_strClkTree.HclkHz)
+		{
+			Local_enuErrorStatus = FLASH_enuSetLatencyForHclk(Loc_strNewTree.HclkHz);
+		}
+		else
+		{
+			/* Do Nothing */
 		}
 	}
-	else if(RCC_DISABLE == Copy_enuClkState)
+	else
 	{
-		switch(Copy_enuClk)
-		{
-		case RCC_HSI_CLK:
-			/* Disable HSI Clock */
-			CLR_BIT(RCC->CR, CR_HSI_ON);
-
-			/* Wait until Clock is disabled */
-			while(GET_BIT(RCC->CR, CR_HSI_RDY));
+		/* Do Nothing */
+	}
 
-			break;
-		case RCC_HSE_CLK:
-			/* Disable HSE Clock */
-			CLR_BIT(RCC->CR, CR_HSE_ON);
+	if(STD_enuOk == Local_enuErrorStatus)
+	{
+		notify_clk_change(RCC_enuClkPreChange, &Loc_strNewTree);
 
-			/* Wait until Clock is disabled */
-			while(GET_BIT(RCC->CR, CR_HSE_RDY));
+		RCC->CFGR = (RCC->CFGR & Loc_u32ClrMask) | ((u32)Copy_u8Prescaler << Loc_u8Offset);
 
-			break;
-		case RCC_PLL_CLK:
-			/* Disable PLL Clock */
-			CLR_BIT(RCC->CR, CR_PLL_ON);
+		measure_switch();
+		RCC_u8AhbShift  = Loc_u8AhbShift;
+		RCC_u8Apb1Shift = Loc_u8Apb1Shift;
+		RCC_u8Apb2Shift = Loc_u8Apb2Shift;
+		RCC_strClkTree  = Loc_strNewTree;
 
-			/* Wait until Clock is disabled */
-			while(GET_BIT(RCC->CR, CR_PLL_RDY));
+		/* Lower the wait states after slowing down HCLK (no change if already right) */
+		FLASH_enuSetLatencyForHclk(RCC_strClkTree.HclkHz);
 
-			break;
-		default:
-			Local_enuErrorStatus = STD_enuInvalidValue;
-		}
+		notify_clk_change(RCC_enuClkPostChange, &RCC_strClkTree);
 	}
 	else
 	{
-		Local_enuErrorStatus = STD_enuInvalidState;
+		/* Do Nothing */
 	}
 
-
 	return Local_enuErrorStatus;
 }
 
 /**
- * @brief Function to Enable/Disable clock for the given peripheral
+ * @brief Function to Enable/Disable a certain clock
  *
- * @param[in] Copy_enuPeripheral: Index of the peripheral
- * @param[in] Copy_enuClkState	: the state of the peripheral clock
+ * The wait for the clock to become ready (or stop) is bounded by CLK_READY_TIMEOUT,
+ * a clock that fails to start is switched off again (the system keeps running on HSI).
+ *
+ * @param[in] Copy_enuClk		: Index of the clock
+ * @param[in] Copy_enuClkState	: the state of the clock
  * 								  Options: RCC_ENABLE
  * 								  		   RCC_DISABLE
  * @return STD_enuErrorStatus_t : STD_enuOk 			 : Successful Operation
  * 								  STD_enuInvalidState	 : Invalid Clock State
- * 								  STD_enuInvalidValue : Invalid peripheral index
+ * 								  STD_enuInvalidValue	 : Invalid Clock index
+ * 								  STD_enuOperationFailed : Timed out waiting for the clock
  */
-STD_enuErrorStatus_t RCC_enuSetPeripheralClk(RCC_enuPeripheralIndex_t Copy_enuPeripheral, u8 Copy_enuClkState)
+
+STD_enuErrorStatus_t RCC_enuSetClkState(RCC_enuClkIndex_t Copy_enuClk, u8 Copy_enuClkState)
 {
 	STD_enuErrorStatus_t Local_enuErrorStatus = STD_enuOk;
+	u32 Loc_u32Timeout = CLK_READY_TIMEOUT;
 
-	if(RCC_ENABLE == Copy_enuClkState)
+	if((u32)Copy_enuClk >= NUMBER_OF_SYS_CLKS)
 	{
-		if(Copy_enuPeripheral < AHB2_OFFSET)
-		{
-			SET_BIT(RCC->AHB1ENR, Copy_enuPeripheral);
-		}
-		else if(RCC_AHB2_OTGFS == Copy_enuPeripheral)
-		{
-			SET_BIT(RCC->AHB1ENR, (Copy_enuPeripheral-AHB2_OFFSET));
-		}
-		else if(Copy_enuPeripheral < APB2_OFFSET)
+		Local_enuErrorStatus = STD_enuInvalidValue;
+	}
+	else if(RCC_ENABLE == Copy_enuClkState)
+	{
+		/* Enable the clock */
+		SET_BIT(RCC->CR, RCC_u8ClkOnBit[Copy_enuClk]);
+
+		/* Wait until Clock is ready (bounded: a missing crystal must not hang boot) */
+		while(!GET_BIT(RCC->CR, RCC_u8ClkRdyBit[Copy_enuClk]) && (Loc_u32Timeout > ZERO))
 		{
-			SET_BIT(RCC->AHB1ENR, (Copy_enuPeripheral-APB1_OFFSET));
+			Loc_u32Timeout--;
 		}
-		else if(Copy_enuPeripheral < MAX_PERIPHERAL_INDEX)
+
+		if(!GET_BIT(RCC->CR, RCC_u8ClkRdyBit[Copy_enuClk]))
 		{
-			SET_BIT(RCC->AHB1ENR, (Copy_enuPeripheral-APB2_OFFSET));
+			/* Fall back: stop the failed clock, HSI keeps the system running */
+			CLR_BIT(RCC->CR, RCC_u8ClkOnBit[Copy_enuClk]);
+			Local_enuErrorStatus = STD_enuOperationFailed;
 		}
 		else
 		{
-			Local_enuErrorStatus = STD_enuInvalidValue;
+			RCC_enuClkStartState[Copy_enuClk] = RCC_enuClkReady;
 		}
 	}
 	else if(RCC_DISABLE == Copy_enuClkState)
 	{
-		if(Copy_enuPeripheral < AHB2_OFFSET)
-		{
-			CLR_BIT(RCC->AHB1ENR, Copy_enuPeripheral);
-		}
-		else if(RCC_AHB2_OTGFS == Copy_enuPeripheral)
-		{
-			CLR_BIT(RCC->AHB1ENR, (Copy_enuPeripheral-AHB2_OFFSET));
-		}
-		else if(Copy_enuPeripheral < APB2_OFFSET)
+		/* Disable the clock */
+		CLR_BIT(RCC->CR, RCC_u8ClkOnBit[Copy_enuClk]);
+
+		/* Wait until Clock is disabled (refused by HW while it drives the system clock) */
+		while(GET_BIT(RCC->CR, RCC_u8ClkRdyBit[Copy_enuClk]) && (Loc_u32Timeout > ZERO))
 		{
-			CLR_BIT(RCC->AHB1ENR, (Copy_enuPeripheral-APB1_OFFSET));
+			Loc_u32Timeout--;
 		}
-		else if(Copy_enuPeripheral < MAX_PERIPHERAL_INDEX)
+
+		if(GET_BIT(RCC->CR, RCC_u8ClkRdyBit[Copy_enuClk]))
 		{
-			CLR_BIT(RCC->AHB1ENR, (Copy_enuPeripheral-APB2_OFFSET));
+			Local_enuErrorStatus = STD_enuOperationFailed;
 		}
 		else
 		{
-			Local_enuErrorStatus = STD_enuInvalidValue;
+			RCC_enuClkStartState[Copy_enuClk] = RCC_enuClkOff;
 		}
 	}
 	else
@@ -327,155 +405,1345 @@ STD_enuErrorStatus_t RCC_enuSetPeripheralClk(RCC_enuPeripheralIndex_t Copy_enuPe
 		Local_enuErrorStatus = STD_enuInvalidState;
 	}
 
-
 	return Local_enuErrorStatus;
 }
 
 /**
- * @brief Function to configure the PLL clock
+ * @brief Starts a clock without waiting for it to become ready
  *
- * Caution!
- * 		The PLL clock can only be configured while it's stopped otherwise
- * 		configuration will not take effect
+ * The start completes either through the RCC ready interrupt (RCC_IRQn must be enabled
+ * in NVIC_cfg.c) or through RCC_enuPollClkStart, whichever sees the clock ready first.
+ * If the clock is not ready after Copy_u32TimeoutPolls calls to RCC_enuPollClkStart
+ * it is stopped and reported as failed (the system keeps running on HSI).
+ * The PLL source must be ready before the PLL is started.
  *
- * @param[in] Add_strPLLConfig : pointer to the PLL configuration structure
+ * @param[in] Copy_enuClk			: Index of the clock (RCC_HSI_CLK / RCC_HSE_CLK / RCC_PLL_CLK)
+ * @param[in] Copy_u32TimeoutPolls	: number of RCC_enuPollClkStart calls before giving up
+ * @param[in] Add_Callback			: function called on completion (ready/failed), can be NULL
  *
- * @return STD_enuErrorStatus_t: STD_enuOk 			   : Successful Operation
- * 								 STD_enuNullPtr		   : Add_strPLLConfig is a null pointer
- * 								 STD_enuInvalidConfig  : Invalid PLL configuration
- * 								 STD_enuOperationFailed: configuration failed (PLL already running)
+ * @return STD_enuErrorStatus_t : STD_enuOk 			 : Start in progress (or clock already ready)
+ * 								  STD_enuInvalidValue	 : Invalid Clock index
+ * 								  STD_enuInvalidState	 : Start already in progress / PLL source not ready
  */
-STD_enuErrorStatus_t RCC_enuConfigurePLL(RCC_strPLLConfig_t* Add_strPLLConfig)
+STD_enuErrorStatus_t RCC_enuStartClkAsync(RCC_enuClkIndex_t Copy_enuClk, u32 Copy_u32TimeoutPolls, RCC_ClkStartCBF_t Add_Callback)
 {
 	STD_enuErrorStatus_t Local_enuErrorStatus = STD_enuOk;
+	u8 Loc_u8PllSrc = ZERO;
 
-	if(NULL != Add_strPLLConfig)
+	if((u32)Copy_enuClk >= NUMBER_OF_SYS_CLKS)
 	{
-		if(!GET_BIT(RCC->CR, CR_PLL_RDY))
+		Local_enuErrorStatus = STD_enuInvalidValue;
+	}
+	else if(RCC_enuClkStarting == RCC_enuClkStartState[Copy_enuClk])
+	{
+		Local_enuErrorStatus = STD_enuInvalidState;
+	}
+	else
+	{
+		if(RCC_PLL_CLK == Copy_enuClk)
 		{
-			if((Add_strPLLConfig->Q >= PLL_Q_MIN_VALUE) && (Add_strPLLConfig->Q <= PLL_Q_MAX_VALUE))
-			{
-				RCC->PLLCFGR &= PLL_Q_MASK;
-				RCC->PLLCFGR |= (Add_strPLLConfig->Q << PLL_Q_OFFSET);
-			}
-			else
-			{
-				Local_enuErrorStatus = STD_enuInvalidConfig;
-			}
+			Loc_u8PllSrc = GET_BIT(RCC->PLLCFGR, PLL_CLK_BIT);
 
-			if((Add_strPLLConfig->P >= PLL_P_MIN_VALUE) && (Add_strPLLConfig->P <= PLL_P_MAX_VALUE))
+			if(!GET_BIT(RCC->CR, RCC_u8ClkRdyBit[Loc_u8PllSrc]))
 			{
-				RCC->PLLCFGR &= PLL_P_MASK;
-				RCC->PLLCFGR |= (Add_strPLLConfig->P << PLL_P_OFFSET);
+				Local_enuErrorStatus = STD_enuInvalidState;
 			}
 			else
 			{
-				Local_enuErrorStatus = STD_enuInvalidConfig;
+				/* Do Nothing */
 			}
+		}
+		else
+		{
+			/* Do Nothing */
+		}
 
-			if((Add_strPLLConfig->N >= PLL_N_MIN_VALUE)
-					&& (Add_strPLLConfig->N <= PLL_N_MAX_VALUE)
-					&& (Add_strPLLConfig->N != PLL_N_WRONG_VALUE))
-			{
-				RCC->PLLCFGR &= PLL_N_MASK;
-				RCC->PLLCFGR |= (Add_strPLLConfig->N << PLL_N_OFFSET);
-			}
-			else
-			{
-				Local_enuErrorStatus = STD_enuInvalidConfig;
-			}
+		if(STD_enuOk == Local_enuErrorStatus)
+		{
+			RCC_ClkStartCallback[Copy_enuClk] = Add_Callback;
+			RCC_u32ClkStartPolls[Copy_enuClk] = Copy_u32TimeoutPolls;
 
-			if((Add_strPLLConfig->M >= PLL_M_MIN_VALUE) && (Add_strPLLConfig->M <= PLL_M_MAX_VALUE))
+			if(GET_BIT(RCC->CR, RCC_u8ClkRdyBit[Copy_enuClk]))
 			{
-				RCC->PLLCFGR &= PLL_M_MASK;
-				RCC->PLLCFGR |= (Add_strPLLConfig->M << PLL_M_OFFSET);
+				/* Already running: report it right away */
+				RCC_enuClkStartState[Copy_enuClk] = RCC_enuClkStarting;
+				complete_clk_start(Copy_enuClk, RCC_enuClkReady);
 			}
 			else
 			{
-				Local_enuErrorStatus = STD_enuInvalidConfig;
-			}
+				RCC_enuClkStartState[Copy_enuClk] = RCC_enuClkStarting;
 
-			if((Add_strPLLConfig->PLL_CLK_SRC == RCC_HSI_CLK) || (Add_strPLLConfig->PLL_CLK_SRC == RCC_HSE_CLK))
-			{
-				RCC->PLLCFGR &= PLL_CLK_MASK;
-				RCC->PLLCFGR |= (Add_strPLLConfig->PLL_CLK_SRC << PLL_CLK_OFFSET);
-			}
-			else
-			{
-				Local_enuErrorStatus = STD_enuInvalidConfig;
+				/* Clear any stale ready flag, enable the ready interrupt then the clock */
+				SET_BIT(RCC->CIR, (CIR_RDYC_OFFSET + Copy_enuClk));
+				SET_BIT(RCC->CIR, (CIR_RDYIE_OFFSET + Copy_enuClk));
+				SET_BIT(RCC->CR, RCC_u8ClkOnBit[Copy_enuClk]);
 			}
 		}
 		else
 		{
-			Local_enuErrorStatus = STD_enuOperationFailed;
+			/* Do Nothing */
 		}
 	}
-	else
-	{
-		Local_enuErrorStatus = STD_enuNullPtr;
-	}
 
 	return Local_enuErrorStatus;
 }
 
-f32 RCC_f32GetSysClkSpeed(void) 
-{
-	f32 loc_f32SysClk = ZERO;
-	u8 loc_SpeedSrcPLL = ZERO;
-    u32 loc_u32plln = ZERO;
-	u32 loc_u32pllp = ZERO;
-	u32 loc_u32SrcPLL=ZERO;
-	u32 loc_u32pllm = ZERO;
-    
-    if ((RCC->CFGR & ~(SYS_CLK_SELECT_MASK)) == RCC_PLL_CLK) 
-	{
-		loc_u32SrcPLL = (RCC->PLLCFGR & PLL_CLK_MASK)>>PLL_CLK_OFFSET;
-    	loc_u32pllm = (RCC->PLLCFGR & PLL_M_MASK)>>PLL_M_OFFSET;
-    	loc_u32plln = (RCC->PLLCFGR & PLL_N_MASK)>>PLL_N_OFFSET;
-    	loc_u32pllp = (RCC->PLLCFGR & PLL_P_MASK)>>PLL_P_OFFSET;
-        
-		loc_SpeedSrcPLL = (loc_u32SrcPLL == RCC_HSI_CLK)? HSI_CLK_SPEED_MHZ : HSI_CLK_SPEED_MHZ;
-
-        loc_f32SysClk =  (loc_SpeedSrcPLL*loc_u32plln) / (loc_u32pllm * loc_u32pllp);
-    } 
-	else 
-	{
-        loc_f32SysClk = ((RCC->CFGR & SYS_CLK_SELECT_MASK) == RCC_HSI_CLK) ? HSI_CLK_SPEED_MHZ : HSE_CLK_SPEED_MHZ;
-    }
-    
-    return loc_f32SysClk;
-}
-
-/**
- * @brief Set a function to call whenever the system clock is changed
- * 
- * This function is used to update the peripheral/module of the given index, if needed, with 
- * the new value of the system clock.
- * Should be used with modules that depend on system clock value in their operation.
- * It should be called by the give module's handler 
- * 		  
- * @param[in] Copy_u8Peripheral : Index of the peripheral
- * @param[in] Add_Callback   	: address of the callback function
+/**
+ * @brief Checks (once, without waiting) on a clock started by RCC_enuStartClkAsync
+ *        and counts one poll against its timeout
  *
- * @return STD_enuErrorStatus_t : STD_enuOk 	 : Successful Operation
- * 								  STD_enuNullPtr : Add_Callback is a NULL pointer
+ * @param[in]  Copy_enuClk		: Index of the clock
+ * @param[out] Add_penuState	: address to store the start state (starting/ready/failed)
+ *
+ * @return STD_enuErrorStatus_t : STD_enuOk 			 : Successful Operation
+ * 								  STD_enuNullPtr		 : Add_penuState is a null pointer
+ * 								  STD_enuInvalidValue	 : Invalid Clock index
  */
-STD_enuErrorStatus_t RCC_enuSetCBF(u8 Copy_u8Peripheral, void (*Add_Callback)(void))
+STD_enuErrorStatus_t RCC_enuPollClkStart(RCC_enuClkIndex_t Copy_enuClk, RCC_enuClkStartState_t* Add_penuState)
 {
 	STD_enuErrorStatus_t Local_enuErrorStatus = STD_enuOk;
 
-	if(Copy_u8Peripheral >= NUMBER_OF_SYSTEM_TIMERS)
+	if(NULL == Add_penuState)
 	{
-		Local_enuErrorStatus = STD_enuInvalidValue;
+		Local_enuErrorStatus = STD_enuNullPtr;
 	}
-	else if(NULL != Add_Callback)
+	else if((u32)Copy_enuClk >= NUMBER_OF_SYS_CLKS)
 	{
-		Add_TimClkUpdate[Copy_u8Peripheral] = Add_Callback;
+		Local_enuErrorStatus = STD_enuInvalidValue;
 	}
 	else
 	{
-		Local_enuErrorStatus = STD_enuNullPtr;
-	}
-
-	return Local_enuErrorStatus;	
-}
\ No newline at end of file
+		if(RCC_enuClkStarting == RCC_enuClkStartState[Copy_enuClk])
+		{
+			if(GET_BIT(RCC->CR, RCC_u8ClkRdyBit[Copy_enuClk]))
+			{
+				complete_clk_start(Copy_enuClk, RCC_enuClkReady);
+			}
+			else if(ZERO == RCC_u32ClkStartPolls[Copy_enuClk])
+			{
+				/* Timed out: stop the clock, the system keeps running on HSI */
+				CLR_BIT(RCC->CR, RCC_u8ClkOnBit[Copy_enuClk]);
+				SET_BIT(RCC->CR, CR_HSI_ON);
+				complete_clk_start(Copy_enuClk, RCC_enuClkFailed);
+			}
+			else
+			{
+				RCC_u32ClkStartPolls[Copy_enuClk]--;
+			}
+		}
+		else
+		{
+			/* Do Nothing */
+		}
+
+		*Add_penuState = RCC_enuClkStartState[Copy_enuClk];
+	}
+
+	return Local_enuErrorStatus;
+}
+
+/**
+ * @brief RCC global interrupt: completes the clocks started by RCC_enuStartClkAsync
+ */
+void RCC_IRQHandler(void)
+{
+	u8 Loc_u8Clk = ZERO;
+
+	for(Loc_u8Clk = ZERO; Loc_u8Clk < NUMBER_OF_SYS_CLKS; Loc_u8Clk++)
+	{
+		if(GET_BIT(RCC->CIR, (CIR_RDYF_OFFSET + Loc_u8Clk)))
+		{
+			complete_clk_start((RCC_enuClkIndex_t)Loc_u8Clk, RCC_enuClkReady);
+		}
+		else
+		{
+			/* Do Nothing */
+		}
+	}
+}
+
+/**
+ * @brief Function to Enable/Disable clock for the given peripheral
+ *
+ * @param[in] Copy_enuPeripheral: Index of the peripheral
+ * @param[in] Copy_enuClkState	: the state of the peripheral clock
+ * 								  Options: RCC_ENABLE
+ * 								  		   RCC_DISABLE
+ * @return STD_enuErrorStatus_t : STD_enuOk 			 : Successful Operation
+ * 								  STD_enuInvalidState	 : Invalid Clock State
+ * 								  STD_enuInvalidValue : Invalid peripheral index
+ */
+STD_enuErrorStatus_t RCC_enuSetPeripheralClk(RCC_enuPeripheralIndex_t Copy_enuPeripheral, u8 Copy_enuClkState)
+{
+	STD_enuErrorStatus_t Local_enuErrorStatus = STD_enuOk;
+	volatile u32* Loc_pu32EnableReg = NULL;
+	u32 Loc_u32Mask = ZERO;
+
+	if((u32)Copy_enuPeripheral >= MAX_PERIPHERAL_INDEX)
+	{
+		Local_enuErrorStatus = STD_enuInvalidValue;
+	}
+	else
+	{
+		Loc_pu32EnableReg = get_enable_reg(RCC_PERIPH_BUS(Copy_enuPeripheral));
+		Loc_u32Mask = RCC_PERIPH_MASK(Copy_enuPeripheral);
+
+		if(RCC_ENABLE == Copy_enuClkState)
+		{
+			*Loc_pu32EnableReg |= Loc_u32Mask;
+		}
+		else if(RCC_DISABLE == Copy_enuClkState)
+		{
+			*Loc_pu32EnableReg &= ~Loc_u32Mask;
+		}
+		else
+		{
+			Local_enuErrorStatus = STD_enuInvalidState;
+		}
+	}
+
+	return Local_enuErrorStatus;
+}
+
+/**
+ * @brief Takes a reference on a peripheral clock, the clock is enabled by the first user
+ *
+ * The Acquire/Release APIs keep a reference count per peripheral, they should not be
+ * mixed with RCC_enuSetPeripheralClk for the same peripheral.
+ *
+ * @param[in] Copy_enuPeripheral: Index of the peripheral
+ *
+ * @return STD_enuErrorStatus_t : STD_enuOk 			 : Successful Operation
+ * 								  STD_enuInvalidValue	 : Invalid peripheral index
+ * 								  STD_enuOperationFailed : Reference count overflow
+ */
+STD_enuErrorStatus_t RCC_enuAcquirePeripheralClk(RCC_enuPeripheralIndex_t Copy_enuPeripheral)
+{
+	STD_enuErrorStatus_t Local_enuErrorStatus = STD_enuInvalidValue;
+
+	if((u32)Copy_enuPeripheral < MAX_PERIPHERAL_INDEX)
+	{
+		Local_enuErrorStatus = RCC_enuAcquirePeripheralMask(RCC_PERIPH_BUS(Copy_enuPeripheral),
+															RCC_PERIPH_MASK(Copy_enuPeripheral));
+	}
+	else
+	{
+		/* Do Nothing */
+	}
+
+	return Local_enuErrorStatus;
+}
+
+/**
+ * @brief Drops a reference on a peripheral clock, the clock is gated off by the last user
+ *
+ * @param[in] Copy_enuPeripheral: Index of the peripheral
+ *
+ * @return STD_enuErrorStatus_t : STD_enuOk 			 : Successful Operation
+ * 								  STD_enuInvalidValue	 : Invalid peripheral index
+ * 								  STD_enuInvalidState	 : The peripheral clock has no users
+ */
+STD_enuErrorStatus_t RCC_enuReleasePeripheralClk(RCC_enuPeripheralIndex_t Copy_enuPeripheral)
+{
+	STD_enuErrorStatus_t Local_enuErrorStatus = STD_enuInvalidValue;
+
+	if((u32)Copy_enuPeripheral < MAX_PERIPHERAL_INDEX)
+	{
+		Local_enuErrorStatus = RCC_enuReleasePeripheralMask(RCC_PERIPH_BUS(Copy_enuPeripheral),
+															RCC_PERIPH_MASK(Copy_enuPeripheral));
+	}
+	else
+	{
+		/* Do Nothing */
+	}
+
+	return Local_enuErrorStatus;
+}
+
+/**
+ * @brief Takes a reference on a set of peripheral clocks of the same bus,
+ *        the newly needed clocks are enabled with a single register store
+ *
+ * @param[in] Copy_enuBus		: the peripherals bus (RCC_enuBusAHB1 ... RCC_enuBusAPB2)
+ * @param[in] Copy_u32Mask		: ORed RCC_PERIPH_MASK() values of the peripherals
+ *
+ * @return STD_enuErrorStatus_t : STD_enuOk 			 : Successful Operation
+ * 								  STD_enuInvalidValue	 : Invalid bus / mask has unimplemented bits
+ * 								  STD_enuOperationFailed : Reference count overflow (nothing changed)
+ */
+STD_enuErrorStatus_t RCC_enuAcquirePeripheralMask(RCC_enuPeriphBus_t Copy_enuBus, u32 Copy_u32Mask)
+{
+	STD_enuErrorStatus_t Local_enuErrorStatus = STD_enuOk;
+	u32 Loc_u32NewMask = ZERO;
+	u8 Loc_u8Bit = ZERO;
+
+	if(((u32)Copy_enuBus >= NUMBER_OF_PERIPH_BUSES) || (ZERO != (Copy_u32Mask & ~RCC_u32EnrValidMask[Copy_enuBus])))
+	{
+		Local_enuErrorStatus = STD_enuInvalidValue;
+	}
+	else
+	{
+		for(Loc_u8Bit = ZERO; Loc_u8Bit < BUS_ENR_BITS; Loc_u8Bit++)
+		{
+			if(((Copy_u32Mask >> Loc_u8Bit) & 1UL) && (PERIPH_CLK_REF_MAX == RCC_u8PeriphClkRefs[Copy_enuBus][Loc_u8Bit]))
+			{
+				Local_enuErrorStatus = STD_enuOperationFailed;
+			}
+			else
+			{
+				/* Do Nothing */
+			}
+		}
+
+		if(STD_enuOk == Local_enuErrorStatus)
+		{
+			for(Loc_u8Bit = ZERO; Loc_u8Bit < BUS_ENR_BITS; Loc_u8Bit++)
+			{
+				if(((Copy_u32Mask >> Loc_u8Bit) & 1UL))
+				{
+					if(ZERO == RCC_u8PeriphClkRefs[Copy_enuBus][Loc_u8Bit])
+					{
+						Loc_u32NewMask |= (1UL << Loc_u8Bit);
+					}
+					else
+					{
+						/* Do Nothing */
+					}
+
+					RCC_u8PeriphClkRefs[Copy_enuBus][Loc_u8Bit]++;
+				}
+				else
+				{
+					/* Do Nothing */
+				}
+			}
+
+			/* One store per bus for all the clocks that just got their first user */
+			if(ZERO != Loc_u32NewMask)
+			{
+				*get_enable_reg(Copy_enuBus) |= Loc_u32NewMask;
+			}
+			else
+			{
+				/* Do Nothing */
+			}
+		}
+		else
+		{
+			/* Do Nothing */
+		}
+	}
+
+	return Local_enuErrorStatus;
+}
+
+/**
+ * @brief Drops a reference on a set of peripheral clocks of the same bus,
+ *        the clocks left without users are gated off with a single register store
+ *
+ * @param[in] Copy_enuBus		: the peripherals bus (RCC_enuBusAHB1 ... RCC_enuBusAPB2)
+ * @param[in] Copy_u32Mask		: ORed RCC_PERIPH_MASK() values of the peripherals
+ *
+ * @return STD_enuErrorStatus_t : STD_enuOk 			 : Successful Operation
+ * 								  STD_enuInvalidValue	 : Invalid bus / mask has unimplemented bits
+ * 								  STD_enuInvalidState	 : A peripheral clock has no users (nothing changed)
+ */
+STD_enuErrorStatus_t RCC_enuReleasePeripheralMask(RCC_enuPeriphBus_t Copy_enuBus, u32 Copy_u32Mask)
+{
+	STD_enuErrorStatus_t Local_enuErrorStatus = STD_enuOk;
+	u32 Loc_u32IdleMask = ZERO;
+	u8 Loc_u8Bit = ZERO;
+
+	if(((u32)Copy_enuBus >= NUMBER_OF_PERIPH_BUSES) || (ZERO != (Copy_u32Mask & ~RCC_u32EnrValidMask[Copy_enuBus])))
+	{
+		Local_enuErrorStatus = STD_enuInvalidValue;
+	}
+	else
+	{
+		for(Loc_u8Bit = ZERO; Loc_u8Bit < BUS_ENR_BITS; Loc_u8Bit++)
+		{
+			if(((Copy_u32Mask >> Loc_u8Bit) & 1UL) && (ZERO == RCC_u8PeriphClkRefs[Copy_enuBus][Loc_u8Bit]))
+			{
+				Local_enuErrorStatus = STD_enuInvalidState;
+			}
+			else
+			{
+				/* Do Nothing */
+			}
+		}
+
+		if(STD_enuOk == Local_enuErrorStatus)
+		{
+			for(Loc_u8Bit = ZERO; Loc_u8Bit < BUS_ENR_BITS; Loc_u8Bit++)
+			{
+				if(((Copy_u32Mask >> Loc_u8Bit) & 1UL))
+				{
+					RCC_u8PeriphClkRefs[Copy_enuBus][Loc_u8Bit]--;
+
+					if(ZERO == RCC_u8PeriphClkRefs[Copy_enuBus][Loc_u8Bit])
+					{
+						Loc_u32IdleMask |= (1UL << Loc_u8Bit);
+					}
+					else
+					{
+						/* Do Nothing */
+					}
+				}
+				else
+				{
+					/* Do Nothing */
+				}
+			}
+
+			/* One store per bus for all the clocks that lost their last user */
+			if(ZERO != Loc_u32IdleMask)
+			{
+				*get_enable_reg(Copy_enuBus) &= ~Loc_u32IdleMask;
+			}
+			else
+			{
+				/* Do Nothing */
+			}
+		}
+		else
+		{
+			/* Do Nothing */
+		}
+	}
+
+	return Local_enuErrorStatus;
+}
+
+/**
+ * @brief Function to configure the PLL clock
+ *
+ * Caution!
+ * 		The PLL clock can only be configured while it's stopped otherwise
+ * 		configuration will not take effect
+ *
+ * @param[in] Add_strPLLConfig : pointer to the PLL configuration structure
+ *
+ * @return STD_enuErrorStatus_t: STD_enuOk 			   : Successful Operation
+ * 								 STD_enuNullPtr		   : Add_strPLLConfig is a null pointer
+ * 								 STD_enuInvalidConfig  : Invalid PLL configuration
+ * 								 STD_enuOperationFailed: configuration failed (PLL already running)
+ */
+STD_enuErrorStatus_t RCC_enuConfigurePLL(RCC_strPLLConfig_t* Add_strPLLConfig)
+{
+	STD_enuErrorStatus_t Local_enuErrorStatus = STD_enuOk;
+	u32 loc_u32VcoHz = ZERO;
+
+	if(NULL != Add_strPLLConfig)
+	{
+		if(!GET_BIT(RCC->CR, CR_PLL_RDY))
+		{
+			if((Add_strPLLConfig->Q >= PLL_Q_MIN_VALUE) && (Add_strPLLConfig->Q <= PLL_Q_MAX_VALUE))
+			{
+				RCC->PLLCFGR &= PLL_Q_MASK;
+				RCC->PLLCFGR |= (Add_strPLLConfig->Q << PLL_Q_OFFSET);
+			}
+			else
+			{
+				Local_enuErrorStatus = STD_enuInvalidConfig;
+			}
+
+			if((Add_strPLLConfig->P >= PLL_P_MIN_VALUE) && (Add_strPLLConfig->P <= PLL_P_MAX_VALUE))
+			{
+				RCC->PLLCFGR &= PLL_P_MASK;
+				RCC->PLLCFGR |= (Add_strPLLConfig->P << PLL_P_OFFSET);
+			}
+			else
+			{
+				Local_enuErrorStatus = STD_enuInvalidConfig;
+			}
+
+			if((Add_strPLLConfig->N >= PLL_N_MIN_VALUE)
+					&& (Add_strPLLConfig->N <= PLL_N_MAX_VALUE)
+					&& (Add_strPLLConfig->N != PLL_N_WRONG_VALUE))
+			{
+				RCC->PLLCFGR &= PLL_N_MASK;
+				RCC->PLLCFGR |= (Add_strPLLConfig->N << PLL_N_OFFSET);
+			}
+			else
+			{
+				Local_enuErrorStatus = STD_enuInvalidConfig;
+			}
+
+			if((Add_strPLLConfig->M >= PLL_M_MIN_VALUE) && (Add_strPLLConfig->M <= PLL_M_MAX_VALUE))
+			{
+				RCC->PLLCFGR &= PLL_M_MASK;
+				RCC->PLLCFGR |= (Add_strPLLConfig->M << PLL_M_OFFSET);
+			}
+			else
+			{
+				Local_enuErrorStatus = STD_enuInvalidConfig;
+			}
+
+			if((Add_strPLLConfig->PLL_CLK_SRC == RCC_HSI_CLK) || (Add_strPLLConfig->PLL_CLK_SRC == RCC_HSE_CLK))
+			{
+				RCC->PLLCFGR &= PLL_CLK_MASK;
+				RCC->PLLCFGR |= (Add_strPLLConfig->PLL_CLK_SRC << PLL_CLK_OFFSET);
+			}
+			else
+			{
+				Local_enuErrorStatus = STD_enuInvalidConfig;
+			}
+
+			if(STD_enuOk == Local_enuErrorStatus)
+			{
+				/* Cache the PLL outputs: VCO = src * (N / M), PLLCLK = VCO / P, PLL48CK = VCO / Q */
+				loc_u32VcoHz = ((RCC_HSI_CLK == Add_strPLLConfig->PLL_CLK_SRC) ? HSI_CLK_SPEED_HZ : HSE_CLK_SPEED_HZ)
+							 / Add_strPLLConfig->M * Add_strPLLConfig->N;
+
+				RCC_strClkTree.PllClkHz  = loc_u32VcoHz / PLL_P_TO_DIV(Add_strPLLConfig->P);
+				RCC_strClkTree.PllQClkHz = loc_u32VcoHz / Add_strPLLConfig->Q;
+
+				/* The PLL is stopped so it can't be the system clock: bus clocks are unchanged */
+			}
+			else
+			{
+				/* Do Nothing */
+			}
+		}
+		else
+		{
+			Local_enuErrorStatus = STD_enuOperationFailed;
+		}
+	}
+	else
+	{
+		Local_enuErrorStatus = STD_enuNullPtr;
+	}
+
+	return Local_enuErrorStatus;
+}
+
+/**
+ * @brief Solves the PLL parameters (M, N, P, Q) for the requested system clock
+ *
+ * Searches the legal M/N/P space (VCO input 1-2 MHz, VCO output 192-432 MHz) for the
+ * PLLCLK closest to Copy_u32TargetHz without exceeding RCC_SYSCLK_MAX_HZ.
+ * Ties are broken by an exact 48 MHz PLL48CK (USB OTG FS) then by the higher VCO input.
+ *
+ * @param[in]  Copy_u32TargetHz : the requested system clock in Hz
+ * @param[in]  Copy_enuSource   : the PLL source (RCC_HSI_CLK / RCC_HSE_CLK)
+ * @param[out] Add_strPLLConfig : the solved PLL configuration
+ *
+ * @return STD_enuErrorStatus_t : STD_enuOk 			 : Successful Operation
+ * 								  STD_enuNullPtr		 : Add_strPLLConfig is a null pointer
+ * 								  STD_enuInvalidValue	 : Invalid source or target frequency
+ * 								  STD_enuInvalidConfig	 : No legal PLL configuration found
+ */
+STD_enuErrorStatus_t RCC_enuSolvePLL(u32 Copy_u32TargetHz, RCC_enuClkIndex_t Copy_enuSource, RCC_strPLLConfig_t* Add_strPLLConfig)
+{
+	STD_enuErrorStatus_t Local_enuErrorStatus = STD_enuOk;
+	u32 loc_u32SrcHz = ZERO;
+	u32 loc_u32VcoInHz = ZERO;
+	u32 loc_u32VcoHz = ZERO;
+	u32 loc_u32SysClkHz = ZERO;
+	u32 loc_u32Error = ZERO;
+	u32 loc_u32BestError = ZERO;
+	u32 loc_u32BestVcoInHz = ZERO;
+	u8 loc_u8BestUsbExact = ZERO;
+	u8 loc_u8UsbExact = ZERO;
+	u8 loc_u8Found = ZERO;
+	u32 loc_u32N = ZERO;
+	u8 loc_u8Q = ZERO;
+	u8 loc_u8M = ZERO;
+	u8 loc_u8P = ZERO;
+
+	if(NULL == Add_strPLLConfig)
+	{
+		Local_enuErrorStatus = STD_enuNullPtr;
+	}
+	else if(((RCC_HSI_CLK != Copy_enuSource) && (RCC_HSE_CLK != Copy_enuSource))
+		 || (ZERO == Copy_u32TargetHz) || (Copy_u32TargetHz > RCC_SYSCLK_MAX_HZ))
+	{
+		Local_enuErrorStatus = STD_enuInvalidValue;
+	}
+	else
+	{
+		loc_u32SrcHz = (RCC_HSI_CLK == Copy_enuSource) ? HSI_CLK_SPEED_HZ : HSE_CLK_SPEED_HZ;
+
+		for(loc_u8M = PLL_M_MIN_VALUE; loc_u8M <= PLL_M_MAX_VALUE; loc_u8M++)
+		{
+			loc_u32VcoInHz = loc_u32SrcHz / loc_u8M;
+
+			/* Only exact VCO inputs, so the cached clock tree stays exact */
+			if((ZERO != (loc_u32SrcHz % loc_u8M))
+			|| (loc_u32VcoInHz < RCC_PLL_VCO_IN_MIN_HZ) || (loc_u32VcoInHz > RCC_PLL_VCO_IN_MAX_HZ))
+			{
+				continue;
+			}
+
+			for(loc_u8P = ZERO; loc_u8P < PLL_P_OPTIONS; loc_u8P++)
+			{
+				/* Closest N, clamped to the legal N and VCO ranges */
+				loc_u32N = (Copy_u32TargetHz * PLL_P_TO_DIV(loc_u8P) + (loc_u32VcoInHz / 2)) / loc_u32VcoInHz;
+
+				if(loc_u32N < RCC_PLL_N_SOLVER_MIN)
+				{
+					loc_u32N = RCC_PLL_N_SOLVER_MIN;
+				}
+				if(loc_u32N > RCC_PLL_N_SOLVER_MAX)
+				{
+					loc_u32N = RCC_PLL_N_SOLVER_MAX;
+				}
+				if(loc_u32N * loc_u32VcoInHz < RCC_PLL_VCO_MIN_HZ)
+				{
+					loc_u32N = (RCC_PLL_VCO_MIN_HZ + loc_u32VcoInHz - 1) / loc_u32VcoInHz;
+				}
+				if(loc_u32N * loc_u32VcoInHz > RCC_PLL_VCO_MAX_HZ)
+				{
+					loc_u32N = RCC_PLL_VCO_MAX_HZ / loc_u32VcoInHz;
+				}
+
+				loc_u32VcoHz = loc_u32N * loc_u32VcoInHz;
+				loc_u32SysClkHz = loc_u32VcoHz / PLL_P_TO_DIV(loc_u8P);
+
+				/* Never exceed the device limit, step N down instead */
+				while((loc_u32SysClkHz > RCC_SYSCLK_MAX_HZ) && (loc_u32VcoHz - loc_u32VcoInHz >= RCC_PLL_VCO_MIN_HZ))
+				{
+					loc_u32N--;
+					loc_u32VcoHz = loc_u32N * loc_u32VcoInHz;
+					loc_u32SysClkHz = loc_u32VcoHz / PLL_P_TO_DIV(loc_u8P);
+				}
+
+				if((loc_u32SysClkHz > RCC_SYSCLK_MAX_HZ)
+				|| (loc_u32N < RCC_PLL_N_SOLVER_MIN) || (loc_u32N > RCC_PLL_N_SOLVER_MAX))
+				{
+					continue;
+				}
+
+				/* Smallest Q keeping PLL48CK at or below 48 MHz */
+				loc_u8Q = (loc_u32VcoHz + RCC_USB_CLK_HZ - 1) / RCC_USB_CLK_HZ;
+				loc_u8Q = (loc_u8Q < PLL_Q_MIN_VALUE) ? PLL_Q_MIN_VALUE : loc_u8Q;
+
+				if(loc_u8Q > PLL_Q_MAX_VALUE)
+				{
+					continue;
+				}
+
+				loc_u8UsbExact = (loc_u32VcoHz == (loc_u8Q * RCC_USB_CLK_HZ));
+				loc_u32Error = (loc_u32SysClkHz > Copy_u32TargetHz) ? (loc_u32SysClkHz - Copy_u32TargetHz)
+																	 : (Copy_u32TargetHz - loc_u32SysClkHz);
+
+				if((!loc_u8Found)
+				|| (loc_u32Error < loc_u32BestError)
+				|| ((loc_u32Error == loc_u32BestError) && (loc_u8UsbExact > loc_u8BestUsbExact))
+				|| ((loc_u32Error == loc_u32BestError) && (loc_u8UsbExact == loc_u8BestUsbExact)
+					&& (loc_u32VcoInHz > loc_u32BestVcoInHz)))
+				{
+					loc_u8Found = 1;
+					loc_u32BestError = loc_u32Error;
+					loc_u8BestUsbExact = loc_u8UsbExact;
+					loc_u32BestVcoInHz = loc_u32VcoInHz;
+
+					Add_strPLLConfig->M = loc_u8M;
+					Add_strPLLConfig->N = loc_u32N;
+					Add_strPLLConfig->P = (RCC_enuPLL_P_t)loc_u8P;
+					Add_strPLLConfig->Q = loc_u8Q;
+					Add_strPLLConfig->PLL_CLK_SRC = Copy_enuSource;
+				}
+				else
+				{
+					/* Do Nothing */
+				}
+			}
+		}
+
+		if(!loc_u8Found)
+		{
+			Local_enuErrorStatus = STD_enuInvalidConfig;
+		}
+		else
+		{
+			/* Do Nothing */
+		}
+	}
+
+	return Local_enuErrorStatus;
+}
+
+/**
+ * @brief Runs the system clock from the PLL at (the closest legal value to) the requested frequency
+ *
+ * Solves the PLL parameters with RCC_enuSolvePLL, starts the source oscillator, moves the
+ * system clock to HSI while the PLL is reconfigured then selects the PLL.
+ * The APB1 prescaler is raised before the switch when the new HCLK would run APB1
+ * above RCC_PCLK1_MAX_HZ (it's never lowered, the other prescalers are not changed).
+ *
+ * @param[in] Copy_u32TargetHz  : the requested system clock in Hz
+ * @param[in] Copy_enuSource    : the PLL source (RCC_HSI_CLK / RCC_HSE_CLK)
+ *
+ * @return STD_enuErrorStatus_t : STD_enuOk 			 : Successful Operation
+ * 								  STD_enuInvalidValue	 : Invalid source or target frequency
+ * 								  STD_enuInvalidConfig	 : No legal PLL configuration found
+ * 								  STD_enuOperationFailed : A clock failed to start/switch
+ */
+STD_enuErrorStatus_t RCC_enuConfigureSysClkHz(u32 Copy_u32TargetHz, RCC_enuClkIndex_t Copy_enuSource)
+{
+	STD_enuErrorStatus_t Local_enuErrorStatus = STD_enuOk;
+	RCC_strPLLConfig_t loc_strPLLConfig;
+	u32 loc_u32HclkHz = ZERO;
+	u8 loc_u8Apb1Shift = ZERO;
+
+	Local_enuErrorStatus = RCC_enuSolvePLL(Copy_u32TargetHz, Copy_enuSource, &loc_strPLLConfig);
+
+	if(STD_enuOk == Local_enuErrorStatus)
+	{
+		Local_enuErrorStatus = RCC_enuSetClkState(Copy_enuSource, RCC_ENABLE);
+	}
+
+	/* APB1 must already be divided enough when HCLK goes up */
+	if(STD_enuOk == Local_enuErrorStatus)
+	{
+		loc_u32HclkHz = ((((RCC_HSI_CLK == Copy_enuSource) ? HSI_CLK_SPEED_HZ : HSE_CLK_SPEED_HZ)
+					  / loc_strPLLConfig.M * loc_strPLLConfig.N) / PLL_P_TO_DIV(loc_strPLLConfig.P)) >> RCC_u8AhbShift;
+
+		for(loc_u8Apb1Shift = RCC_u8Apb1Shift; (loc_u32HclkHz >> loc_u8Apb1Shift) > RCC_PCLK1_MAX_HZ; loc_u8Apb1Shift++)
+		{
+			/* Do Nothing */
+		}
+
+		if(loc_u8Apb1Shift != RCC_u8Apb1Shift)
+		{
+			Local_enuErrorStatus = RCC_enuConfigBusClk(RCC_APB1_CLK, (u8)(APB_PRSCLR_MIN + loc_u8Apb1Shift - 1));
+		}
+		else
+		{
+			/* Do Nothing */
+		}
+	}
+
+	/* The PLL can't be reconfigured while it's running, so leave it for HSI first */
+	if((STD_enuOk == Local_enuErrorStatus) && (RCC_PLL_CLK == RCC_enuSysClkSrc))
+	{
+		Local_enuErrorStatus = RCC_enuSetClkState(RCC_HSI_CLK, RCC_ENABLE);
+
+		if(STD_enuOk == Local_enuErrorStatus)
+		{
+			Local_enuErrorStatus = RCC_enuSelectSysClk(RCC_HSI_CLK);
+		}
+	}
+
+	if(STD_enuOk == Local_enuErrorStatus)
+	{
+		Local_enuErrorStatus = RCC_enuSetClkState(RCC_PLL_CLK, RCC_DISABLE);
+	}
+
+	if(STD_enuOk == Local_enuErrorStatus)
+	{
+		Local_enuErrorStatus = RCC_enuConfigurePLL(&loc_strPLLConfig);
+	}
+
+	if(STD_enuOk == Local_enuErrorStatus)
+	{
+		Local_enuErrorStatus = RCC_enuSetClkState(RCC_PLL_CLK, RCC_ENABLE);
+	}
+
+	if(STD_enuOk == Local_enuErrorStatus)
+	{
+		Local_enuErrorStatus = RCC_enuSelectSysClk(RCC_PLL_CLK);
+	}
+
+	return Local_enuErrorStatus;
+}
+
+/**
+ * @brief Returns the system clock speed in MHz (from the cached clock tree)
+ *
+ * @return f32 : SYSCLK frequency in MHz
+ */
+f32 RCC_f32GetSysClkSpeed(void) 
+{
+	return (f32)RCC_strClkTree.SysClkHz / HZ_PER_MHZ;
+}
+
+/**
+ * @brief Returns the system clock (SYSCLK) frequency in Hz
+ *
+ * @return u32 : SYSCLK frequency in Hz
+ */
+u32 RCC_u32GetSysClkHz(void)
+{
+	return RCC_strClkTree.SysClkHz;
+}
+
+/**
+ * @brief Returns the AHB clock (HCLK) frequency in Hz
+ *
+ * @return u32 : HCLK frequency in Hz
+ */
+u32 RCC_u32GetHclkHz(void)
+{
+	return RCC_strClkTree.HclkHz;
+}
+
+/**
+ * @brief Returns the APB1 peripheral clock (PCLK1) frequency in Hz
+ *
+ * @return u32 : PCLK1 frequency in Hz
+ */
+u32 RCC_u32GetPclk1Hz(void)
+{
+	return RCC_strClkTree.Pclk1Hz;
+}
+
+/**
+ * @brief Returns the APB2 peripheral clock (PCLK2) frequency in Hz
+ *
+ * @return u32 : PCLK2 frequency in Hz
+ */
+u32 RCC_u32GetPclk2Hz(void)
+{
+	return RCC_strClkTree.Pclk2Hz;
+}
+
+/**
+ * @brief Returns the clock frequency of the timers on APB1 (TIM2..TIM5) in Hz
+ *
+ * @return u32 : APB1 timers clock frequency in Hz
+ */
+u32 RCC_u32GetApb1TimClkHz(void)
+{
+	return RCC_strClkTree.Apb1TimClkHz;
+}
+
+/**
+ * @brief Returns the clock frequency of the timers on APB2 (TIM1, TIM9..TIM11) in Hz
+ *
+ * @return u32 : APB2 timers clock frequency in Hz
+ */
+u32 RCC_u32GetApb2TimClkHz(void)
+{
+	return RCC_strClkTree.Apb2TimClkHz;
+}
+
+/**
+ * @brief Copies the whole cached clock tree
+ *
+ * @param[out] Add_pstrClkTree  : address of the structure to copy the clock tree into
+ *
+ * @return STD_enuErrorStatus_t : STD_enuOk 	 : Successful Operation
+ * 								  STD_enuNullPtr : Add_pstrClkTree is a NULL pointer
+ */
+STD_enuErrorStatus_t RCC_enuGetClkTree(RCC_strClkTree_t* Add_pstrClkTree)
+{
+	STD_enuErrorStatus_t Local_enuErrorStatus = STD_enuOk;
+
+	if(NULL != Add_pstrClkTree)
+	{
+		*Add_pstrClkTree = RCC_strClkTree;
+	}
+	else
+	{
+		Local_enuErrorStatus = STD_enuNullPtr;
+	}
+
+	return Local_enuErrorStatus;
+}
+
+/**
+ * @brief Subscribes to system clock changes
+ *
+ * The node is linked into the subscribers list (no copy), so it must stay allocated
+ * (static/global) while subscribed. Subscribers are called in subscription order,
+ * once before the change (RCC_enuClkPreChange) and once after it (RCC_enuClkPostChange),
+ * with the new clock tree in both phases.
+ *
+ * @param[in] Add_pstrSubscriber: address of the subscriber node (with its Callback set)
+ *
+ * @return STD_enuErrorStatus_t : STD_enuOk 		  : Successful Operation
+ * 								  STD_enuNullPtr 	  : Add_pstrSubscriber or its Callback is a NULL pointer
+ * 								  STD_enuInvalidState : The node is already subscribed
+ */
+STD_enuErrorStatus_t RCC_enuSubscribeClkChange(RCC_strClkSubscriber_t* Add_pstrSubscriber)
+{
+	STD_enuErrorStatus_t Local_enuErrorStatus = STD_enuOk;
+	RCC_strClkSubscriber_t** Loc_ppstrLink = &RCC_pstrClkSubscribers;
+
+	if((NULL == Add_pstrSubscriber) || (NULL == Add_pstrSubscriber->Callback))
+	{
+		Local_enuErrorStatus = STD_enuNullPtr;
+	}
+	else
+	{
+		/* Walk to the tail (rejecting a node that is already linked) */
+		while((NULL != *Loc_ppstrLink) && (STD_enuOk == Local_enuErrorStatus))
+		{
+			if(*Loc_ppstrLink == Add_pstrSubscriber)
+			{
+				Local_enuErrorStatus = STD_enuInvalidState;
+			}
+			else
+			{
+				Loc_ppstrLink = &((*Loc_ppstrLink)->Next);
+			}
+		}
+
+		if(STD_enuOk == Local_enuErrorStatus)
+		{
+			Add_pstrSubscriber->Next = NULL;
+			*Loc_ppstrLink = Add_pstrSubscriber;
+		}
+		else
+		{
+			/* Do Nothing */
+		}
+	}
+
+	return Local_enuErrorStatus;
+}
+
+/**
+ * @brief Removes a subscriber added by RCC_enuSubscribeClkChange
+ *
+ * @param[in] Add_pstrSubscriber: address of the subscriber node
+ *
+ * @return STD_enuErrorStatus_t : STD_enuOk 		  : Successful Operation
+ * 								  STD_enuNullPtr 	  : Add_pstrSubscriber is a NULL pointer
+ * 								  STD_enuInvalidState : The node is not subscribed
+ */
+STD_enuErrorStatus_t RCC_enuUnsubscribeClkChange(RCC_strClkSubscriber_t* Add_pstrSubscriber)
+{
+	STD_enuErrorStatus_t Local_enuErrorStatus = STD_enuInvalidState;
+	RCC_strClkSubscriber_t** Loc_ppstrLink = &RCC_pstrClkSubscribers;
+
+	if(NULL == Add_pstrSubscriber)
+	{
+		Local_enuErrorStatus = STD_enuNullPtr;
+	}
+	else
+	{
+		while((NULL != *Loc_ppstrLink) && (STD_enuOk != Local_enuErrorStatus))
+		{
+			if(*Loc_ppstrLink == Add_pstrSubscriber)
+			{
+				*Loc_ppstrLink = Add_pstrSubscriber->Next;
+				Add_pstrSubscriber->Next = NULL;
+				Local_enuErrorStatus = STD_enuOk;
+			}
+			else
+			{
+				Loc_ppstrLink = &((*Loc_ppstrLink)->Next);
+			}
+		}
+	}
+
+	return Local_enuErrorStatus;
+}
+
+/**
+ * @brief Switches the clocks to one of the operating points configured in RCC_cfg.c
+ *
+ * The switch is done in a safe order: the target source is started (and the PLL
+ * configured if needed), then the prescalers are applied before the source switch when
+ * speeding up and after it when slowing down. The flash wait states follow every step.
+ * Subscribers are notified once before the switch and once after it (with the final
+ * clock tree). The PLL is stopped when the target source is not the PLL.
+ *
+ * @param[in] Copy_u8OpPoint	: index of the operating point (RCC_OP_POINT_xxx in RCC_cfg.h)
+ *
+ * @return STD_enuErrorStatus_t : STD_enuOk 			 : Successful Operation
+ * 								  STD_enuInvalidValue	 : Invalid operating point index
+ * 								  STD_enuInvalidConfig	 : Invalid operating point configuration
+ * 								  STD_enuOperationFailed : A clock failed to start/switch
+ */
+STD_enuErrorStatus_t RCC_enuSetOpPoint(u8 Copy_u8OpPoint)
+{
+	STD_enuErrorStatus_t Local_enuErrorStatus = STD_enuOk;
+	const RCC_strOpPoint_t* Loc_pstrOpPoint = NULL;
+	RCC_strPLLConfig_t Loc_strPLLConfig;
+	RCC_strClkTree_t Loc_strNewTree;
+	u8 Loc_u8AhbShift  = ZERO;
+	u8 Loc_u8Apb1Shift = ZERO;
+	u8 Loc_u8Apb2Shift = ZERO;
+	u32 Loc_u32VcoHz = ZERO;
+	u8 Loc_u8PllSetup = ZERO;
+
+	/* Start the cycle counter (kept running once enabled) */
+	SET_BIT(DEMCR, DEMCR_TRCENA_BIT);
+	SET_BIT(DWT_CTRL, DWT_CTRL_CYCCNTENA_BIT);
+	RCC_u32OpPointSwitchUs = ZERO;
+	RCC_u32SwitchMarkCycles = DWT_CYCCNT;
+	RCC_u8MeasureSwitch = 1;
+
+	if(Copy_u8OpPoint >= NUMBER_OF_OP_POINTS)
+	{
+		Local_enuErrorStatus = STD_enuInvalidValue;
+	}
+	else
+	{
+		Loc_pstrOpPoint = &RCC_strOpPointArr[Copy_u8OpPoint];
+
+		if((u32)Loc_pstrOpPoint->SysClk >= NUMBER_OF_SYS_CLKS)
+		{
+			Local_enuErrorStatus = STD_enuInvalidConfig;
+		}
+		else
+		{
+			Local_enuErrorStatus = get_prescaler_shift(RCC_AHB_CLK, Loc_pstrOpPoint->AhbPrescaler, &Loc_u8AhbShift);
+		}
+
+		if(STD_enuOk == Local_enuErrorStatus)
+		{
+			Local_enuErrorStatus = get_prescaler_shift(RCC_APB1_CLK, Loc_pstrOpPoint->Apb1Prescaler, &Loc_u8Apb1Shift);
+		}
+
+		if(STD_enuOk == Local_enuErrorStatus)
+		{
+			Local_enuErrorStatus = get_prescaler_shift(RCC_APB2_CLK, Loc_pstrOpPoint->Apb2Prescaler, &Loc_u8Apb2Shift);
+		}
+	}
+
+	if(STD_enuOk == Local_enuErrorStatus)
+	{
+		if(RCC_PLL_CLK == Loc_pstrOpPoint->SysClk)
+		{
+			Loc_strPLLConfig = Loc_pstrOpPoint->PLLConfig;
+			Loc_u32VcoHz = ((RCC_HSI_CLK == Loc_strPLLConfig.PLL_CLK_SRC) ? HSI_CLK_SPEED_HZ : HSE_CLK_SPEED_HZ)
+						 / Loc_strPLLConfig.M * Loc_strPLLConfig.N;
+
+			/* Keep the PLL if it's already running from the same source with the same outputs */
+			Loc_u8PllSetup = (!GET_BIT(RCC->CR, CR_PLL_RDY)
+						   || ((u32)Loc_strPLLConfig.PLL_CLK_SRC != GET_BIT(RCC->PLLCFGR, PLL_CLK_BIT))
+						   || ((Loc_u32VcoHz / PLL_P_TO_DIV(Loc_strPLLConfig.P)) != RCC_strClkTree.PllClkHz)
+						   || ((Loc_u32VcoHz / Loc_strPLLConfig.Q) != RCC_strClkTree.PllQClkHz));
+
+			/* The final tree uses the new PLL outputs */
+			compute_clock_tree(&Loc_strNewTree, Loc_u32VcoHz / PLL_P_TO_DIV(Loc_strPLLConfig.P),
+							   Loc_u8AhbShift, Loc_u8Apb1Shift, Loc_u8Apb2Shift);
+			Loc_strNewTree.PllClkHz  = Loc_strNewTree.SysClkHz;
+			Loc_strNewTree.PllQClkHz = Loc_u32VcoHz / Loc_strPLLConfig.Q;
+		}
+		else
+		{
+			compute_clock_tree(&Loc_strNewTree, get_src_clk_hz(Loc_pstrOpPoint->SysClk),
+							   Loc_u8AhbShift, Loc_u8Apb1Shift, Loc_u8Apb2Shift);
+		}
+
+		notify_clk_change(RCC_enuClkPreChange, &Loc_strNewTree);
+		RCC_u8HoldClkNotify = 1;
+
+		/* 1. Start the target source (the PLL can only be reconfigured while stopped) */
+		if(ZERO != Loc_u8PllSetup)
+		{
+			Local_enuErrorStatus = RCC_enuSetClkState(Loc_strPLLConfig.PLL_CLK_SRC, RCC_ENABLE);
+
+			if((STD_enuOk == Local_enuErrorStatus) && (RCC_PLL_CLK == RCC_enuSysClkSrc))
+			{
+				Local_enuErrorStatus = RCC_enuSetClkState(RCC_HSI_CLK, RCC_ENABLE);
+
+				if(STD_enuOk == Local_enuErrorStatus)
+				{
+					Local_enuErrorStatus = RCC_enuSelectSysClk(RCC_HSI_CLK);
+				}
+			}
+
+			if(STD_enuOk == Local_enuErrorStatus)
+			{
+				Local_enuErrorStatus = RCC_enuSetClkState(RCC_PLL_CLK, RCC_DISABLE);
+			}
+
+			if(STD_enuOk == Local_enuErrorStatus)
+			{
+				Local_enuErrorStatus = RCC_enuConfigurePLL(&Loc_strPLLConfig);
+			}
+		}
+		else
+		{
+			/* Do Nothing */
+		}
+
+		if(STD_enuOk == Local_enuErrorStatus)
+		{
+			Local_enuErrorStatus = RCC_enuSetClkState(Loc_pstrOpPoint->SysClk, RCC_ENABLE);
+		}
+
+		/* 2. Speeding up: prescalers first so the buses never overshoot, then the source */
+		if(STD_enuOk == Local_enuErrorStatus)
+		{
+			if(Loc_strNewTree.SysClkHz > RCC_strClkTree.SysClkHz)
+			{
+				Local_enuErrorStatus = apply_bus_prescalers(Loc_pstrOpPoint);
+
+				if(STD_enuOk == Local_enuErrorStatus)
+				{
+					Local_enuErrorStatus = RCC_enuSelectSysClk(Loc_pstrOpPoint->SysClk);
+				}
+			}
+			/* Slowing down: source first, then the prescalers */
+			else
+			{
+				Local_enuErrorStatus = RCC_enuSelectSysClk(Loc_pstrOpPoint->SysClk);
+
+				if(STD_enuOk == Local_enuErrorStatus)
+				{
+					Local_enuErrorStatus = apply_bus_prescalers(Loc_pstrOpPoint);
+				}
+			}
+		}
+
+		/* 3. Stop the unused PLL to save power */
+		if((STD_enuOk == Local_enuErrorStatus) && (RCC_PLL_CLK != Loc_pstrOpPoint->SysClk))
+		{
+			Local_enuErrorStatus = RCC_enuSetClkState(RCC_PLL_CLK, RCC_DISABLE);
+		}
+
+		/* 4. Notify with the tree actually reached (also on failure) */
+		RCC_u8HoldClkNotify = ZERO;
+		notify_clk_change(RCC_enuClkPostChange, &RCC_strClkTree);
+	}
+	else
+	{
+		/* Do Nothing */
+	}
+
+	measure_switch();
+	RCC_u8MeasureSwitch = ZERO;
+
+	return Local_enuErrorStatus;
+}
+
+/**
+ * @brief Returns the duration of the last RCC_enuSetOpPoint call
+ *
+ * Measured with the DWT cycle counter: the cycles counted at each HCLK the switch went
+ * through are converted with that HCLK.
+ *
+ * @return u32 : switch duration in microseconds
+ */
+u32 RCC_u32GetOpPointSwitchUs(void)
+{
+	return RCC_u32OpPointSwitchUs;
+}
+
+/**
+ * @brief Restores the system clock that was running before a stop mode
+ *
+ * Waking up from stop runs the system from HSI with HSE and the PLL stopped
+ * (their configuration and the bus prescalers are kept). The clocks that were
+ * ready before the stop are restarted and the previous source is selected again.
+ * Subscribers are only notified if the previous clock tree could not be restored.
+ *
+ * @return STD_enuErrorStatus_t : STD_enuOk 			 : Successful Operation
+ * 								  STD_enuOperationFailed : A clock failed to restart (system left on HSI)
+ */
+STD_enuErrorStatus_t RCC_enuRestoreAfterStop(void)
+{
+	STD_enuErrorStatus_t Local_enuErrorStatus = STD_enuOk;
+	RCC_enuClkIndex_t Loc_enuSysClkSrc = RCC_enuSysClkSrc;
+
+	/* The hardware already switched to HSI: resync the cache without notifying */
+	RCC_enuSysClkSrc = RCC_HSI_CLK;
+	compute_clock_tree(&RCC_strClkTree, HSI_CLK_SPEED_HZ, RCC_u8AhbShift, RCC_u8Apb1Shift, RCC_u8Apb2Shift);
+
+	RCC_u8HoldClkNotify = 1;
+
+	/* HSE first: it may be the PLL source */
+	if(RCC_enuClkReady == RCC_enuClkStartState[RCC_HSE_CLK])
+	{
+		Local_enuErrorStatus = RCC_enuSetClkState(RCC_HSE_CLK, RCC_ENABLE);
+	}
+	else
+	{
+		/* Do Nothing */
+	}
+
+	if((STD_enuOk == Local_enuErrorStatus) && (RCC_enuClkReady == RCC_enuClkStartState[RCC_PLL_CLK]))
+	{
+		Local_enuErrorStatus = RCC_enuSetClkState(RCC_PLL_CLK, RCC_ENABLE);
+	}
+	else
+	{
+		/* Do Nothing */
+	}
+
+	if(STD_enuOk == Local_enuErrorStatus)
+	{
+		Local_enuErrorStatus = RCC_enuSelectSysClk(Loc_enuSysClkSrc);
+	}
+	else
+	{
+		/* Do Nothing */
+	}
+
+	RCC_u8HoldClkNotify = ZERO;
+
+	if(STD_enuOk != Local_enuErrorStatus)
+	{
+		/* Subscribers still run with the old frequencies */
+		notify_clk_change(RCC_enuClkPreChange, &RCC_strClkTree);
+		notify_clk_change(RCC_enuClkPostChange, &RCC_strClkTree);
+		Local_enuErrorStatus = STD_enuOperationFailed;
+	}
+	else
+	{
+		/* Do Nothing */
+	}
+
+	return Local_enuErrorStatus;
+}
+
+/*===========================================================================================================*/
+/*										  	 Private Implementations										 */
+/*===========================================================================================================*/
+static void complete_clk_start(RCC_enuClkIndex_t Copy_enuClk, RCC_enuClkStartState_t Copy_enuState)
+{
+	CLR_BIT(RCC->CIR, (CIR_RDYIE_OFFSET + Copy_enuClk));
+	SET_BIT(RCC->CIR, (CIR_RDYC_OFFSET + Copy_enuClk));
+
+	/* Only the first completion (ISR or poll) reports */
+	if(Copy_enuState != RCC_enuClkStartState[Copy_enuClk])
+	{
+		RCC_enuClkStartState[Copy_enuClk] = Copy_enuState;
+
+		if(NULL != RCC_ClkStartCallback[Copy_enuClk])
+		{
+			RCC_ClkStartCallback[Copy_enuClk](Copy_enuClk, Copy_enuState);
+		}
+		else
+		{
+			/* Do Nothing */
+		}
+	}
+	else
+	{
+		/* Do Nothing */
+	}
+}
+
+static volatile u32* get_enable_reg(RCC_enuPeriphBus_t Copy_enuBus)
+{
+	volatile u32* loc_pu32Reg = NULL;
+
+	switch(Copy_enuBus)
+	{
+	case RCC_enuBusAHB2: loc_pu32Reg = &RCC->AHB2ENR; break;
+	case RCC_enuBusAPB1: loc_pu32Reg = &RCC->APB1ENR; break;
+	case RCC_enuBusAPB2: loc_pu32Reg = &RCC->APB2ENR; break;
+	default			   : loc_pu32Reg = &RCC->AHB1ENR; break;
+	}
+
+	return loc_pu32Reg;
+}
+
+static u32 get_src_clk_hz(RCC_enuClkIndex_t Copy_enuClock)
+{
+	u32 loc_u32ClkHz = ZERO;
+
+	switch(Copy_enuClock)
+	{
+	case RCC_HSE_CLK: loc_u32ClkHz = HSE_CLK_SPEED_HZ; break;
+	case RCC_PLL_CLK: loc_u32ClkHz = RCC_strClkTree.PllClkHz; break;
+	default			: loc_u32ClkHz = HSI_CLK_SPEED_HZ; break;
+	}
+
+	return loc_u32ClkHz;
+}
+
+static void compute_clock_tree(RCC_strClkTree_t* Add_pstrTree, u32 Copy_u32SysClkHz,
+							   u8 Copy_u8AhbShift, u8 Copy_u8Apb1Shift, u8 Copy_u8Apb2Shift)
+{
+	Add_pstrTree->PllClkHz  = RCC_strClkTree.PllClkHz;
+	Add_pstrTree->PllQClkHz = RCC_strClkTree.PllQClkHz;
+
+	Add_pstrTree->SysClkHz = Copy_u32SysClkHz;
+
+	Add_pstrTree->HclkHz  = Add_pstrTree->SysClkHz >> Copy_u8AhbShift;
+	Add_pstrTree->Pclk1Hz = Add_pstrTree->HclkHz >> Copy_u8Apb1Shift;
+	Add_pstrTree->Pclk2Hz = Add_pstrTree->HclkHz >> Copy_u8Apb2Shift;
+
+	/* Timers run at PCLKx when the APBx prescaler is 1, otherwise at 2 x PCLKx */
+	Add_pstrTree->Apb1TimClkHz = (ZERO == Copy_u8Apb1Shift) ? Add_pstrTree->Pclk1Hz : (Add_pstrTree->Pclk1Hz << 1);
+	Add_pstrTree->Apb2TimClkHz = (ZERO == Copy_u8Apb2Shift) ? Add_pstrTree->Pclk2Hz : (Add_pstrTree->Pclk2Hz << 1);
+}
+
+static void measure_switch(void)
+{
+	u32 Loc_u32Cycles = DWT_CYCCNT;
+
+	if(ZERO != RCC_u8MeasureSwitch)
+	{
+		RCC_u32OpPointSwitchUs += (u32)(((unsigned long long)(Loc_u32Cycles - RCC_u32SwitchMarkCycles) * HZ_PER_MHZ)
+									  / RCC_strClkTree.HclkHz);
+		RCC_u32SwitchMarkCycles = Loc_u32Cycles;
+	}
+	else
+	{
+		/* Do Nothing */
+	}
+}
+
+static void notify_clk_change(RCC_enuClkChangePhase_t Copy_enuPhase, const RCC_strClkTree_t* Add_pstrTree)
+{
+	RCC_strClkSubscriber_t* Loc_pstrNode = (ZERO == RCC_u8HoldClkNotify) ? RCC_pstrClkSubscribers : NULL;
+
+	while(NULL != Loc_pstrNode)
+	{
+		Loc_pstrNode->Callback(Copy_enuPhase, Add_pstrTree);
+		Loc_pstrNode = Loc_pstrNode->Next;
+	}
+}
+
+static STD_enuErrorStatus_t get_prescaler_shift(RCC_enuBusIndex_t Copy_enuBusClk, u8 Copy_u8Prescaler, u8* Add_pu8Shift)
+{
+	STD_enuErrorStatus_t Local_enuErrorStatus = STD_enuOk;
+
+	switch(Copy_enuBusClk)
+	{
+	case RCC_AHB_CLK:
+		if(ZERO == Copy_u8Prescaler)
+		{
+			*Add_pu8Shift = ZERO;
+		}
+		else if((Copy_u8Prescaler >= AHB_PRSCLR_MIN) && (Copy_u8Prescaler <= AHB_PRSCLR_MAX))
+		{
+			*Add_pu8Shift = RCC_u8AhbShiftLUT[Copy_u8Prescaler - AHB_PRSCLR_MIN];
+		}
+		else
+		{
+			Local_enuErrorStatus = STD_enuInvalidConfig;
+		}
+		break;
+	case RCC_APB1_CLK:
+	case RCC_APB2_CLK:
+		if(ZERO == Copy_u8Prescaler)
+		{
+			*Add_pu8Shift = ZERO;
+		}
+		else if((Copy_u8Prescaler >= APB_PRSCLR_MIN) && (Copy_u8Prescaler <= APB_PRSCLR_MAX))
+		{
+			*Add_pu8Shift = RCC_u8ApbShiftLUT[Copy_u8Prescaler - APB_PRSCLR_MIN];
+		}
+		else
+		{
+			Local_enuErrorStatus = STD_enuInvalidConfig;
+		}
+		break;
+	default : Local_enuErrorStatus = STD_enuInvalidValue;
+	}
+
+	return Local_enuErrorStatus;
+}
+
+static STD_enuErrorStatus_t apply_bus_prescalers(const RCC_strOpPoint_t* Add_pstrOpPoint)
+{
+	STD_enuErrorStatus_t Local_enuErrorStatus = STD_enuOk;
+
+	/* APB first: APB1 must already be divided when HCLK goes up to 84 MHz */
+	Local_enuErrorStatus = RCC_enuConfigBusClk(RCC_APB1_CLK, Add_pstrOpPoint->Apb1Prescaler);
+
+	if(STD_enuOk == Local_enuErrorStatus)
+	{
+		Local_enuErrorStatus = RCC_enuConfigBusClk(RCC_APB2_CLK, Add_pstrOpPoint->Apb2Prescaler);
+	}
+
+	if(STD_enuOk == Local_enuErrorStatus)
+	{
+		Local_enuErrorStatus = RCC_enuConfigBusClk(RCC_AHB_CLK, Add_pstrOpPoint->AhbPrescaler);
+	}
+
+	return Local_enuErrorStatus;
+}
@@ -12,18 +12,78 @@
 /*												    Includes	 										     */
 /*===========================================================================================================*/
 #include "STD_TYPES.h"
+#include "RCC_cfg.h"
 
 /*===========================================================================================================*/
 /*												     Macros		 										     */
 /*===========================================================================================================*/
-#define NUMBER_OF_SYSTEM_TIMERS			5
+#define RCC_DISABLE 		1
+#define RCC_ENABLE 			2
 
-/* Indices of timers in the system */
-#define SYSTICK_INDEX					0
+/**
+ * @brief The bus (RCC_enuPeriphBus_t) and the enable register bit mask of a peripheral
+ *        (masks of peripherals on the same bus can be ORed for the batch APIs)
+ * Example: RCC_PERIPH_MASK(RCC_AHB1_GPIOA) | RCC_PERIPH_MASK(RCC_AHB1_GPIOB)
+ */
+#define RCC_PERIPH_BUS(PERIPH)	(((PERIPH) >= RCC_APB2_TIM1) ? RCC_enuBusAPB2 :				\
+								 ((PERIPH) >= RCC_APB1_TIM2) ? RCC_enuBusAPB1 :				\
+								 ((PERIPH) == RCC_AHB2_OTGFS) ? RCC_enuBusAHB2 : RCC_enuBusAHB1)
+#define RCC_PERIPH_MASK(PERIPH)	(1UL << (((PERIPH) >= RCC_APB2_TIM1) ? ((PERIPH) - RCC_APB2_TIM1) :	\
+										 ((PERIPH) >= RCC_APB1_TIM2) ? ((PERIPH) - RCC_APB1_TIM2) :	\
+										 ((PERIPH) == RCC_AHB2_OTGFS) ? 7 : (PERIPH)))
 
+/**
+ * Oscillator frequencies (HSE depends on the crystal mounted on the board)
+ */
+#define RCC_HSI_CLK_HZ		16000000UL
+#define RCC_HSE_CLK_HZ		25000000UL
 
-#define RCC_DISABLE 		1
-#define RCC_ENABLE 			2
+/**
+ * STM32F401 clock limits
+ */
+#define RCC_SYSCLK_MAX_HZ	84000000UL
+#define RCC_PCLK1_MAX_HZ	42000000UL
+#define RCC_USB_CLK_HZ		48000000UL
+
+/**
+ * PLL limits used when solving the PLL parameters (VCO input/output and N ranges)
+ */
+#define RCC_PLL_VCO_IN_MIN_HZ	1000000UL
+#define RCC_PLL_VCO_IN_MAX_HZ	2000000UL
+#define RCC_PLL_VCO_MIN_HZ		192000000UL
+#define RCC_PLL_VCO_MAX_HZ		432000000UL
+#define RCC_PLL_N_SOLVER_MIN	192
+#define RCC_PLL_N_SOLVER_MAX	432
+
+/**
+ * @brief Compile-time PLL configuration: expands to an RCC_strPLLConfig_t initializer
+ *        that generates TARGET_HZ from the given source (RCC_HSI_CLK / RCC_HSE_CLK)
+ *
+ * Uses a 1 MHz VCO input and the smallest P keeping the VCO in range, Q is picked for
+ * the closest PLL48CK to 48 MHz. Invalid requests (target above RCC_SYSCLK_MAX_HZ,
+ * source not a whole number of MHz, VCO out of range) stop the build.
+ * Example: const RCC_strPLLConfig_t cfg = RCC_PLL_CONFIG_INIT(RCC_HSE_CLK, 84000000UL);
+ */
+#define RCC_PLL_CONFIG_INIT(SRC, TARGET_HZ)																\
+{																										\
+	.M = (u8)(RCC_PLL_SRC_HZ(SRC) / RCC_PLL_VCO_IN_MIN_HZ												\
+			+ RCC_PLL_ASSERT((0 == (RCC_PLL_SRC_HZ(SRC) % RCC_PLL_VCO_IN_MIN_HZ))						\
+						  && ((TARGET_HZ) <= RCC_SYSCLK_MAX_HZ))),										\
+	.N = (u16)(RCC_PLL_VCO_HZ(TARGET_HZ) / RCC_PLL_VCO_IN_MIN_HZ										\
+			+ RCC_PLL_ASSERT((RCC_PLL_VCO_HZ(TARGET_HZ) >= RCC_PLL_VCO_MIN_HZ)							\
+						  && (RCC_PLL_VCO_HZ(TARGET_HZ) <= RCC_PLL_VCO_MAX_HZ))),						\
+	.P = (RCC_enuPLL_P_t)(RCC_PLL_P_DIV(TARGET_HZ) / 2 - 1),											\
+	.Q = (u8)((RCC_PLL_VCO_HZ(TARGET_HZ) + RCC_USB_CLK_HZ - 1) / RCC_USB_CLK_HZ),						\
+	.PLL_CLK_SRC = (SRC)																				\
+}
+
+/* Helpers of RCC_PLL_CONFIG_INIT (do not use directly) */
+#define RCC_PLL_ASSERT(COND)		((int)(0 * sizeof(char[(COND) ? 1 : -1])))
+#define RCC_PLL_SRC_HZ(SRC)			((RCC_HSE_CLK == (SRC)) ? RCC_HSE_CLK_HZ : RCC_HSI_CLK_HZ)
+#define RCC_PLL_P_DIV(TARGET_HZ)	((((TARGET_HZ) * 2) >= RCC_PLL_VCO_MIN_HZ) ? 2 : 					\
+									 (((TARGET_HZ) * 4) >= RCC_PLL_VCO_MIN_HZ) ? 4 : 					\
+									 (((TARGET_HZ) * 6) >= RCC_PLL_VCO_MIN_HZ) ? 6 : 8)
+#define RCC_PLL_VCO_HZ(TARGET_HZ)	((((TARGET_HZ) * RCC_PLL_P_DIV(TARGET_HZ)) / RCC_PLL_VCO_IN_MIN_HZ) * RCC_PLL_VCO_IN_MIN_HZ)
 
 /**
  * AHB prescaler options
@@ -57,6 +117,17 @@ typedef enum
 	RCC_PLL_CLK
 }RCC_enuClkIndex_t;
 
+typedef enum
+{
+	RCC_enuClkOff		,
+	RCC_enuClkStarting	,
+	RCC_enuClkReady		,
+	RCC_enuClkFailed
+}RCC_enuClkStartState_t;
+
+/* Completion callback of RCC_enuStartClkAsync (called from RCC_IRQHandler or RCC_enuPollClkStart) */
+typedef void (*RCC_ClkStartCBF_t)(RCC_enuClkIndex_t Copy_enuClk, RCC_enuClkStartState_t Copy_enuState);
+
 typedef enum
 {
 	RCC_AHB_CLK ,
@@ -109,6 +180,14 @@ typedef enum
 	RCC_APB2_TIM4
 }RCC_enuPeripheralIndex_t;
 
+typedef enum
+{
+	RCC_enuBusAHB1	,
+	RCC_enuBusAHB2	,
+	RCC_enuBusAPB1	,
+	RCC_enuBusAPB2
+}RCC_enuPeriphBus_t;
+
 typedef struct
 {
 	/**
@@ -142,6 +221,57 @@ typedef struct
 	RCC_enuClkIndex_t PLL_CLK_SRC;
 }RCC_strPLLConfig_t;
 
+typedef struct
+{
+	u32 SysClkHz;		/* System clock (SYSCLK) */
+	u32 HclkHz;			/* AHB clock (HCLK), also the core and SysTick clock */
+	u32 Pclk1Hz;		/* APB1 peripheral clock */
+	u32 Pclk2Hz;		/* APB2 peripheral clock */
+	u32 Apb1TimClkHz;	/* Clock of the timers on APB1 */
+	u32 Apb2TimClkHz;	/* Clock of the timers on APB2 */
+	u32 PllClkHz;		/* Main PLL output (PLLCLK), 0 if the PLL is not configured */
+	u32 PllQClkHz;		/* PLL48CK output for USB OTG FS/SDIO/RNG, 0 if the PLL is not configured */
+}RCC_strClkTree_t;
+
+typedef enum
+{
+	RCC_enuClkPreChange		,	/* About to change: stop/quiesce what depends on the clock */
+	RCC_enuClkPostChange		/* Changed: recompute baud rates, prescalers, reload values */
+}RCC_enuClkChangePhase_t;
+
+/* Clock change callback, receives the new clock tree in both phases */
+typedef void (*RCC_ClkChangeCBF_t)(RCC_enuClkChangePhase_t Copy_enuPhase, const RCC_strClkTree_t* Add_pstrClkTree);
+
+/* Clock change subscriber node (statically allocated by the subscriber) */
+typedef struct RCC_strClkSubscriber
+{
+	RCC_ClkChangeCBF_t Callback;
+	struct RCC_strClkSubscriber* Next;	/* Managed by RCC */
+}RCC_strClkSubscriber_t;
+
+typedef struct
+{
+	/**
+	 * The system clock source
+	 * Options: RCC_HSI_CLK, RCC_HSE_CLK, RCC_PLL_CLK
+	 */
+	RCC_enuClkIndex_t SysClk;
+
+	/**
+	 * The PLL configuration (only used when SysClk is RCC_PLL_CLK)
+	 * Use RCC_PLL_CONFIG_INIT to check it at compile time
+	 */
+	RCC_strPLLConfig_t PLLConfig;
+
+	/**
+	 * The bus prescalers
+	 * Options: AHB prescaler options for AhbPrescaler, APB prescaler options for Apb1/Apb2Prescaler
+	 */
+	u8 AhbPrescaler;
+	u8 Apb1Prescaler;
+	u8 Apb2Prescaler;
+}RCC_strOpPoint_t;
+
 /*===========================================================================================================*/
 /*											 Function Prototypes											 */
 /*===========================================================================================================*/
@@ -154,8 +284,12 @@ typedef struct
  * 			  					  RCC_HSE_CLK
  * 			  					  RCC_PLL_CLK
  *
+ * The flash wait states are raised before switching to a faster clock and
+ * lowered after switching to a slower one.
+ *
  * @return STD_enuErrorStatus_t : STD_enuOk 			 : Successful Operation
  * 								  STD_enuInvalidValue	 : Invalid Clock index
+ * 								  STD_enuInvalidConfig	 : PLL not configured through RCC_enuConfigurePLL
  * 								  STD_enuOperationFailed : Selected clock is not running
  */
 STD_enuErrorStatus_t RCC_enuSelectSysClk(RCC_enuClkIndex_t Copy_enuClock);
@@ -180,16 +314,52 @@ STD_enuErrorStatus_t RCC_enuConfigBusClk(RCC_enuBusIndex_t Copy_enuBusClk, u8 Co
 /**
  * @brief Function to Enable/Disable a certain clock
  *
+ * The wait for the clock to become ready (or stop) is bounded, a clock that fails
+ * to start is switched off again (the system keeps running on HSI).
+ *
  * @param[in] Copy_enuClk		: Index of the clock
  * @param[in] Copy_enuClkState	: the state of the clock
  * 								  Options: RCC_ENABLE
  * 								  		   RCC_DISABLE
- * @return STD_enuErrorStatus_t : RCC_enuOk 			 : Successful Operation
- * 								  RCC_enuInvalidState	 : Invalid Clock State
- * 								  RCC_enuInvalidClock	 : Invalid Clock index
+ * @return STD_enuErrorStatus_t : STD_enuOk 			 : Successful Operation
+ * 								  STD_enuInvalidState	 : Invalid Clock State
+ * 								  STD_enuInvalidValue	 : Invalid Clock index
+ * 								  STD_enuOperationFailed : Timed out waiting for the clock
  */
 STD_enuErrorStatus_t RCC_enuSetClkState(RCC_enuClkIndex_t Copy_enuClk, u8 Copy_enuClkState);
 
+/**
+ * @brief Starts a clock without waiting for it to become ready
+ *
+ * The start completes either through the RCC ready interrupt (RCC_IRQn must be enabled
+ * in NVIC_cfg.c) or through RCC_enuPollClkStart, whichever sees the clock ready first.
+ * If the clock is not ready after Copy_u32TimeoutPolls calls to RCC_enuPollClkStart
+ * it is stopped and reported as failed (the system keeps running on HSI).
+ * The PLL source must be ready before the PLL is started.
+ *
+ * @param[in] Copy_enuClk			: Index of the clock (RCC_HSI_CLK / RCC_HSE_CLK / RCC_PLL_CLK)
+ * @param[in] Copy_u32TimeoutPolls	: number of RCC_enuPollClkStart calls before giving up
+ * @param[in] Add_Callback			: function called on completion (ready/failed), can be NULL
+ *
+ * @return STD_enuErrorStatus_t : STD_enuOk 			 : Start in progress (or clock already ready)
+ * 								  STD_enuInvalidValue	 : Invalid Clock index
+ * 								  STD_enuInvalidState	 : Start already in progress / PLL source not ready
+ */
+STD_enuErrorStatus_t RCC_enuStartClkAsync(RCC_enuClkIndex_t Copy_enuClk, u32 Copy_u32TimeoutPolls, RCC_ClkStartCBF_t Add_Callback);
+
+/**
+ * @brief Checks (once, without waiting) on a clock started by RCC_enuStartClkAsync
+ *        and counts one poll against its timeout
+ *
+ * @param[in]  Copy_enuClk		: Index of the clock
+ * @param[out] Add_penuState	: address to store the start state (starting/ready/failed)
+ *
+ * @return STD_enuErrorStatus_t : STD_enuOk 			 : Successful Operation
+ * 								  STD_enuNullPtr		 : Add_penuState is a null pointer
+ * 								  STD_enuInvalidValue	 : Invalid Clock index
+ */
+STD_enuErrorStatus_t RCC_enuPollClkStart(RCC_enuClkIndex_t Copy_enuClk, RCC_enuClkStartState_t* Add_penuState);
+
 /**
  * @brief Function to Enable/Disable clock for the given peripheral
  *
@@ -197,12 +367,63 @@ STD_enuErrorStatus_t RCC_enuSetClkState(RCC_enuClkIndex_t Copy_enuClk, u8 Copy_e
  * @param[in] Copy_enuClkState	: the state of the peripheral clock
  * 								  Options: RCC_ENABLE
  * 								  		   RCC_DISABLE
- * @return STD_enuErrorStatus_t : RCC_enuOk 			 : Successful Operation
- * 								  RCC_enuInvalidState	 : Invalid Clock State
- * 								  RCC_enuInvalidPeriphal : Invalid peripheral index
+ * @return STD_enuErrorStatus_t : STD_enuOk 			 : Successful Operation
+ * 								  STD_enuInvalidState	 : Invalid Clock State
+ * 								  STD_enuInvalidValue	 : Invalid peripheral index
  */
 STD_enuErrorStatus_t RCC_enuSetPeripheralClk(RCC_enuPeripheralIndex_t Copy_enuPeripheral, u8 Copy_enuClkState);
 
+/**
+ * @brief Takes a reference on a peripheral clock, the clock is enabled by the first user
+ *
+ * The Acquire/Release APIs keep a reference count per peripheral, they should not be
+ * mixed with RCC_enuSetPeripheralClk for the same peripheral.
+ *
+ * @param[in] Copy_enuPeripheral: Index of the peripheral
+ *
+ * @return STD_enuErrorStatus_t : STD_enuOk 			 : Successful Operation
+ * 								  STD_enuInvalidValue	 : Invalid peripheral index
+ * 								  STD_enuOperationFailed : Reference count overflow
+ */
+STD_enuErrorStatus_t RCC_enuAcquirePeripheralClk(RCC_enuPeripheralIndex_t Copy_enuPeripheral);
+
+/**
+ * @brief Drops a reference on a peripheral clock, the clock is gated off by the last user
+ *
+ * @param[in] Copy_enuPeripheral: Index of the peripheral
+ *
+ * @return STD_enuErrorStatus_t : STD_enuOk 			 : Successful Operation
+ * 								  STD_enuInvalidValue	 : Invalid peripheral index
+ * 								  STD_enuInvalidState	 : The peripheral clock has no users
+ */
+STD_enuErrorStatus_t RCC_enuReleasePeripheralClk(RCC_enuPeripheralIndex_t Copy_enuPeripheral);
+
+/**
+ * @brief Takes a reference on a set of peripheral clocks of the same bus,
+ *        the newly needed clocks are enabled with a single register store
+ *
+ * @param[in] Copy_enuBus		: the peripherals bus (RCC_enuBusAHB1 ... RCC_enuBusAPB2)
+ * @param[in] Copy_u32Mask		: ORed RCC_PERIPH_MASK() values of the peripherals
+ *
+ * @return STD_enuErrorStatus_t : STD_enuOk 			 : Successful Operation
+ * 								  STD_enuInvalidValue	 : Invalid bus / mask has unimplemented bits
+ * 								  STD_enuOperationFailed : Reference count overflow (nothing changed)
+ */
+STD_enuErrorStatus_t RCC_enuAcquirePeripheralMask(RCC_enuPeriphBus_t Copy_enuBus, u32 Copy_u32Mask);
+
+/**
+ * @brief Drops a reference on a set of peripheral clocks of the same bus,
+ *        the clocks left without users are gated off with a single register store
+ *
+ * @param[in] Copy_enuBus		: the peripherals bus (RCC_enuBusAHB1 ... RCC_enuBusAPB2)
+ * @param[in] Copy_u32Mask		: ORed RCC_PERIPH_MASK() values of the peripherals
+ *
+ * @return STD_enuErrorStatus_t : STD_enuOk 			 : Successful Operation
+ * 								  STD_enuInvalidValue	 : Invalid bus / mask has unimplemented bits
+ * 								  STD_enuInvalidState	 : A peripheral clock has no users (nothing changed)
+ */
+STD_enuErrorStatus_t RCC_enuReleasePeripheralMask(RCC_enuPeriphBus_t Copy_enuBus, u32 Copy_u32Mask);
+
 /**
  * @brief Function to configure the PLL clock
  *
@@ -219,22 +440,171 @@ STD_enuErrorStatus_t RCC_enuSetPeripheralClk(RCC_enuPeripheralIndex_t Copy_enuPe
  */
 STD_enuErrorStatus_t RCC_enuConfigurePLL(RCC_strPLLConfig_t* Add_strPLLConfig);
 
+/**
+ * @brief Solves the PLL parameters (M, N, P, Q) for the requested system clock
+ *
+ * Searches the legal M/N/P space (VCO input 1-2 MHz, VCO output 192-432 MHz) for the
+ * PLLCLK closest to Copy_u32TargetHz without exceeding RCC_SYSCLK_MAX_HZ.
+ * Ties are broken by an exact 48 MHz PLL48CK (USB OTG FS) then by the higher VCO input.
+ *
+ * @param[in]  Copy_u32TargetHz : the requested system clock in Hz
+ * @param[in]  Copy_enuSource   : the PLL source (RCC_HSI_CLK / RCC_HSE_CLK)
+ * @param[out] Add_strPLLConfig : the solved PLL configuration
+ *
+ * @return STD_enuErrorStatus_t : STD_enuOk 			 : Successful Operation
+ * 								  STD_enuNullPtr		 : Add_strPLLConfig is a null pointer
+ * 								  STD_enuInvalidValue	 : Invalid source or target frequency
+ * 								  STD_enuInvalidConfig	 : No legal PLL configuration found
+ */
+STD_enuErrorStatus_t RCC_enuSolvePLL(u32 Copy_u32TargetHz, RCC_enuClkIndex_t Copy_enuSource, RCC_strPLLConfig_t* Add_strPLLConfig);
+
+/**
+ * @brief Runs the system clock from the PLL at (the closest legal value to) the requested frequency
+ *
+ * Solves the PLL parameters with RCC_enuSolvePLL, starts the source oscillator, moves the
+ * system clock to HSI while the PLL is reconfigured then selects the PLL.
+ * The APB1 prescaler is raised before the switch when the new HCLK would run APB1
+ * above RCC_PCLK1_MAX_HZ (it's never lowered, the other prescalers are not changed).
+ *
+ * @param[in] Copy_u32TargetHz  : the requested system clock in Hz
+ * @param[in] Copy_enuSource    : the PLL source (RCC_HSI_CLK / RCC_HSE_CLK)
+ *
+ * @return STD_enuErrorStatus_t : STD_enuOk 			 : Successful Operation
+ * 								  STD_enuInvalidValue	 : Invalid source or target frequency
+ * 								  STD_enuInvalidConfig	 : No legal PLL configuration found
+ * 								  STD_enuOperationFailed : A clock failed to start/switch
+ */
+STD_enuErrorStatus_t RCC_enuConfigureSysClkHz(u32 Copy_u32TargetHz, RCC_enuClkIndex_t Copy_enuSource);
+
+/**
+ * @brief Returns the system clock speed in MHz (from the cached clock tree)
+ *        (prefer the integer RCC_u32Get...Hz getters)
+ *
+ * @return f32 : SYSCLK frequency in MHz
+ */
 f32 RCC_f32GetSysClkSpeed(void); 
 
 /**
- * @brief Set a function to call whenever the system clock is changed
- * 
- * This function is used to update the peripheral/module of the given index, if needed, with 
- * the new value of the system clock.
- * Should be used with modules that depend on system clock value in their operation.
- * It should be called by the give module's handler 
- * 		  
- * @param[in] Copy_u8Peripheral : Index of the peripheral
- * @param[in] Add_Callback   	: address of the callback function
+ * @brief Returns the system clock (SYSCLK) frequency in Hz
+ *
+ * The RCC_u32Get...Hz getters return the clock tree cached by RCC_enuSelectSysClk,
+ * RCC_enuConfigBusClk and RCC_enuConfigurePLL (no register reads)
+ *
+ * @return u32 : SYSCLK frequency in Hz
+ */
+u32 RCC_u32GetSysClkHz(void);
+
+/**
+ * @brief Returns the AHB clock (HCLK) frequency in Hz
+ *
+ * @return u32 : HCLK frequency in Hz
+ */
+u32 RCC_u32GetHclkHz(void);
+
+/**
+ * @brief Returns the APB1 peripheral clock (PCLK1) frequency in Hz
+ *
+ * @return u32 : PCLK1 frequency in Hz
+ */
+u32 RCC_u32GetPclk1Hz(void);
+
+/**
+ * @brief Returns the APB2 peripheral clock (PCLK2) frequency in Hz
+ *
+ * @return u32 : PCLK2 frequency in Hz
+ */
+u32 RCC_u32GetPclk2Hz(void);
+
+/**
+ * @brief Returns the clock frequency of the timers on APB1 (TIM2..TIM5) in Hz
+ *
+ * @return u32 : APB1 timers clock frequency in Hz
+ */
+u32 RCC_u32GetApb1TimClkHz(void);
+
+/**
+ * @brief Returns the clock frequency of the timers on APB2 (TIM1, TIM9..TIM11) in Hz
+ *
+ * @return u32 : APB2 timers clock frequency in Hz
+ */
+u32 RCC_u32GetApb2TimClkHz(void);
+
+/**
+ * @brief Copies the whole cached clock tree
+ *
+ * @param[out] Add_pstrClkTree  : address of the structure to copy the clock tree into
  *
  * @return STD_enuErrorStatus_t : STD_enuOk 	 : Successful Operation
- * 								  STD_enuNullPtr : Add_Callback is a NULL pointer
+ * 								  STD_enuNullPtr : Add_pstrClkTree is a NULL pointer
+ */
+STD_enuErrorStatus_t RCC_enuGetClkTree(RCC_strClkTree_t* Add_pstrClkTree);
+
+/**
+ * @brief Subscribes to system clock changes
+ *
+ * The node is linked into the subscribers list (no copy), so it must stay allocated
+ * (static/global) while subscribed. Subscribers are called in subscription order,
+ * once before the change (RCC_enuClkPreChange) and once after it (RCC_enuClkPostChange),
+ * with the new clock tree in both phases.
+ *
+ * @param[in] Add_pstrSubscriber: address of the subscriber node (with its Callback set)
+ *
+ * @return STD_enuErrorStatus_t : STD_enuOk 		  : Successful Operation
+ * 								  STD_enuNullPtr 	  : Add_pstrSubscriber or its Callback is a NULL pointer
+ * 								  STD_enuInvalidState : The node is already subscribed
+ */
+STD_enuErrorStatus_t RCC_enuSubscribeClkChange(RCC_strClkSubscriber_t* Add_pstrSubscriber);
+
+/**
+ * @brief Removes a subscriber added by RCC_enuSubscribeClkChange
+ *
+ * @param[in] Add_pstrSubscriber: address of the subscriber node
+ *
+ * @return STD_enuErrorStatus_t : STD_enuOk 		  : Successful Operation
+ * 								  STD_enuNullPtr 	  : Add_pstrSubscriber is a NULL pointer
+ * 								  STD_enuInvalidState : The node is not subscribed
+ */
+STD_enuErrorStatus_t RCC_enuUnsubscribeClkChange(RCC_strClkSubscriber_t* Add_pstrSubscriber);
+
+/**
+ * @brief Switches the clocks to one of the operating points configured in RCC_cfg.c
+ *
+ * The switch is done in a safe order: the target source is started (and the PLL
+ * configured if needed), then the prescalers are applied before the source switch when
+ * speeding up and after it when slowing down. The flash wait states follow every step.
+ * Subscribers are notified once before the switch and once after it (with the final
+ * clock tree). The PLL is stopped when the target source is not the PLL.
+ *
+ * @param[in] Copy_u8OpPoint	: index of the operating point (RCC_OP_POINT_xxx in RCC_cfg.h)
+ *
+ * @return STD_enuErrorStatus_t : STD_enuOk 			 : Successful Operation
+ * 								  STD_enuInvalidValue	 : Invalid operating point index
+ * 								  STD_enuInvalidConfig	 : Invalid operating point configuration
+ * 								  STD_enuOperationFailed : A clock failed to start/switch
+ */
+STD_enuErrorStatus_t RCC_enuSetOpPoint(u8 Copy_u8OpPoint);
+
+/**
+ * @brief Returns the duration of the last RCC_enuSetOpPoint call
+ *
+ * Measured with the DWT cycle counter: the cycles counted at each HCLK the switch went
+ * through are converted with that HCLK.
+ *
+ * @return u32 : switch duration in microseconds
+ */
+u32 RCC_u32GetOpPointSwitchUs(void);
+
+/**
+ * @brief Restores the system clock that was running before a stop mode
+ *
+ * Waking up from stop runs the system from HSI with HSE and the PLL stopped
+ * (their configuration and the bus prescalers are kept). The clocks that were
+ * ready before the stop are restarted and the previous source is selected again.
+ * Subscribers are only notified if the previous clock tree could not be restored.
+ *
+ * @return STD_enuErrorStatus_t : STD_enuOk 			 : Successful Operation
+ * 								  STD_enuOperationFailed : A clock failed to restart (system left on HSI)
  */
-STD_enuErrorStatus_t RCC_enuSetCBF(u8 Copy_u8Peripheral, void (*Add_Callback)(void));
+STD_enuErrorStatus_t RCC_enuRestoreAfterStop(void);
 
 #endif /* RCC_RCC_H_ */
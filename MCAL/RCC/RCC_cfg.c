@@ -0,0 +1,42 @@
+/*
+ * @file  : RCC_cfg.c
+ * @brief : RCC post-compile configurations (operating points table)
+ * @author: Alaa Hisham
+ * @date  : 18-03-2024
+ */
+/*===========================================================================================================*/
+/*												    Includes		 										 */
+/*===========================================================================================================*/
+#include "STD_TYPES.h"
+
+#include "RCC.h"
+#include "RCC_cfg.h"
+
+/*===========================================================================================================*/
+/*								 	 		  Operating Points												 */
+/*===========================================================================================================*/
+const RCC_strOpPoint_t RCC_strOpPointArr[NUMBER_OF_OP_POINTS] =
+{
+	[RCC_OP_POINT_RUN_84MHZ] =
+	{
+		.SysClk        = RCC_PLL_CLK					,
+		.PLLConfig     = RCC_PLL_CONFIG_INIT(RCC_HSI_CLK, 84000000UL),
+		.AhbPrescaler  = SYS_CLK_DIV_BY_1				,
+		.Apb1Prescaler = AHB_CLK_DIV_BY_2				,
+		.Apb2Prescaler = AHB_CLK_DIV_BY_1
+	},
+	[RCC_OP_POINT_RUN_16MHZ] =
+	{
+		.SysClk        = RCC_HSI_CLK					,
+		.AhbPrescaler  = SYS_CLK_DIV_BY_1				,
+		.Apb1Prescaler = AHB_CLK_DIV_BY_1				,
+		.Apb2Prescaler = AHB_CLK_DIV_BY_1
+	},
+	[RCC_OP_POINT_RUN_4MHZ] =
+	{
+		.SysClk        = RCC_HSI_CLK					,
+		.AhbPrescaler  = SYS_CLK_DIV_BY_4				,
+		.Apb1Prescaler = AHB_CLK_DIV_BY_1				,
+		.Apb2Prescaler = AHB_CLK_DIV_BY_1
+	}
+};
@@ -0,0 +1,26 @@
+/*
+ * @file  : RCC_cfg.h
+ * @brief : pre-compile configurations for the RCC operating points
+ * @author: Alaa Hisham
+ * @date  : 18-03-2024
+ */
+
+#ifndef RCC_RCC_CFG_H_
+#define RCC_RCC_CFG_H_
+
+/*===========================================================================================================*/
+/*												     Macros		 										     */
+/*===========================================================================================================*/
+/**
+ * @brief Indices of the operating points configured in RCC_cfg.c (passed to RCC_enuSetOpPoint)
+ */
+#define RCC_OP_POINT_RUN_84MHZ		0	/* PLL (from HSI) 84 MHz, APB1 42 MHz */
+#define RCC_OP_POINT_RUN_16MHZ		1	/* HSI 16 MHz, PLL stopped */
+#define RCC_OP_POINT_RUN_4MHZ		2	/* HSI / 4, PLL stopped */
+
+/**
+ * @brief The number of operating points configured in RCC_cfg.c
+ */
+#define NUMBER_OF_OP_POINTS			3
+
+#endif /* RCC_RCC_CFG_H_ */
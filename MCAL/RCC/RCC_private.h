@@ -62,8 +62,8 @@ typedef struct
 #define CR_HSE_RDY		   			17
 #define CR_PLL_RDY			 		25
 
-#define CR_SWS_READ_MASK	   		0x000C
-#define CR_SWS_READ_OFFSET	   		0x2
+#define CFGR_SWS_READ_MASK	   		0x0000000C
+#define CFGR_SWS_READ_OFFSET	   		0x2
 
 #define CFGR_AHB_PRSCLR_MASK	   	0XFFFFFF0F
 #define CFGR_AHB_PRSCLR_OFFSET   	4
@@ -79,11 +79,15 @@ typedef struct
 #define APB_PRSCLR_MAX	   	   		7
 #define APB_PRSCLR_MIN		   		4
 
+/* log2 of the bus division factor for each prescaler option (index = option - PRSCLR_MIN) */
+#define AHB_PRSCLR_SHIFTS			{1, 2, 3, 4, 6, 7, 8, 9}
+#define APB_PRSCLR_SHIFTS			{1, 2, 3, 4}
+
 
 /**
  * System Clock Selection
  */
-#define SYS_CLK_SELECT_MASK	   		0xFFFC
+#define SYS_CLK_SELECT_MASK	   		0xFFFFFFFC
 #define SYS_CLK_REG_OFFSET	   		0
 
 
@@ -93,6 +97,21 @@ typedef struct
 #define CLK_DISABLED 		   		0
 #define CLK_ENABLED 		   		1
 
+/**
+ * RCC Clock Interrupt Register bit offsets (bit = offset + RCC_enuClkIndex_t)
+ */
+#define CIR_RDYF_OFFSET				2		/* HSIRDYF, HSERDYF, PLLRDYF */
+#define CIR_RDYIE_OFFSET			10		/* HSIRDYIE, HSERDYIE, PLLRDYIE */
+#define CIR_RDYC_OFFSET				18		/* HSIRDYC, HSERDYC, PLLRDYC */
+
+/**
+ * Bounded wait for an oscillator/PLL to become ready or stop (in loop iterations,
+ * roughly 100 ms at 16 MHz which covers the HSE start-up time)
+ */
+#define CLK_READY_TIMEOUT			400000UL
+
+#define NUMBER_OF_SYS_CLKS			3
+
 /*
  * System bus offsets
  */
@@ -102,6 +121,18 @@ typedef struct
 #define APB2_OFFSET			   		60
 #define MAX_PERIPHERAL_INDEX   		79
 
+/*
+ * Implemented enable bits of each peripheral bus register
+ */
+#define AHB1ENR_VALID_MASK			0x0060109FUL
+#define AHB2ENR_VALID_MASK			0x00000080UL
+#define APB1ENR_VALID_MASK			0x10E2C80FUL
+#define APB2ENR_VALID_MASK			0x00077931UL
+
+#define NUMBER_OF_PERIPH_BUSES		4
+#define BUS_ENR_BITS				32
+#define PERIPH_CLK_REF_MAX			255
+
 /*----------------- PLL Configurations ------------------*/
 #define PLL_Q_MIN_VALUE		   		2
 #define PLL_Q_MAX_VALUE		   		15
@@ -125,9 +156,22 @@ typedef struct
 #define PLL_M_MASK 			   		0xFFFFFFC0
 		
 #define PLL_CLK_OFFSET		   		22
-#define PLL_CLK_MASK 		   		0xFFDFFFFF
+#define PLL_CLK_BIT			   		22
+#define PLL_CLK_MASK 		   		0xFFBFFFFF
 		
-#define HSI_CLK_SPEED_MHZ	   		16
-#define HSE_CLK_SPEED_MHZ	   		25
+#define PLL_P_TO_DIV(P)				(((P) + 1) * 2)
+#define PLL_P_OPTIONS				4
+
+#define HSI_CLK_SPEED_HZ	   		RCC_HSI_CLK_HZ
+#define HSE_CLK_SPEED_HZ	   		RCC_HSE_CLK_HZ
+
+#define HZ_PER_MHZ					1000000UL
+
+/* DWT cycle counter (used to measure the operating point switch) */
+#define DEMCR						(*((volatile u32*)0xE000EDFC))
+#define DEMCR_TRCENA_BIT			24
+#define DWT_CTRL					(*((volatile u32*)0xE0001000))
+#define DWT_CTRL_CYCCNTENA_BIT		0
+#define DWT_CYCCNT					(*((volatile u32*)0xE0001004))
 
 #endif /* RCC_RCC_PRIVATE_H_ */
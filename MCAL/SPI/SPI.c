@@ -0,0 +1,390 @@
+/*
+ * @file  : SPI.c
+ * @brief : API Implementations for the SPI peripherals (master, queued full-duplex DMA transactions)
+ * @author: Alaa Hisham
+ * @date  : 30-03-2024
+ */
+/*===========================================================================================================*/
+/*												    Includes		 										 */
+/*===========================================================================================================*/
+
+#include "STD_TYPES.h"
+#include "BIT_MATH.h"
+
+#include "RCC.h"
+#include "DMA.h"
+#include "GPIO.h"
+#include "SPI.h"
+#include "SPI_cfg.h"
+
+/*===========================================================================================================*/
+/*												     Macros		 										     */
+/*===========================================================================================================*/
+#define SPI1                ((volatile SPI_t*)0x40013000)
+#define SPI2                ((volatile SPI_t*)0x40003800)
+#define SPI3                ((volatile SPI_t*)0x40003C00)
+#define SPI4                ((volatile SPI_t*)0x40013400)
+
+#define CR1_MSTR_MASK       0x00000004
+#define CR1_SPE_MASK        0x00000040
+#define CR1_SSI_MASK        0x00000100
+#define CR1_SSM_MASK        0x00000200
+
+#define CR2_RXDMAEN_MASK    0x00000001
+#define CR2_TXDMAEN_MASK    0x00000002
+
+#define SR_BSY_MASK         0x00000080
+
+#define MODE_MASK           0x00000003
+#define PRESCALER_MASK      0x00000038
+
+/* The chip select is driven through the port bit set/reset register (GPIO keeps its registers private) */
+#define GPIO_BSRR(PORT)     (*(volatile u32*)((u32)(PORT) + 0x18))
+#define BSRR_RESET_OFFSET   16
+
+#define BUSY_TIMEOUT        1000UL
+
+/* PRIMASK save/restore around the state shared with the interrupts */
+#define ENTER_CRITICAL(STATE)   __asm volatile ("mrs %0, primask\n\tcpsid i" : "=r" (STATE) : : "memory")
+#define EXIT_CRITICAL(STATE)    __asm volatile ("msr primask, %0" : : "r" (STATE) : "memory")
+
+/*===========================================================================================================*/
+/*												     Types		 										     */
+/*===========================================================================================================*/
+typedef struct
+{
+    volatile u32 CR1;       /* Control register 1 */
+    volatile u32 CR2;       /* Control register 2 */
+    volatile u32 SR;        /* Status register */
+    volatile u32 DR;        /* Data register */
+    volatile u32 CRCPR;     /* CRC polynomial register */
+    volatile u32 RXCRCR;    /* RX CRC register */
+    volatile u32 TXCRCR;    /* TX CRC register */
+    volatile u32 I2SCFGR;   /* I2S configuration register */
+    volatile u32 I2SPR;     /* I2S prescaler register */
+} SPI_t;
+
+/* Fixed resources of a channel */
+typedef struct
+{
+    volatile SPI_t* Spi;
+    RCC_enuPeripheralIndex_t Clock;
+    DMA_enuStream_t RxStream;
+    DMA_enuStream_t TxStream;
+    u8 DmaChannel;
+} SPI_strChannelInfo_t;
+
+/* Run time state of a channel */
+typedef struct
+{
+    const SPI_strConfig_t* Config;      /* NULL while not initialized */
+    SPI_strTransaction_t* Head;         /* Transaction being transferred */
+    SPI_strTransaction_t* Tail;
+    u16 Fill;                           /* Sent without TxData */
+    u16 Discard;                        /* Received without RxData */
+} SPI_strChannelState_t;
+
+/*===========================================================================================================*/
+/*										  	   Global Variables											     */
+/*===========================================================================================================*/
+extern const SPI_strConfig_t SPI_strConfigArr[NUMBER_OF_CFG_SPIS];
+
+static const SPI_strChannelInfo_t SPI_strChannelInfo[SPI_CHANNELS] =
+{
+    [SPI_enuSpi1] = {SPI1, RCC_APB2_SPI1, DMA_enuDma2Stream0, DMA_enuDma2Stream3, 3},
+    [SPI_enuSpi2] = {SPI2, RCC_APB1_SPI2, DMA_enuDma1Stream3, DMA_enuDma1Stream4, 0},
+    [SPI_enuSpi3] = {SPI3, RCC_APB1_SPI3, DMA_enuDma1Stream0, DMA_enuDma1Stream7, 0},
+    [SPI_enuSpi4] = {SPI4, RCC_APB2_SPI4, DMA_enuDma2Stream0, DMA_enuDma2Stream1, 4}
+};
+
+static SPI_strChannelState_t SPI_strChannelState[SPI_CHANNELS];
+
+/*===========================================================================================================*/
+/*										  	   Private Functions											 */
+/*===========================================================================================================*/
+/**
+ * @brief Selects the chip, programs the frame format and the DMA streams of the head transaction
+ */
+static void start_transaction(SPI_enuChannel_t Copy_enuChannel);
+
+/**
+ * @brief Stops the channel, releases the chip select and runs the next transaction
+ */
+static void end_transaction(SPI_enuChannel_t Copy_enuChannel, SPI_enuState_t Copy_enuState);
+
+/**
+ * @brief DMA callback of the reception and transmission streams of all the channels
+ */
+static void dma_event(DMA_enuStream_t Copy_enuStream, u8 Copy_u8Events);
+
+/*===========================================================================================================*/
+/*										  	  API Implementations											 */
+/*===========================================================================================================*/
+/**
+ * @brief Initializes the channels configured in SPI_cfg.c as masters and reserves their DMA streams
+ *
+ * @return STD_enuErrorStatus_t : STD_enuOk 			 : Successful Operation
+ * 								  STD_enuInvalidConfig	 : Invalid channel configuration (channel left disabled)
+ * 								  STD_enuOperationFailed : A peripheral clock or a DMA stream could not be reserved
+ */
+STD_enuErrorStatus_t SPI_Init(void)
+{
+    STD_enuErrorStatus_t loc_enuErrorStatus = STD_enuOk;
+    const SPI_strConfig_t* loc_pstrConfig = NULL;
+    const SPI_strChannelInfo_t* loc_pstrInfo = NULL;
+    u8 loc_u8Iterator = ZERO;
+
+    for(loc_u8Iterator = ZERO; loc_u8Iterator < NUMBER_OF_CFG_SPIS; loc_u8Iterator++)
+    {
+        loc_pstrConfig = &SPI_strConfigArr[loc_u8Iterator];
+
+        if((loc_pstrConfig->Channel >= SPI_CHANNELS) || (NULL != SPI_strChannelState[loc_pstrConfig->Channel].Config))
+        {
+            loc_enuErrorStatus = STD_enuInvalidConfig;
+        }
+        else
+        {
+            loc_pstrInfo = &SPI_strChannelInfo[loc_pstrConfig->Channel];
+
+            /* A channel left disabled keeps none of its resources */
+            if(STD_enuOk != RCC_enuAcquirePeripheralClk(loc_pstrInfo->Clock))
+            {
+                loc_enuErrorStatus = STD_enuOperationFailed;
+            }
+            else if(STD_enuOk != DMA_enuAcquireStream(loc_pstrInfo->RxStream))
+            {
+                RCC_enuReleasePeripheralClk(loc_pstrInfo->Clock);
+                loc_enuErrorStatus = STD_enuOperationFailed;
+            }
+            else if(STD_enuOk != DMA_enuAcquireStream(loc_pstrInfo->TxStream))
+            {
+                DMA_enuReleaseStream(loc_pstrInfo->RxStream);
+                RCC_enuReleasePeripheralClk(loc_pstrInfo->Clock);
+                loc_enuErrorStatus = STD_enuOperationFailed;
+            }
+            else
+            {
+                /* Master with the hardware NSS unused (the chip selects are GPIOs) */
+                loc_pstrInfo->Spi->CR2 = ZERO;
+                loc_pstrInfo->Spi->CR1 = CR1_MSTR_MASK | CR1_SSM_MASK | CR1_SSI_MASK;
+
+                SPI_strChannelState[loc_pstrConfig->Channel].Head = NULL;
+                SPI_strChannelState[loc_pstrConfig->Channel].Tail = NULL;
+                SPI_strChannelState[loc_pstrConfig->Channel].Fill = (u16)(loc_pstrConfig->FillByte * 0x0101U);
+                SPI_strChannelState[loc_pstrConfig->Channel].Config = loc_pstrConfig;
+            }
+        }
+    }
+
+    return loc_enuErrorStatus;
+}
+
+/**
+ * @brief Queues a transaction, it runs by DMA after the transactions already queued on the
+ *        channel (the call does not wait)
+ *
+ * @param[in] Copy_enuChannel		: the channel (SPI_enuSpi1 ... SPI_enuSpi4)
+ * @param[in] Add_pstrTransaction	: the transaction
+ *
+ * @return STD_enuErrorStatus_t : STD_enuOk 		  : Successful Operation
+ * 								  STD_enuNullPtr	  : Add_pstrTransaction is a NULL pointer
+ * 								  STD_enuInvalidValue : Invalid channel / option / pin / length / 16 bits buffer alignment
+ * 								  STD_enuInvalidState : The channel is not initialized / the transaction is still pending
+ */
+STD_enuErrorStatus_t SPI_enuSubmit(SPI_enuChannel_t Copy_enuChannel, SPI_strTransaction_t* Add_pstrTransaction)
+{
+    STD_enuErrorStatus_t loc_enuErrorStatus = STD_enuOk;
+    SPI_strChannelState_t* loc_pstrState = NULL;
+    u32 loc_u32Primask = ZERO;
+
+    if(NULL == Add_pstrTransaction)
+    {
+        loc_enuErrorStatus = STD_enuNullPtr;
+    }
+    else if((Copy_enuChannel >= SPI_CHANNELS)
+         || (ZERO != (Add_pstrTransaction->Mode & ~MODE_MASK))
+         || (ZERO != (Add_pstrTransaction->Prescaler & ~PRESCALER_MASK))
+         || ((Add_pstrTransaction->DataSize != SPI_DATA_8BITS) && (Add_pstrTransaction->DataSize != SPI_DATA_16BITS))
+         || ((Add_pstrTransaction->BitOrder != SPI_MSB_FIRST) && (Add_pstrTransaction->BitOrder != SPI_LSB_FIRST))
+         || ((NULL != Add_pstrTransaction->CsPort) && (Add_pstrTransaction->CsPin >= GPIO_TOTAL_PINS))
+         || (ZERO == Add_pstrTransaction->Length)
+         || ((SPI_DATA_16BITS == Add_pstrTransaction->DataSize)
+          && (ZERO != (((u32)Add_pstrTransaction->TxData | (u32)Add_pstrTransaction->RxData) & 0x1))))
+    {
+        loc_enuErrorStatus = STD_enuInvalidValue;
+    }
+    else if(NULL == SPI_strChannelState[Copy_enuChannel].Config)
+    {
+        loc_enuErrorStatus = STD_enuInvalidState;
+    }
+    else
+    {
+        loc_pstrState = &SPI_strChannelState[Copy_enuChannel];
+
+        ENTER_CRITICAL(loc_u32Primask);
+
+        if((SPI_enuQueued == Add_pstrTransaction->State) || (SPI_enuRunning == Add_pstrTransaction->State))
+        {
+            loc_enuErrorStatus = STD_enuInvalidState;
+        }
+        else
+        {
+            Add_pstrTransaction->State = SPI_enuQueued;
+            Add_pstrTransaction->Next = NULL;
+
+            if(NULL == loc_pstrState->Head)
+            {
+                loc_pstrState->Head = Add_pstrTransaction;
+                loc_pstrState->Tail = Add_pstrTransaction;
+                start_transaction(Copy_enuChannel);
+            }
+            else
+            {
+                loc_pstrState->Tail->Next = Add_pstrTransaction;
+                loc_pstrState->Tail = Add_pstrTransaction;
+            }
+        }
+
+        EXIT_CRITICAL(loc_u32Primask);
+    }
+
+    return loc_enuErrorStatus;
+}
+
+/*===========================================================================================================*/
+/*										  	 Private Implementations										 */
+/*===========================================================================================================*/
+static void start_transaction(SPI_enuChannel_t Copy_enuChannel)
+{
+    const SPI_strChannelInfo_t* loc_pstrInfo = &SPI_strChannelInfo[Copy_enuChannel];
+    SPI_strChannelState_t* loc_pstrState = &SPI_strChannelState[Copy_enuChannel];
+    SPI_strTransaction_t* loc_pstrTransaction = loc_pstrState->Head;
+    DMA_strConfig_t loc_strDmaConfig = {ZERO};
+    volatile u32 loc_u32Dummy = ZERO;
+
+    loc_pstrTransaction->State = SPI_enuRunning;
+
+    /* Frame format can only change while the SPI is disabled */
+    loc_pstrInfo->Spi->CR1 = CR1_MSTR_MASK | CR1_SSM_MASK | CR1_SSI_MASK | loc_pstrTransaction->Mode
+                           | loc_pstrTransaction->Prescaler | loc_pstrTransaction->DataSize | loc_pstrTransaction->BitOrder;
+
+    /* A stale frame or overrun from the previous transaction is dropped (DR then SR) */
+    loc_u32Dummy = loc_pstrInfo->Spi->DR;
+    loc_u32Dummy = loc_pstrInfo->Spi->SR;
+    (void)loc_u32Dummy;
+
+    if(NULL != loc_pstrTransaction->CsPort)
+    {
+        GPIO_BSRR(loc_pstrTransaction->CsPort) = 1UL << (loc_pstrTransaction->CsPin + BSRR_RESET_OFFSET);
+    }
+    else
+    {
+        /* Do Nothing */
+    }
+
+    loc_strDmaConfig.Channel = loc_pstrInfo->DmaChannel;
+    loc_strDmaConfig.PeriphSize = (SPI_DATA_16BITS == loc_pstrTransaction->DataSize) ? DMA_SIZE_HALFWORD : DMA_SIZE_BYTE;
+    loc_strDmaConfig.MemSize = loc_strDmaConfig.PeriphSize;
+    loc_strDmaConfig.Fifo = DMA_FIFO_DIRECT;
+    loc_strDmaConfig.Callback = dma_event;
+
+    /* The reception is served first so the data register is never overrun, its end is the end of the transaction */
+    loc_strDmaConfig.Direction = DMA_PERIPH_TO_MEM;
+    loc_strDmaConfig.Mode = (NULL != loc_pstrTransaction->RxData) ? DMA_MODE_MEM_INC : ZERO;
+    loc_strDmaConfig.Priority = DMA_PRIORITY_VERY_HIGH;
+    loc_strDmaConfig.Events = DMA_EVENT_COMPLETE | DMA_EVENT_ERROR;
+    DMA_enuConfigure(loc_pstrInfo->RxStream, &loc_strDmaConfig);
+
+    loc_strDmaConfig.Direction = DMA_MEM_TO_PERIPH;
+    loc_strDmaConfig.Mode = (NULL != loc_pstrTransaction->TxData) ? DMA_MODE_MEM_INC : ZERO;
+    loc_strDmaConfig.Priority = DMA_PRIORITY_HIGH;
+    loc_strDmaConfig.Events = DMA_EVENT_ERROR;
+    DMA_enuConfigure(loc_pstrInfo->TxStream, &loc_strDmaConfig);
+
+    DMA_enuStart(loc_pstrInfo->RxStream, (u32)&loc_pstrInfo->Spi->DR,
+                 (NULL != loc_pstrTransaction->RxData) ? (u32)loc_pstrTransaction->RxData : (u32)&loc_pstrState->Discard,
+                 loc_pstrTransaction->Length);
+    DMA_enuStart(loc_pstrInfo->TxStream, (u32)&loc_pstrInfo->Spi->DR,
+                 (NULL != loc_pstrTransaction->TxData) ? (u32)loc_pstrTransaction->TxData : (u32)&loc_pstrState->Fill,
+                 loc_pstrTransaction->Length);
+
+    loc_pstrInfo->Spi->CR2 = CR2_RXDMAEN_MASK | CR2_TXDMAEN_MASK;
+    loc_pstrInfo->Spi->CR1 |= CR1_SPE_MASK;
+}
+
+static void end_transaction(SPI_enuChannel_t Copy_enuChannel, SPI_enuState_t Copy_enuState)
+{
+    const SPI_strChannelInfo_t* loc_pstrInfo = &SPI_strChannelInfo[Copy_enuChannel];
+    SPI_strChannelState_t* loc_pstrState = &SPI_strChannelState[Copy_enuChannel];
+    SPI_strTransaction_t* loc_pstrTransaction = loc_pstrState->Head;
+    u32 loc_u32Timeout = BUSY_TIMEOUT;
+
+    DMA_enuStop(loc_pstrInfo->TxStream);
+    DMA_enuStop(loc_pstrInfo->RxStream);
+
+    while((loc_pstrInfo->Spi->SR & SR_BSY_MASK) && (loc_u32Timeout > ZERO))
+    {
+        loc_u32Timeout--;
+    }
+
+    loc_pstrInfo->Spi->CR2 = ZERO;
+    loc_pstrInfo->Spi->CR1 &= ~CR1_SPE_MASK;
+
+    /* A failed transaction always releases the chip */
+    if((NULL != loc_pstrTransaction->CsPort) && (!loc_pstrTransaction->KeepCs || (SPI_enuDone != Copy_enuState)))
+    {
+        GPIO_BSRR(loc_pstrTransaction->CsPort) = 1UL << loc_pstrTransaction->CsPin;
+    }
+    else
+    {
+        /* Do Nothing */
+    }
+
+    /* The next transaction starts before the callback, which may queue this one again */
+    loc_pstrState->Head = loc_pstrTransaction->Next;
+    loc_pstrTransaction->State = Copy_enuState;
+
+    if(NULL != loc_pstrState->Head)
+    {
+        start_transaction(Copy_enuChannel);
+    }
+    else
+    {
+        loc_pstrState->Tail = NULL;
+    }
+
+    if(NULL != loc_pstrTransaction->Callback)
+    {
+        loc_pstrTransaction->Callback(Copy_enuChannel, loc_pstrTransaction);
+    }
+    else
+    {
+        /* Do Nothing */
+    }
+}
+
+static void dma_event(DMA_enuStream_t Copy_enuStream, u8 Copy_u8Events)
+{
+    u8 loc_u8Channel = ZERO;
+
+    for(loc_u8Channel = ZERO; loc_u8Channel < SPI_CHANNELS; loc_u8Channel++)
+    {
+        if((NULL == SPI_strChannelState[loc_u8Channel].Config) || (NULL == SPI_strChannelState[loc_u8Channel].Head)
+        || ((Copy_enuStream != SPI_strChannelInfo[loc_u8Channel].RxStream) && (Copy_enuStream != SPI_strChannelInfo[loc_u8Channel].TxStream)))
+        {
+            /* Do Nothing */
+        }
+        else if(Copy_u8Events & DMA_EVENT_ERROR)
+        {
+            end_transaction((SPI_enuChannel_t)loc_u8Channel, SPI_enuFailed);
+        }
+        else if((Copy_enuStream == SPI_strChannelInfo[loc_u8Channel].RxStream) && (Copy_u8Events & DMA_EVENT_COMPLETE))
+        {
+            end_transaction((SPI_enuChannel_t)loc_u8Channel, SPI_enuDone);
+        }
+        else
+        {
+            /* Do Nothing */
+        }
+    }
+}
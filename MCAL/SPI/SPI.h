@@ -0,0 +1,158 @@
+/*
+ * @file  : SPI.h
+ * @brief : user interface for the SPI peripherals (master, queued full-duplex DMA transactions)
+ * @author: Alaa Hisham
+ * @date  : 30-03-2024
+ */
+
+#ifndef SPI_H_
+#define SPI_H_
+
+/*===========================================================================================================*/
+/*												    Includes	 										     */
+/*===========================================================================================================*/
+#include "STD_TYPES.h"
+
+/*===========================================================================================================*/
+/*												     Macros		 										     */
+/*===========================================================================================================*/
+/**
+ * Clock polarity/phase options
+ */
+#define SPI_MODE_0				0x00000000	/* CPOL 0, CPHA 0 */
+#define SPI_MODE_1				0x00000001	/* CPOL 0, CPHA 1 */
+#define SPI_MODE_2				0x00000002	/* CPOL 1, CPHA 0 */
+#define SPI_MODE_3				0x00000003	/* CPOL 1, CPHA 1 */
+
+/**
+ * Clock divisor options (SCK = PCLK / divisor, PCLK2 for SPI1/SPI4, PCLK1 for SPI2/SPI3)
+ */
+#define SPI_CLK_DIV_2			0x00000000
+#define SPI_CLK_DIV_4			0x00000008
+#define SPI_CLK_DIV_8			0x00000010
+#define SPI_CLK_DIV_16			0x00000018
+#define SPI_CLK_DIV_32			0x00000020
+#define SPI_CLK_DIV_64			0x00000028
+#define SPI_CLK_DIV_128			0x00000030
+#define SPI_CLK_DIV_256			0x00000038
+
+/**
+ * Frame size options (16 bits frames use half-word aligned buffers)
+ */
+#define SPI_DATA_8BITS			0x00000000
+#define SPI_DATA_16BITS			0x00000800
+
+/**
+ * Bit order options
+ */
+#define SPI_MSB_FIRST			0x00000000
+#define SPI_LSB_FIRST			0x00000080
+
+#define SPI_CHANNELS			4
+
+/*===========================================================================================================*/
+/*												     Types		 										     */
+/*===========================================================================================================*/
+typedef enum
+{
+	SPI_enuSpi1	,	/* APB2, DMA2 stream 0 (RX) / stream 3 (TX) channel 3 */
+	SPI_enuSpi2	,	/* APB1, DMA1 stream 3 (RX) / stream 4 (TX) channel 0 */
+	SPI_enuSpi3	,	/* APB1, DMA1 stream 0 (RX) / stream 7 (TX) channel 0 */
+	SPI_enuSpi4		/* APB2, DMA2 stream 0 (RX) / stream 1 (TX) channel 4 (shares streams with SPI1/USART6) */
+}SPI_enuChannel_t;
+
+typedef enum
+{
+	SPI_enuIdle		,	/* Never queued */
+	SPI_enuQueued	,	/* Waiting for the previous transactions */
+	SPI_enuRunning	,	/* Being transferred by the DMA */
+	SPI_enuDone		,	/* Completed: the received data can be used */
+	SPI_enuFailed		/* DMA error: the chip select is released */
+}SPI_enuState_t;
+
+struct SPI_strTransaction;
+
+/* Transaction callback: called from interrupt context once the transaction buffers can be reused */
+typedef void (*SPI_CBF_t)(SPI_enuChannel_t Copy_enuChannel, struct SPI_strTransaction* Add_pstrTransaction);
+
+/**
+ * Transaction (statically allocated by the sender)
+ * The transaction and its buffers must stay untouched until it is done or failed.
+ */
+typedef struct SPI_strTransaction
+{
+	/**
+	 * The chip select, driven low for the transaction through the port BSRR
+	 * (the pin is configured as an output at high level by the application; NULL port: no chip select)
+	 */
+	void* CsPort;
+	u8 CsPin;
+
+	/**
+	 * Keep the chip select low after the transaction (e.g. a flash command followed by its data)
+	 * The next transaction on the channel must use the same chip select.
+	 */
+	u8 KeepCs;
+
+	/**
+	 * Options: SPI_MODE_0 ... SPI_MODE_3
+	 */
+	u32 Mode;
+
+	/**
+	 * Options: SPI_CLK_DIV_2 ... SPI_CLK_DIV_256
+	 */
+	u32 Prescaler;
+
+	/**
+	 * Options: SPI_DATA_8BITS / SPI_DATA_16BITS, SPI_MSB_FIRST / SPI_LSB_FIRST
+	 */
+	u32 DataSize;
+	u32 BitOrder;
+
+	/**
+	 * The frames sent and received at the same time (Length frames each)
+	 * NULL TxData: the channel fill frame is sent, NULL RxData: the received frames are dropped
+	 * Range: Length [1 - 65535]
+	 */
+	const void* TxData;
+	void* RxData;
+	u16 Length;
+
+	SPI_CBF_t Callback;							/* Can be NULL */
+	volatile SPI_enuState_t State;				/* Managed by SPI */
+	struct SPI_strTransaction* Next;			/* Managed by SPI */
+}SPI_strTransaction_t;
+
+/*===========================================================================================================*/
+/*											 Function Prototypes											 */
+/*===========================================================================================================*/
+
+/**
+ * @brief Initializes the channels configured in SPI_cfg.c as masters and reserves their DMA streams
+ *
+ * The SCK/MISO/MOSI pins are set to their alternate function by the application (AF5 for
+ * SPI1/SPI2/SPI4, AF6 for SPI3) and the DMA stream interrupts of the used channels must be
+ * enabled in NVIC_cfg.c (a channel's streams at the same priority).
+ *
+ * @return STD_enuErrorStatus_t : STD_enuOk 			 : Successful Operation
+ * 								  STD_enuInvalidConfig	 : Invalid channel configuration (channel left disabled)
+ * 								  STD_enuOperationFailed : A peripheral clock or a DMA stream could not be reserved
+ */
+STD_enuErrorStatus_t SPI_Init(void);
+
+/**
+ * @brief Queues a transaction, it runs by DMA after the transactions already queued on the
+ *        channel (the call does not wait)
+ *
+ * @param[in] Copy_enuChannel		: the channel (SPI_enuSpi1 ... SPI_enuSpi4)
+ * @param[in] Add_pstrTransaction	: the transaction
+ *
+ * @return STD_enuErrorStatus_t : STD_enuOk 		  : Successful Operation
+ * 								  STD_enuNullPtr	  : Add_pstrTransaction is a NULL pointer
+ * 								  STD_enuInvalidValue : Invalid channel / option / pin / length / 16 bits buffer alignment
+ * 								  STD_enuInvalidState : The channel is not initialized / the transaction is still pending
+ */
+STD_enuErrorStatus_t SPI_enuSubmit(SPI_enuChannel_t Copy_enuChannel, SPI_strTransaction_t* Add_pstrTransaction);
+
+#endif /* SPI_H_ */
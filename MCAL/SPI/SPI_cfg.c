@@ -0,0 +1,25 @@
+/*
+ * @file  : SPI_cfg.c
+ * @brief : SPI post-compile configurations (channels table)
+ * @author: Alaa Hisham
+ * @date  : 30-03-2024
+ */
+/*===========================================================================================================*/
+/*												    Includes		 										 */
+/*===========================================================================================================*/
+#include "STD_TYPES.h"
+
+#include "SPI.h"
+#include "SPI_cfg.h"
+
+/*===========================================================================================================*/
+/*								 	 		  Channels Configuration										 */
+/*===========================================================================================================*/
+const SPI_strConfig_t SPI_strConfigArr[NUMBER_OF_CFG_SPIS] =
+{
+	/* External flash and ADC */
+	{
+		.Channel  = SPI_enuSpi1		,
+		.FillByte = 0xFF
+	}
+};
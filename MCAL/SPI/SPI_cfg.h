@@ -0,0 +1,42 @@
+/*
+ * @file  : SPI_cfg.h
+ * @brief : pre-compile configurations for the SPI peripherals
+ * @author: Alaa Hisham
+ * @date  : 30-03-2024
+ */
+
+#ifndef SPI_CFG_H_
+#define SPI_CFG_H_
+
+/*===========================================================================================================*/
+/*												    Includes	 										     */
+/*===========================================================================================================*/
+#include "STD_TYPES.h"
+#include "SPI.h"
+
+/*===========================================================================================================*/
+/*												     Macros		 										     */
+/*===========================================================================================================*/
+/**
+ * @brief The number of channels configured in SPI_cfg.c
+ */
+#define NUMBER_OF_CFG_SPIS			1
+
+/*===========================================================================================================*/
+/*												     Types		 										     */
+/*===========================================================================================================*/
+typedef struct
+{
+	/**
+	 * The SPI peripheral
+	 * Options: SPI_enuSpi1, SPI_enuSpi2, SPI_enuSpi3, SPI_enuSpi4
+	 */
+	SPI_enuChannel_t Channel;
+
+	/**
+	 * The frame sent by the transactions without TxData (repeated in both bytes of 16 bits frames)
+	 */
+	u8 FillByte;
+}SPI_strConfig_t;
+
+#endif /* SPI_CFG_H_ */
@@ -23,13 +23,14 @@
 
 #define CTRL_ENABLE_MASK    0X00000001
 #define CTRL_INTERRUPT_MASK 0X00000002
+#define CTRL_CLKSOURCE_MASK 0X00000004
 
 #define LOAD_MAX_VAL        0X00FFFFFF
 
-#define MS_TO_US(MS_TIME)   ((MS_TIME)*1000)
-#define US_TO_MS(US_TIME)   ((US_TIME)/1000)
+#define MS_PER_SEC          1000
+#define HZ_PER_MHZ          1000000UL
 
-#define MAX_AHB_CLK_MHZ     84
+#define MAX_AHB_CLK_HZ      84000000UL
 /*===========================================================================================================*/
 /*												     Types		 										     */
 /*===========================================================================================================*/
@@ -39,8 +40,8 @@
 /*										  	   Global Variables											     */
 /*===========================================================================================================*/
 SYSTICK_enuMode_t STK_gl_mode = OneTime;
-f32 AHB_ClkSpeed_MHz = 16; /* Default (HSI) Clock Value */
-SYSTICK_enuClkSrc_t STK_gl_DivFactor = 8; 
+u32 AHB_ClkSpeed_Hz = 16000000UL; /* Default (HSI) Clock Value */
+u8 STK_gl_DivFactor = 8; 
 void (*SYSTICK_IntHandler)(void) = NULL;
 
 /*===========================================================================================================*/
@@ -97,9 +98,17 @@ STD_enuErrorStatus_t SYSTICK_SetClkPrescaler(SYSTICK_enuClkSrc_t Copy_enuPrescal
     if ((CLK_AHB_DIV_BY_8 == Copy_enuPrescaler) 
      || (CLK_AHB == Copy_enuPrescaler))
     {
-        AHB_ClkSpeed_MHz = Copy_enuPrescaler;
-
-        STK_CTRL |= CTRL_ENABLE_MASK;
+        /* CLKSOURCE: 0 -> AHB/8, 1 -> AHB (processor clock) */
+        if(CLK_AHB == Copy_enuPrescaler)
+        {
+            STK_gl_DivFactor = 1;
+            STK_CTRL |= CTRL_CLKSOURCE_MASK;
+        }
+        else
+        {
+            STK_gl_DivFactor = 8;
+            STK_CTRL &= ~CTRL_CLKSOURCE_MASK;
+        }
     }
     else
     {
@@ -122,9 +131,34 @@ STD_enuErrorStatus_t SYSTICK_SetClkSpeed(f32 Copy_f32ClkSpeed)
 {
     STD_enuErrorStatus_t loc_enuErrorStatus = STD_enuOk;
 
-    if (Copy_f32ClkSpeed > MAX_AHB_CLK_MHZ)
+    if ((Copy_f32ClkSpeed > ZERO) && (Copy_f32ClkSpeed <= (MAX_AHB_CLK_HZ / HZ_PER_MHZ)))
+    {
+        loc_enuErrorStatus = SYSTICK_SetClkHz((u32)(Copy_f32ClkSpeed * HZ_PER_MHZ));
+    }
+    else
+    {
+        loc_enuErrorStatus = STD_enuInvalidValue;
+    }
+
+    return loc_enuErrorStatus;
+}
+
+/**
+ * @brief Sets the AHB clock frequency used for the timer's reload calculations
+ *
+ * @param[in] Copy_u32ClkHz     : The AHB Clock frequency (in Hz)
+ *
+ * @return STD_enuErrorStatus_t : STD_enuOk 			 : Successful Operation
+ * 								  STD_enuInvalidValue	 : Invalid clock frequency
+ */
+STD_enuErrorStatus_t SYSTICK_SetClkHz(u32 Copy_u32ClkHz)
+{
+    STD_enuErrorStatus_t loc_enuErrorStatus = STD_enuOk;
+
+    /* Needs at least one timer tick per ms with the AHB/8 source */
+    if ((Copy_u32ClkHz >= (8 * MS_PER_SEC)) && (Copy_u32ClkHz <= MAX_AHB_CLK_HZ))
     {
-        AHB_ClkSpeed_MHz = Copy_f32ClkSpeed;
+        AHB_ClkSpeed_Hz = Copy_u32ClkHz;
     }
     else
     {
@@ -146,16 +180,17 @@ STD_enuErrorStatus_t SYSTICK_setTimeMs(u32 Copy_u32Time)
 {
     STD_enuErrorStatus_t loc_enuErrorStatus = STD_enuOk;
     
-    float loc_f32TickTime_us = (float)STK_gl_DivFactor/AHB_ClkSpeed_MHz;
-    u16 loc_u16MaxTime_ms = US_TO_MS(loc_f32TickTime_us*LOAD_MAX_VAL);
+    u32 loc_u32TicksPerMs = AHB_ClkSpeed_Hz / STK_gl_DivFactor / MS_PER_SEC;
+    u32 loc_u32MaxTime_ms = (LOAD_MAX_VAL + 1) / loc_u32TicksPerMs;
 
-    if(Copy_u32Time > loc_u16MaxTime_ms)
+    if((ZERO == Copy_u32Time) || (Copy_u32Time > loc_u32MaxTime_ms))
     {
         loc_enuErrorStatus = STD_enuInvalidValue;
     }
     else
     {
-        STK_LOAD = MS_TO_US(Copy_u32Time)/loc_f32TickTime_us;
+        /* The counter wraps after LOAD + 1 ticks */
+        STK_LOAD = (Copy_u32Time * loc_u32TicksPerMs) - 1;
     }
 
     return loc_enuErrorStatus;
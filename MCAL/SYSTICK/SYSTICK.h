@@ -65,6 +65,16 @@ void SYSTICK_stop(void);
  */
 STD_enuErrorStatus_t SYSTICK_SetClkSpeed(f32 Copy_f32ClkSpeed); 
 
+/**
+ * @brief Sets the AHB clock frequency used for the timer's reload calculations
+ *
+ * @param[in] Copy_u32ClkHz     : The AHB Clock frequency (in Hz)
+ *
+ * @return STD_enuErrorStatus_t : STD_enuOk 			 : Successful Operation
+ * 								  STD_enuInvalidValue	 : Invalid clock frequency
+ */
+STD_enuErrorStatus_t SYSTICK_SetClkHz(u32 Copy_u32ClkHz);
+
 /**
  * @brief Sets the prescaler for SysTick input clock
  *
@@ -0,0 +1,821 @@
+/*
+ * @file  : USART.c
+ * @brief : API Implementations for the USART peripherals (DMA circular reception & queued DMA transmission)
+ * @author: Alaa Hisham
+ * @date  : 25-03-2024
+ */
+/*===========================================================================================================*/
+/*												    Includes		 										 */
+/*===========================================================================================================*/
+
+#include "STD_TYPES.h"
+#include "BIT_MATH.h"
+
+#include "RCC.h"
+#include "DMA.h"
+#include "USART.h"
+#include "USART_cfg.h"
+
+/*===========================================================================================================*/
+/*												     Macros		 										     */
+/*===========================================================================================================*/
+#define USART1              ((volatile USART_t*)0x40011000)
+#define USART2              ((volatile USART_t*)0x40004400)
+#define USART6              ((volatile USART_t*)0x40011400)
+
+#define SR_IDLE_MASK        0x00000010
+#define SR_TC_MASK          0x00000040
+
+#define CR1_RE_MASK         0x00000004
+#define CR1_TE_MASK         0x00000008
+#define CR1_IDLEIE_MASK     0x00000010
+#define CR1_UE_MASK         0x00002000
+
+#define CR3_DMAR_MASK       0x00000040
+#define CR3_DMAT_MASK       0x00000080
+
+/* BRR limits (USARTDIV x 16 with oversampling by 16, USARTDIV x 8 with oversampling by 8) */
+#define BRR_MIN_DIV16       16
+#define BRR_MAX_DIV16       0xFFFF
+#define BRR_MIN_DIV8        8
+#define BRR_MAX_DIV8        0x7FFF
+#define BRR_FRACTION_BITS   4
+
+/* PRIMASK save/restore around the state shared with the interrupts */
+#define ENTER_CRITICAL(STATE)   __asm volatile ("mrs %0, primask\n\tcpsid i" : "=r" (STATE) : : "memory")
+#define EXIT_CRITICAL(STATE)    __asm volatile ("msr primask, %0" : : "r" (STATE) : "memory")
+
+/*===========================================================================================================*/
+/*												     Types		 										     */
+/*===========================================================================================================*/
+typedef struct
+{
+    volatile u32 SR;        /* Status register */
+    volatile u32 DR;        /* Data register */
+    volatile u32 BRR;       /* Baud rate register */
+    volatile u32 CR1;       /* Control register 1 */
+    volatile u32 CR2;       /* Control register 2 */
+    volatile u32 CR3;       /* Control register 3 */
+    volatile u32 GTPR;      /* Guard time and prescaler register */
+} USART_t;
+
+/* Fixed resources of a channel */
+typedef struct
+{
+    volatile USART_t* Usart;
+    RCC_enuPeripheralIndex_t Clock;
+    DMA_enuStream_t RxStream;
+    DMA_enuStream_t TxStream;
+    u8 DmaChannel;
+} USART_strChannelInfo_t;
+
+/* Run time state of a channel */
+typedef struct
+{
+    const USART_strConfig_t* Config;    /* NULL while not initialized */
+    u32 BaudRate;
+    u16 RxTail;                         /* First unread byte */
+    u16 RxHead;                         /* DMA write position at the last update */
+    u16 RxAvailable;                    /* Unread bytes */
+    u32 RxLost;
+    USART_strTxRequest_t* TxHead;       /* Request being sent */
+    USART_strTxRequest_t* TxTail;
+} USART_strChannelState_t;
+
+/*===========================================================================================================*/
+/*										  	   Global Variables											     */
+/*===========================================================================================================*/
+extern const USART_strConfig_t USART_strConfigArr[NUMBER_OF_CFG_USARTS];
+
+static const USART_strChannelInfo_t USART_strChannelInfo[USART_CHANNELS] =
+{
+    [USART_enuUsart1] = {USART1, RCC_APB2_USART1, DMA_enuDma2Stream2, DMA_enuDma2Stream7, 4},
+    [USART_enuUsart2] = {USART2, RCC_APB1_USART2, DMA_enuDma1Stream5, DMA_enuDma1Stream6, 4},
+    [USART_enuUsart6] = {USART6, RCC_APB2_USART6, DMA_enuDma2Stream1, DMA_enuDma2Stream6, 5}
+};
+
+static USART_strChannelState_t USART_strChannelState[USART_CHANNELS];
+
+/*===========================================================================================================*/
+/*										  	   Private Functions											 */
+/*===========================================================================================================*/
+/**
+ * @brief Computes the BRR value of a baud rate for the given bus clock
+ */
+static STD_enuErrorStatus_t compute_brr(u32 Copy_u32PclkHz, u32 Copy_u32BaudRate, u32 Copy_u32Oversampling, u32* Add_pu32Brr);
+
+/**
+ * @brief Returns the bus clock of a channel (PCLK2 for USART1/USART6, PCLK1 for USART2)
+ */
+static u32 get_pclk_hz(USART_enuChannel_t Copy_enuChannel, const RCC_strClkTree_t* Add_pstrTree);
+
+static void clk_change(RCC_enuClkChangePhase_t Copy_enuPhase, const RCC_strClkTree_t* Add_pstrClkTree);
+
+/**
+ * @brief Accounts the bytes written by the reception DMA since the last update
+ *        (must run with the interrupts masked or from the channel interrupts)
+ */
+static void update_rx(USART_enuChannel_t Copy_enuChannel);
+
+static void rx_event(USART_enuChannel_t Copy_enuChannel);
+
+/**
+ * @brief Programs the transmission DMA with the current segment of the head request
+ */
+static void start_tx(USART_enuChannel_t Copy_enuChannel);
+
+static void tx_event(USART_enuChannel_t Copy_enuChannel, u8 Copy_u8Events);
+
+static void usart_irq(USART_enuChannel_t Copy_enuChannel);
+
+/**
+ * @brief DMA callback of the reception and transmission streams of all the channels
+ */
+static void dma_event(DMA_enuStream_t Copy_enuStream, u8 Copy_u8Events);
+
+/*===========================================================================================================*/
+/*										  	  API Implementations											 */
+/*===========================================================================================================*/
+/**
+ * @brief Initializes the channels configured in USART_cfg.c: clocks, frame format, baud rate
+ *        and the circular DMA reception
+ *
+ * @return STD_enuErrorStatus_t : STD_enuOk 			 : Successful Operation
+ * 								  STD_enuInvalidConfig	 : Invalid channel configuration (channel left disabled)
+ * 								  STD_enuOperationFailed : A peripheral clock or a DMA stream could not be reserved
+ */
+STD_enuErrorStatus_t USART_Init(void)
+{
+    static RCC_strClkSubscriber_t loc_strClkSubscriber = {clk_change, NULL};
+    STD_enuErrorStatus_t loc_enuErrorStatus = STD_enuOk;
+    const USART_strConfig_t* loc_pstrConfig = NULL;
+    const USART_strChannelInfo_t* loc_pstrInfo = NULL;
+    DMA_strConfig_t loc_strDmaConfig = {ZERO};
+    u32 loc_u32Brr = ZERO;
+    u8 loc_u8Iterator = ZERO;
+
+    for(loc_u8Iterator = ZERO; loc_u8Iterator < NUMBER_OF_CFG_USARTS; loc_u8Iterator++)
+    {
+        loc_pstrConfig = &USART_strConfigArr[loc_u8Iterator];
+
+        if((loc_pstrConfig->Channel >= USART_CHANNELS)
+        || (NULL != USART_strChannelState[loc_pstrConfig->Channel].Config)
+        || ((loc_pstrConfig->WordLength != USART_WORD_8BITS) && (loc_pstrConfig->WordLength != USART_WORD_9BITS))
+        || ((loc_pstrConfig->Parity != USART_PARITY_NONE) && (loc_pstrConfig->Parity != USART_PARITY_EVEN)
+         && (loc_pstrConfig->Parity != USART_PARITY_ODD))
+        || ((loc_pstrConfig->WordLength == USART_WORD_9BITS) && (loc_pstrConfig->Parity == USART_PARITY_NONE))
+        || ((loc_pstrConfig->StopBits != USART_STOP_1BIT) && (loc_pstrConfig->StopBits != USART_STOP_2BITS))
+        || ((NULL != loc_pstrConfig->RxBuffer) && ((loc_pstrConfig->RxBufferSize < 2) || (loc_pstrConfig->RxBufferSize > DMA_MAX_COUNT)))
+        || (STD_enuOk != compute_brr(get_pclk_hz(loc_pstrConfig->Channel, NULL), loc_pstrConfig->BaudRate,
+                                     loc_pstrConfig->Oversampling, &loc_u32Brr)))
+        {
+            loc_enuErrorStatus = STD_enuInvalidConfig;
+        }
+        else
+        {
+            loc_pstrInfo = &USART_strChannelInfo[loc_pstrConfig->Channel];
+
+            /* Byte streams in direct mode, the reception one runs forever around the buffer */
+            loc_strDmaConfig.Channel = loc_pstrInfo->DmaChannel;
+            loc_strDmaConfig.Priority = DMA_PRIORITY_HIGH;
+            loc_strDmaConfig.PeriphSize = DMA_SIZE_BYTE;
+            loc_strDmaConfig.MemSize = DMA_SIZE_BYTE;
+            loc_strDmaConfig.Fifo = DMA_FIFO_DIRECT;
+            loc_strDmaConfig.Callback = dma_event;
+
+            /* A channel left disabled keeps none of its resources */
+            if(STD_enuOk != RCC_enuAcquirePeripheralClk(loc_pstrInfo->Clock))
+            {
+                loc_enuErrorStatus = STD_enuOperationFailed;
+            }
+            else if(STD_enuOk != DMA_enuAcquireStream(loc_pstrInfo->TxStream))
+            {
+                RCC_enuReleasePeripheralClk(loc_pstrInfo->Clock);
+                loc_enuErrorStatus = STD_enuOperationFailed;
+            }
+            else if((NULL != loc_pstrConfig->RxBuffer) && (STD_enuOk != DMA_enuAcquireStream(loc_pstrInfo->RxStream)))
+            {
+                DMA_enuReleaseStream(loc_pstrInfo->TxStream);
+                RCC_enuReleasePeripheralClk(loc_pstrInfo->Clock);
+                loc_enuErrorStatus = STD_enuOperationFailed;
+            }
+            else
+            {
+                loc_pstrInfo->Usart->CR1 = ZERO;
+                loc_pstrInfo->Usart->CR2 = loc_pstrConfig->StopBits;
+                loc_pstrInfo->Usart->CR3 = CR3_DMAT_MASK;
+                loc_pstrInfo->Usart->BRR = loc_u32Brr;
+
+                USART_strChannelState[loc_pstrConfig->Channel].BaudRate = loc_pstrConfig->BaudRate;
+                USART_strChannelState[loc_pstrConfig->Channel].RxTail = ZERO;
+                USART_strChannelState[loc_pstrConfig->Channel].RxHead = ZERO;
+                USART_strChannelState[loc_pstrConfig->Channel].RxAvailable = ZERO;
+                USART_strChannelState[loc_pstrConfig->Channel].RxLost = ZERO;
+                USART_strChannelState[loc_pstrConfig->Channel].TxHead = NULL;
+                USART_strChannelState[loc_pstrConfig->Channel].TxTail = NULL;
+
+                loc_strDmaConfig.Direction = DMA_MEM_TO_PERIPH;
+                loc_strDmaConfig.Mode = DMA_MODE_MEM_INC;
+                loc_strDmaConfig.Events = DMA_EVENT_COMPLETE | DMA_EVENT_ERROR;
+                DMA_enuConfigure(loc_pstrInfo->TxStream, &loc_strDmaConfig);
+
+                if(NULL != loc_pstrConfig->RxBuffer)
+                {
+                    loc_strDmaConfig.Direction = DMA_PERIPH_TO_MEM;
+                    loc_strDmaConfig.Mode = DMA_MODE_MEM_INC | DMA_MODE_CIRCULAR;
+                    loc_strDmaConfig.Events = DMA_EVENT_HALF | DMA_EVENT_COMPLETE;
+                    DMA_enuConfigure(loc_pstrInfo->RxStream, &loc_strDmaConfig);
+                    DMA_enuStart(loc_pstrInfo->RxStream, (u32)&loc_pstrInfo->Usart->DR,
+                                 (u32)loc_pstrConfig->RxBuffer, loc_pstrConfig->RxBufferSize);
+
+                    loc_pstrInfo->Usart->CR3 |= CR3_DMAR_MASK;
+                    loc_pstrInfo->Usart->CR1  = CR1_RE_MASK | CR1_IDLEIE_MASK;
+                }
+                else
+                {
+                    /* Do Nothing */
+                }
+
+                loc_pstrInfo->Usart->CR1 |= loc_pstrConfig->WordLength | loc_pstrConfig->Parity
+                                         | loc_pstrConfig->Oversampling | CR1_TE_MASK | CR1_UE_MASK;
+
+                USART_strChannelState[loc_pstrConfig->Channel].Config = loc_pstrConfig;
+            }
+        }
+    }
+
+    /* The baud rates follow the bus clocks (subscribing twice is rejected by RCC) */
+    RCC_enuSubscribeClkChange(&loc_strClkSubscriber);
+
+    return loc_enuErrorStatus;
+}
+
+/**
+ * @brief Changes the baud rate of an initialized channel
+ *
+ * @param[in] Copy_enuChannel	: the channel (USART_enuUsart1 / USART_enuUsart2 / USART_enuUsart6)
+ * @param[in] Copy_u32BaudRate	: the baud rate in bit/s
+ *
+ * @return STD_enuErrorStatus_t : STD_enuOk 			 : Successful Operation
+ * 								  STD_enuInvalidValue	 : Invalid channel / baud rate out of the bus clock range
+ * 								  STD_enuInvalidState	 : The channel is not initialized
+ */
+STD_enuErrorStatus_t USART_enuSetBaudRate(USART_enuChannel_t Copy_enuChannel, u32 Copy_u32BaudRate)
+{
+    STD_enuErrorStatus_t loc_enuErrorStatus = STD_enuOk;
+    u32 loc_u32Brr = ZERO;
+
+    if(Copy_enuChannel >= USART_CHANNELS)
+    {
+        loc_enuErrorStatus = STD_enuInvalidValue;
+    }
+    else if(NULL == USART_strChannelState[Copy_enuChannel].Config)
+    {
+        loc_enuErrorStatus = STD_enuInvalidState;
+    }
+    else if(STD_enuOk != compute_brr(get_pclk_hz(Copy_enuChannel, NULL), Copy_u32BaudRate,
+                                     USART_strChannelState[Copy_enuChannel].Config->Oversampling, &loc_u32Brr))
+    {
+        loc_enuErrorStatus = STD_enuInvalidValue;
+    }
+    else
+    {
+        USART_strChannelState[Copy_enuChannel].BaudRate = Copy_u32BaudRate;
+        USART_strChannelInfo[Copy_enuChannel].Usart->BRR = loc_u32Brr;
+    }
+
+    return loc_enuErrorStatus;
+}
+
+/**
+ * @brief Queues a transmission request, its segments are sent by the DMA after the
+ *        requests already queued on the channel (the call does not wait)
+ *
+ * @param[in] Copy_enuChannel	: the channel
+ * @param[in] Add_pstrRequest	: the request (Segments/SegmentCount/Callback set)
+ *
+ * @return STD_enuErrorStatus_t : STD_enuOk 		  : Successful Operation
+ * 								  STD_enuNullPtr	  : Add_pstrRequest or a segment data is a NULL pointer
+ * 								  STD_enuInvalidValue : Invalid channel / no segments / empty or too long (> 65535) segment
+ * 								  STD_enuInvalidState : The channel is not initialized / the request is still queued
+ */
+STD_enuErrorStatus_t USART_enuSend(USART_enuChannel_t Copy_enuChannel, USART_strTxRequest_t* Add_pstrRequest)
+{
+    STD_enuErrorStatus_t loc_enuErrorStatus = STD_enuOk;
+    USART_strChannelState_t* loc_pstrState = NULL;
+    u32 loc_u32Primask = ZERO;
+    u8 loc_u8Iterator = ZERO;
+
+    if((NULL == Add_pstrRequest) || (NULL == Add_pstrRequest->Segments))
+    {
+        loc_enuErrorStatus = STD_enuNullPtr;
+    }
+    else if((Copy_enuChannel >= USART_CHANNELS) || (ZERO == Add_pstrRequest->SegmentCount))
+    {
+        loc_enuErrorStatus = STD_enuInvalidValue;
+    }
+    else if(NULL == USART_strChannelState[Copy_enuChannel].Config)
+    {
+        loc_enuErrorStatus = STD_enuInvalidState;
+    }
+    else
+    {
+        for(loc_u8Iterator = ZERO; (loc_u8Iterator < Add_pstrRequest->SegmentCount) && (STD_enuOk == loc_enuErrorStatus); loc_u8Iterator++)
+        {
+            if(NULL == Add_pstrRequest->Segments[loc_u8Iterator].Data)
+            {
+                loc_enuErrorStatus = STD_enuNullPtr;
+            }
+            else if((ZERO == Add_pstrRequest->Segments[loc_u8Iterator].Length)
+                 || (Add_pstrRequest->Segments[loc_u8Iterator].Length > DMA_MAX_COUNT))
+            {
+                loc_enuErrorStatus = STD_enuInvalidValue;
+            }
+            else
+            {
+                /* Do Nothing */
+            }
+        }
+
+        if(STD_enuOk == loc_enuErrorStatus)
+        {
+            loc_pstrState = &USART_strChannelState[Copy_enuChannel];
+
+            ENTER_CRITICAL(loc_u32Primask);
+
+            if(USART_enuTxIdle != Add_pstrRequest->State)
+            {
+                loc_enuErrorStatus = STD_enuInvalidState;
+            }
+            else
+            {
+                Add_pstrRequest->State = USART_enuTxQueued;
+                Add_pstrRequest->Segment = ZERO;
+                Add_pstrRequest->Next = NULL;
+
+                if(NULL == loc_pstrState->TxHead)
+                {
+                    loc_pstrState->TxHead = Add_pstrRequest;
+                    loc_pstrState->TxTail = Add_pstrRequest;
+                    start_tx(Copy_enuChannel);
+                }
+                else
+                {
+                    loc_pstrState->TxTail->Next = Add_pstrRequest;
+                    loc_pstrState->TxTail = Add_pstrRequest;
+                }
+            }
+
+            EXIT_CRITICAL(loc_u32Primask);
+        }
+        else
+        {
+            /* Do Nothing */
+        }
+    }
+
+    return loc_enuErrorStatus;
+}
+
+/**
+ * @brief Returns the received bytes that are stored contiguously in the reception buffer
+ *        (zero-copy read, the bytes stay there until USART_enuConsume)
+ *
+ * @param[in]  Copy_enuChannel	: the channel
+ * @param[out] Add_ppu8Data		: address of the first unread byte
+ * @param[out] Add_pu16Length	: number of unread bytes from there
+ *
+ * @return STD_enuErrorStatus_t : STD_enuOk 		  : Successful Operation
+ * 								  STD_enuNullPtr	  : Add_ppu8Data or Add_pu16Length is a NULL pointer
+ * 								  STD_enuInvalidValue : Invalid channel
+ * 								  STD_enuInvalidState : The channel is not initialized
+ */
+STD_enuErrorStatus_t USART_enuPeek(USART_enuChannel_t Copy_enuChannel, const u8** Add_ppu8Data, u16* Add_pu16Length)
+{
+    STD_enuErrorStatus_t loc_enuErrorStatus = STD_enuOk;
+    USART_strChannelState_t* loc_pstrState = NULL;
+    u32 loc_u32Primask = ZERO;
+    u16 loc_u16ToEnd = ZERO;
+
+    if((NULL == Add_ppu8Data) || (NULL == Add_pu16Length))
+    {
+        loc_enuErrorStatus = STD_enuNullPtr;
+    }
+    else if(Copy_enuChannel >= USART_CHANNELS)
+    {
+        loc_enuErrorStatus = STD_enuInvalidValue;
+    }
+    else if((NULL == USART_strChannelState[Copy_enuChannel].Config)
+         || (NULL == USART_strChannelState[Copy_enuChannel].Config->RxBuffer))
+    {
+        loc_enuErrorStatus = STD_enuInvalidState;
+    }
+    else
+    {
+        loc_pstrState = &USART_strChannelState[Copy_enuChannel];
+
+        ENTER_CRITICAL(loc_u32Primask);
+
+        update_rx(Copy_enuChannel);
+
+        loc_u16ToEnd = loc_pstrState->Config->RxBufferSize - loc_pstrState->RxTail;
+        *Add_ppu8Data = &loc_pstrState->Config->RxBuffer[loc_pstrState->RxTail];
+        *Add_pu16Length = (loc_pstrState->RxAvailable < loc_u16ToEnd) ? loc_pstrState->RxAvailable : loc_u16ToEnd;
+
+        EXIT_CRITICAL(loc_u32Primask);
+    }
+
+    return loc_enuErrorStatus;
+}
+
+/**
+ * @brief Releases bytes returned by USART_enuPeek
+ *
+ * @param[in] Copy_enuChannel	: the channel
+ * @param[in] Copy_u16Length	: number of bytes read
+ *
+ * @return STD_enuErrorStatus_t : STD_enuOk 		  : Successful Operation
+ * 								  STD_enuInvalidValue : Invalid channel / more bytes than received
+ * 								  STD_enuInvalidState : The channel is not initialized
+ */
+STD_enuErrorStatus_t USART_enuConsume(USART_enuChannel_t Copy_enuChannel, u16 Copy_u16Length)
+{
+    STD_enuErrorStatus_t loc_enuErrorStatus = STD_enuOk;
+    USART_strChannelState_t* loc_pstrState = NULL;
+    u32 loc_u32Primask = ZERO;
+
+    if(Copy_enuChannel >= USART_CHANNELS)
+    {
+        loc_enuErrorStatus = STD_enuInvalidValue;
+    }
+    else if((NULL == USART_strChannelState[Copy_enuChannel].Config)
+         || (NULL == USART_strChannelState[Copy_enuChannel].Config->RxBuffer))
+    {
+        loc_enuErrorStatus = STD_enuInvalidState;
+    }
+    else
+    {
+        loc_pstrState = &USART_strChannelState[Copy_enuChannel];
+
+        ENTER_CRITICAL(loc_u32Primask);
+
+        /* Bytes overwritten since the peek are already out of RxAvailable */
+        if(Copy_u16Length > loc_pstrState->RxAvailable)
+        {
+            loc_enuErrorStatus = STD_enuInvalidValue;
+        }
+        else
+        {
+            loc_pstrState->RxTail = (u16)((loc_pstrState->RxTail + Copy_u16Length) % loc_pstrState->Config->RxBufferSize);
+            loc_pstrState->RxAvailable -= Copy_u16Length;
+        }
+
+        EXIT_CRITICAL(loc_u32Primask);
+    }
+
+    return loc_enuErrorStatus;
+}
+
+/**
+ * @brief Copies the received bytes (up to Copy_u16Size) and releases them
+ *
+ * @param[in]  Copy_enuChannel	: the channel
+ * @param[out] Add_pu8Data		: the destination buffer
+ * @param[in]  Copy_u16Size		: size of the destination buffer
+ * @param[out] Add_pu16Read		: number of bytes copied
+ *
+ * @return STD_enuErrorStatus_t : STD_enuOk 		  : Successful Operation
+ * 								  STD_enuNullPtr	  : Add_pu8Data or Add_pu16Read is a NULL pointer
+ * 								  STD_enuInvalidValue : Invalid channel
+ * 								  STD_enuInvalidState : The channel is not initialized
+ */
+STD_enuErrorStatus_t USART_enuRead(USART_enuChannel_t Copy_enuChannel, u8* Add_pu8Data, u16 Copy_u16Size, u16* Add_pu16Read)
+{
+    STD_enuErrorStatus_t loc_enuErrorStatus = STD_enuOk;
+    const u8* loc_pu8Chunk = NULL;
+    u16 loc_u16Length = ZERO;
+    u16 loc_u16Iterator = ZERO;
+
+    if((NULL == Add_pu8Data) || (NULL == Add_pu16Read))
+    {
+        loc_enuErrorStatus = STD_enuNullPtr;
+    }
+    else
+    {
+        *Add_pu16Read = ZERO;
+
+        /* At most two chunks: up to the end of the buffer then from its start */
+        do
+        {
+            loc_enuErrorStatus = USART_enuPeek(Copy_enuChannel, &loc_pu8Chunk, &loc_u16Length);
+
+            if(STD_enuOk == loc_enuErrorStatus)
+            {
+                if(loc_u16Length > (Copy_u16Size - *Add_pu16Read))
+                {
+                    loc_u16Length = Copy_u16Size - *Add_pu16Read;
+                }
+                else
+                {
+                    /* Do Nothing */
+                }
+
+                for(loc_u16Iterator = ZERO; loc_u16Iterator < loc_u16Length; loc_u16Iterator++)
+                {
+                    Add_pu8Data[*Add_pu16Read + loc_u16Iterator] = loc_pu8Chunk[loc_u16Iterator];
+                }
+
+                *Add_pu16Read += loc_u16Length;
+                loc_enuErrorStatus = USART_enuConsume(Copy_enuChannel, loc_u16Length);
+            }
+            else
+            {
+                /* Do Nothing */
+            }
+        } while((STD_enuOk == loc_enuErrorStatus) && (ZERO != loc_u16Length) && (*Add_pu16Read < Copy_u16Size));
+    }
+
+    return loc_enuErrorStatus;
+}
+
+/**
+ * @brief Returns the number of received bytes overwritten before being read
+ *
+ * @param[in] Copy_enuChannel	: the channel
+ *
+ * @return u32 : the lost bytes since USART_Init (0 for an invalid channel)
+ */
+u32 USART_u32GetRxLost(USART_enuChannel_t Copy_enuChannel)
+{
+    return (Copy_enuChannel < USART_CHANNELS) ? USART_strChannelState[Copy_enuChannel].RxLost : ZERO;
+}
+
+/**
+ * @brief USART interrupts: idle line detection of the DMA reception
+ */
+void USART1_IRQHandler(void)
+{
+    usart_irq(USART_enuUsart1);
+}
+
+void USART2_IRQHandler(void)
+{
+    usart_irq(USART_enuUsart2);
+}
+
+void USART6_IRQHandler(void)
+{
+    usart_irq(USART_enuUsart6);
+}
+
+/*===========================================================================================================*/
+/*										  	 Private Implementations										 */
+/*===========================================================================================================*/
+static STD_enuErrorStatus_t compute_brr(u32 Copy_u32PclkHz, u32 Copy_u32BaudRate, u32 Copy_u32Oversampling, u32* Add_pu32Brr)
+{
+    STD_enuErrorStatus_t loc_enuErrorStatus = STD_enuOk;
+    u32 loc_u32Div = ZERO;
+
+    if(ZERO == Copy_u32BaudRate)
+    {
+        loc_enuErrorStatus = STD_enuInvalidValue;
+    }
+    else if(USART_OVERSAMPLING_16 == Copy_u32Oversampling)
+    {
+        /* BRR = USARTDIV x 16 = PCLK / baud (rounded) */
+        loc_u32Div = (Copy_u32PclkHz + (Copy_u32BaudRate / 2)) / Copy_u32BaudRate;
+
+        if((loc_u32Div < BRR_MIN_DIV16) || (loc_u32Div > BRR_MAX_DIV16))
+        {
+            loc_enuErrorStatus = STD_enuInvalidValue;
+        }
+        else
+        {
+            *Add_pu32Brr = loc_u32Div;
+        }
+    }
+    else if(USART_OVERSAMPLING_8 == Copy_u32Oversampling)
+    {
+        /* USARTDIV x 8: the 3 fraction bits stay right aligned in BRR[3:0] */
+        loc_u32Div = (Copy_u32PclkHz + (Copy_u32BaudRate / 2)) / Copy_u32BaudRate;
+
+        if((loc_u32Div < BRR_MIN_DIV8) || (loc_u32Div > BRR_MAX_DIV8))
+        {
+            loc_enuErrorStatus = STD_enuInvalidValue;
+        }
+        else
+        {
+            *Add_pu32Brr = ((loc_u32Div >> 3) << BRR_FRACTION_BITS) | (loc_u32Div & 0x7);
+        }
+    }
+    else
+    {
+        loc_enuErrorStatus = STD_enuInvalidValue;
+    }
+
+    return loc_enuErrorStatus;
+}
+
+static u32 get_pclk_hz(USART_enuChannel_t Copy_enuChannel, const RCC_strClkTree_t* Add_pstrTree)
+{
+    u32 loc_u32PclkHz = ZERO;
+
+    if(USART_enuUsart2 == Copy_enuChannel)
+    {
+        loc_u32PclkHz = (NULL != Add_pstrTree) ? Add_pstrTree->Pclk1Hz : RCC_u32GetPclk1Hz();
+    }
+    else
+    {
+        loc_u32PclkHz = (NULL != Add_pstrTree) ? Add_pstrTree->Pclk2Hz : RCC_u32GetPclk2Hz();
+    }
+
+    return loc_u32PclkHz;
+}
+
+static void clk_change(RCC_enuClkChangePhase_t Copy_enuPhase, const RCC_strClkTree_t* Add_pstrClkTree)
+{
+    u32 loc_u32Brr = ZERO;
+    u8 loc_u8Channel = ZERO;
+
+    if(RCC_enuClkPostChange == Copy_enuPhase)
+    {
+        for(loc_u8Channel = ZERO; loc_u8Channel < USART_CHANNELS; loc_u8Channel++)
+        {
+            /* A baud rate the new clock can't generate keeps the old divider */
+            if((NULL != USART_strChannelState[loc_u8Channel].Config)
+            && (STD_enuOk == compute_brr(get_pclk_hz((USART_enuChannel_t)loc_u8Channel, Add_pstrClkTree),
+                                         USART_strChannelState[loc_u8Channel].BaudRate,
+                                         USART_strChannelState[loc_u8Channel].Config->Oversampling, &loc_u32Brr)))
+            {
+                USART_strChannelInfo[loc_u8Channel].Usart->BRR = loc_u32Brr;
+            }
+            else
+            {
+                /* Do Nothing */
+            }
+        }
+    }
+    else
+    {
+        /* Do Nothing */
+    }
+}
+
+static void update_rx(USART_enuChannel_t Copy_enuChannel)
+{
+    USART_strChannelState_t* loc_pstrState = &USART_strChannelState[Copy_enuChannel];
+    u16 loc_u16Size = loc_pstrState->Config->RxBufferSize;
+    u16 loc_u16Head = ZERO;
+    u16 loc_u16New = ZERO;
+
+    /* NDTR counts down to 0 then reloads the buffer size */
+    loc_u16Head = loc_u16Size - DMA_u16GetRemaining(USART_strChannelInfo[Copy_enuChannel].RxStream);
+    if(loc_u16Head >= loc_u16Size)
+    {
+        loc_u16Head = ZERO;
+    }
+    else
+    {
+        /* Do Nothing */
+    }
+
+    /* The half/full buffer interrupts bound the progress between two updates to less than a lap */
+    loc_u16New = (u16)((loc_u16Head + loc_u16Size - loc_pstrState->RxHead) % loc_u16Size);
+    loc_pstrState->RxHead = loc_u16Head;
+
+    if((u32)loc_pstrState->RxAvailable + loc_u16New > loc_u16Size)
+    {
+        /* The oldest bytes were overwritten: the unread data starts at the write position */
+        loc_pstrState->RxLost += (u32)loc_pstrState->RxAvailable + loc_u16New - loc_u16Size;
+        loc_pstrState->RxAvailable = loc_u16Size;
+        loc_pstrState->RxTail = loc_u16Head;
+    }
+    else
+    {
+        loc_pstrState->RxAvailable += loc_u16New;
+    }
+}
+
+static void rx_event(USART_enuChannel_t Copy_enuChannel)
+{
+    const USART_strConfig_t* loc_pstrConfig = USART_strChannelState[Copy_enuChannel].Config;
+
+    if((NULL != loc_pstrConfig) && (NULL != loc_pstrConfig->RxBuffer))
+    {
+        update_rx(Copy_enuChannel);
+
+        if((NULL != loc_pstrConfig->RxCallback) && (ZERO != USART_strChannelState[Copy_enuChannel].RxAvailable))
+        {
+            loc_pstrConfig->RxCallback(Copy_enuChannel, USART_strChannelState[Copy_enuChannel].RxAvailable);
+        }
+        else
+        {
+            /* Do Nothing */
+        }
+    }
+    else
+    {
+        /* Do Nothing */
+    }
+}
+
+static void start_tx(USART_enuChannel_t Copy_enuChannel)
+{
+    const USART_strChannelInfo_t* loc_pstrInfo = &USART_strChannelInfo[Copy_enuChannel];
+    USART_strTxRequest_t* loc_pstrRequest = USART_strChannelState[Copy_enuChannel].TxHead;
+    const USART_strTxSegment_t* loc_pstrSegment = &loc_pstrRequest->Segments[loc_pstrRequest->Segment];
+
+    loc_pstrRequest->State = USART_enuTxSending;
+
+    loc_pstrInfo->Usart->SR = ~SR_TC_MASK;
+    DMA_enuStart(loc_pstrInfo->TxStream, (u32)&loc_pstrInfo->Usart->DR, (u32)loc_pstrSegment->Data, loc_pstrSegment->Length);
+}
+
+static void tx_event(USART_enuChannel_t Copy_enuChannel, u8 Copy_u8Events)
+{
+    USART_strChannelState_t* loc_pstrState = &USART_strChannelState[Copy_enuChannel];
+    USART_strTxRequest_t* loc_pstrRequest = loc_pstrState->TxHead;
+
+    if(NULL != loc_pstrRequest)
+    {
+        loc_pstrRequest->Segment++;
+
+        /* A transfer error drops the rest of the request */
+        if((ZERO == (Copy_u8Events & DMA_EVENT_ERROR)) && (loc_pstrRequest->Segment < loc_pstrRequest->SegmentCount))
+        {
+            start_tx(Copy_enuChannel);
+        }
+        else
+        {
+            /* The next request starts before the callback, which may queue this one again */
+            loc_pstrState->TxHead = loc_pstrRequest->Next;
+            loc_pstrRequest->State = USART_enuTxIdle;
+
+            if(NULL != loc_pstrState->TxHead)
+            {
+                start_tx(Copy_enuChannel);
+            }
+            else
+            {
+                loc_pstrState->TxTail = NULL;
+            }
+
+            if(NULL != loc_pstrRequest->Callback)
+            {
+                loc_pstrRequest->Callback(Copy_enuChannel, loc_pstrRequest);
+            }
+            else
+            {
+                /* Do Nothing */
+            }
+        }
+    }
+    else
+    {
+        /* Do Nothing */
+    }
+}
+
+static void usart_irq(USART_enuChannel_t Copy_enuChannel)
+{
+    volatile USART_t* loc_pstrUsart = USART_strChannelInfo[Copy_enuChannel].Usart;
+    volatile u32 loc_u32Dummy = ZERO;
+
+    if(loc_pstrUsart->SR & SR_IDLE_MASK)
+    {
+        /* IDLE is cleared by reading SR then DR */
+        loc_u32Dummy = loc_pstrUsart->DR;
+        (void)loc_u32Dummy;
+
+        rx_event(Copy_enuChannel);
+    }
+    else
+    {
+        /* Do Nothing */
+    }
+}
+
+static void dma_event(DMA_enuStream_t Copy_enuStream, u8 Copy_u8Events)
+{
+    u8 loc_u8Channel = ZERO;
+
+    for(loc_u8Channel = ZERO; loc_u8Channel < USART_CHANNELS; loc_u8Channel++)
+    {
+        if(NULL == USART_strChannelState[loc_u8Channel].Config)
+        {
+            /* Do Nothing */
+        }
+        else if(Copy_enuStream == USART_strChannelInfo[loc_u8Channel].RxStream)
+        {
+            rx_event((USART_enuChannel_t)loc_u8Channel);
+        }
+        else if(Copy_enuStream == USART_strChannelInfo[loc_u8Channel].TxStream)
+        {
+            tx_event((USART_enuChannel_t)loc_u8Channel, Copy_u8Events);
+        }
+        else
+        {
+            /* Do Nothing */
+        }
+    }
+}
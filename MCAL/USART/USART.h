@@ -0,0 +1,197 @@
+/*
+ * @file  : USART.h
+ * @brief : user interface for the USART peripherals (DMA circular reception & queued DMA transmission)
+ * @author: Alaa Hisham
+ * @date  : 25-03-2024
+ */
+
+#ifndef USART_H_
+#define USART_H_
+
+/*===========================================================================================================*/
+/*												    Includes	 										     */
+/*===========================================================================================================*/
+#include "STD_TYPES.h"
+
+/*===========================================================================================================*/
+/*												     Macros		 										     */
+/*===========================================================================================================*/
+/**
+ * Word length options (9 bits needs a parity: the DMA moves bytes so a 9th data bit would be lost)
+ */
+#define USART_WORD_8BITS		0x00000000
+#define USART_WORD_9BITS		0x00001000
+
+/**
+ * Parity options (the parity bit takes the MSB of the word)
+ */
+#define USART_PARITY_NONE		0x00000000
+#define USART_PARITY_EVEN		0x00000400
+#define USART_PARITY_ODD		0x00000600
+
+/**
+ * Stop bits options
+ */
+#define USART_STOP_1BIT			0x00000000
+#define USART_STOP_2BITS		0x00002000
+
+/**
+ * Oversampling options (8 reaches twice the baud rate for the same bus clock)
+ */
+#define USART_OVERSAMPLING_16	0x00000000
+#define USART_OVERSAMPLING_8	0x00008000
+
+#define USART_CHANNELS			3
+
+/*===========================================================================================================*/
+/*												     Types		 										     */
+/*===========================================================================================================*/
+typedef enum
+{
+	USART_enuUsart1	,	/* APB2, DMA2 stream 2 (RX) / stream 7 (TX) channel 4 */
+	USART_enuUsart2	,	/* APB1, DMA1 stream 5 (RX) / stream 6 (TX) channel 4 */
+	USART_enuUsart6		/* APB2, DMA2 stream 1 (RX) / stream 6 (TX) channel 5 */
+}USART_enuChannel_t;
+
+typedef enum
+{
+	USART_enuTxIdle		,	/* Never queued or completed */
+	USART_enuTxQueued	,	/* Waiting for the previous requests */
+	USART_enuTxSending		/* Being sent by the DMA */
+}USART_enuTxState_t;
+
+/**
+ * Reception callback: called from interrupt context when the line goes idle and every
+ * half of the reception buffer, with the number of bytes waiting to be read
+ */
+typedef void (*USART_RxCBF_t)(USART_enuChannel_t Copy_enuChannel, u16 Copy_u16Available);
+
+struct USART_strTxRequest;
+
+/* Transmission callback: called from interrupt context once the request buffers can be reused */
+typedef void (*USART_TxCBF_t)(USART_enuChannel_t Copy_enuChannel, struct USART_strTxRequest* Add_pstrRequest);
+
+/* One buffer of a transmission request */
+typedef struct
+{
+	const u8* Data;
+	u16 Length;
+}USART_strTxSegment_t;
+
+/**
+ * Transmission request (statically allocated by the sender)
+ * The segments are sent back to back by the DMA without being copied: the request,
+ * its segments array and the data must stay untouched until the request completes.
+ */
+typedef struct USART_strTxRequest
+{
+	const USART_strTxSegment_t* Segments;
+	u8 SegmentCount;
+	USART_TxCBF_t Callback;						/* Can be NULL */
+	volatile USART_enuTxState_t State;			/* Managed by USART */
+	u8 Segment;									/* Managed by USART: the segment being sent */
+	struct USART_strTxRequest* Next;			/* Managed by USART */
+}USART_strTxRequest_t;
+
+/*===========================================================================================================*/
+/*											 Function Prototypes											 */
+/*===========================================================================================================*/
+
+/**
+ * @brief Initializes the channels configured in USART_cfg.c: clocks, frame format, baud rate
+ *        and the circular DMA reception
+ *
+ * The baud rate follows the bus clock (it is recomputed after every system clock change).
+ * The TX/RX pins are set to their alternate function by the application (AF7 for
+ * USART1/USART2, AF8 for USART6), the USARTx_IRQn and the DMA stream interrupts of the
+ * used channels must be enabled in NVIC_cfg.c (a channel's interrupts at the same priority).
+ * The DMA streams are reserved through DMA.h and can't be used by another driver.
+ *
+ * @return STD_enuErrorStatus_t : STD_enuOk 			 : Successful Operation
+ * 								  STD_enuInvalidConfig	 : Invalid channel configuration (channel left disabled)
+ * 								  STD_enuOperationFailed : A peripheral clock or a DMA stream could not be reserved
+ */
+STD_enuErrorStatus_t USART_Init(void);
+
+/**
+ * @brief Changes the baud rate of an initialized channel
+ *
+ * @param[in] Copy_enuChannel	: the channel (USART_enuUsart1 / USART_enuUsart2 / USART_enuUsart6)
+ * @param[in] Copy_u32BaudRate	: the baud rate in bit/s
+ *
+ * @return STD_enuErrorStatus_t : STD_enuOk 			 : Successful Operation
+ * 								  STD_enuInvalidValue	 : Invalid channel / baud rate out of the bus clock range
+ * 								  STD_enuInvalidState	 : The channel is not initialized
+ */
+STD_enuErrorStatus_t USART_enuSetBaudRate(USART_enuChannel_t Copy_enuChannel, u32 Copy_u32BaudRate);
+
+/**
+ * @brief Queues a transmission request, its segments are sent by the DMA after the
+ *        requests already queued on the channel (the call does not wait)
+ *
+ * @param[in] Copy_enuChannel	: the channel
+ * @param[in] Add_pstrRequest	: the request (Segments/SegmentCount/Callback set)
+ *
+ * @return STD_enuErrorStatus_t : STD_enuOk 		  : Successful Operation
+ * 								  STD_enuNullPtr	  : Add_pstrRequest or a segment data is a NULL pointer
+ * 								  STD_enuInvalidValue : Invalid channel / no segments / empty or too long (> 65535) segment
+ * 								  STD_enuInvalidState : The channel is not initialized / the request is still queued
+ */
+STD_enuErrorStatus_t USART_enuSend(USART_enuChannel_t Copy_enuChannel, USART_strTxRequest_t* Add_pstrRequest);
+
+/**
+ * @brief Returns the received bytes that are stored contiguously in the reception buffer
+ *        (zero-copy read, the bytes stay there until USART_enuConsume)
+ *
+ * A wrapped reception returns the bytes up to the end of the buffer, the rest follows
+ * after consuming them.
+ *
+ * @param[in]  Copy_enuChannel	: the channel
+ * @param[out] Add_ppu8Data		: address of the first unread byte
+ * @param[out] Add_pu16Length	: number of unread bytes from there
+ *
+ * @return STD_enuErrorStatus_t : STD_enuOk 		  : Successful Operation
+ * 								  STD_enuNullPtr	  : Add_ppu8Data or Add_pu16Length is a NULL pointer
+ * 								  STD_enuInvalidValue : Invalid channel
+ * 								  STD_enuInvalidState : The channel is not initialized
+ */
+STD_enuErrorStatus_t USART_enuPeek(USART_enuChannel_t Copy_enuChannel, const u8** Add_ppu8Data, u16* Add_pu16Length);
+
+/**
+ * @brief Releases bytes returned by USART_enuPeek
+ *
+ * @param[in] Copy_enuChannel	: the channel
+ * @param[in] Copy_u16Length	: number of bytes read
+ *
+ * @return STD_enuErrorStatus_t : STD_enuOk 		  : Successful Operation
+ * 								  STD_enuInvalidValue : Invalid channel / more bytes than received
+ * 								  STD_enuInvalidState : The channel is not initialized
+ */
+STD_enuErrorStatus_t USART_enuConsume(USART_enuChannel_t Copy_enuChannel, u16 Copy_u16Length);
+
+/**
+ * @brief Copies the received bytes (up to Copy_u16Size) and releases them
+ *
+ * @param[in]  Copy_enuChannel	: the channel
+ * @param[out] Add_pu8Data		: the destination buffer
+ * @param[in]  Copy_u16Size		: size of the destination buffer
+ * @param[out] Add_pu16Read		: number of bytes copied
+ *
+ * @return STD_enuErrorStatus_t : STD_enuOk 		  : Successful Operation
+ * 								  STD_enuNullPtr	  : Add_pu8Data or Add_pu16Read is a NULL pointer
+ * 								  STD_enuInvalidValue : Invalid channel
+ * 								  STD_enuInvalidState : The channel is not initialized
+ */
+STD_enuErrorStatus_t USART_enuRead(USART_enuChannel_t Copy_enuChannel, u8* Add_pu8Data, u16 Copy_u16Size, u16* Add_pu16Read);
+
+/**
+ * @brief Returns the number of received bytes overwritten before being read
+ *        (the reception buffer was not read for longer than it takes to fill it)
+ *
+ * @param[in] Copy_enuChannel	: the channel
+ *
+ * @return u32 : the lost bytes since USART_Init (0 for an invalid channel)
+ */
+u32 USART_u32GetRxLost(USART_enuChannel_t Copy_enuChannel);
+
+#endif /* USART_H_ */
@@ -0,0 +1,50 @@
+/*
+ * @file  : USART_cfg.c
+ * @brief : USART post-compile configurations (channels table)
+ * @author: Alaa Hisham
+ * @date  : 25-03-2024
+ */
+/*===========================================================================================================*/
+/*												    Includes		 										 */
+/*===========================================================================================================*/
+#include "STD_TYPES.h"
+
+#include "USART.h"
+#include "USART_cfg.h"
+
+/*===========================================================================================================*/
+/*								 	 		  Reception Buffers												 */
+/*===========================================================================================================*/
+static u8 USART_u8TelemetryRxBuffer[USART_CFG_RX_BUFFER_SIZE];
+static u8 USART_u8ConsoleRxBuffer[USART_CFG_RX_BUFFER_SIZE];
+
+/*===========================================================================================================*/
+/*								 	 		  Channels Configuration										 */
+/*===========================================================================================================*/
+const USART_strConfig_t USART_strConfigArr[NUMBER_OF_CFG_USARTS] =
+{
+	/* Telemetry link */
+	{
+		.Channel      = USART_enuUsart1					,
+		.BaudRate     = 921600UL						,
+		.WordLength   = USART_WORD_8BITS				,
+		.Parity       = USART_PARITY_NONE				,
+		.StopBits     = USART_STOP_1BIT					,
+		.Oversampling = USART_OVERSAMPLING_16			,
+		.RxBuffer     = USART_u8TelemetryRxBuffer		,
+		.RxBufferSize = USART_CFG_RX_BUFFER_SIZE		,
+		.RxCallback   = NULL
+	},
+	/* Console (ST-LINK virtual COM port) */
+	{
+		.Channel      = USART_enuUsart2					,
+		.BaudRate     = 115200UL						,
+		.WordLength   = USART_WORD_8BITS				,
+		.Parity       = USART_PARITY_NONE				,
+		.StopBits     = USART_STOP_1BIT					,
+		.Oversampling = USART_OVERSAMPLING_16			,
+		.RxBuffer     = USART_u8ConsoleRxBuffer			,
+		.RxBufferSize = USART_CFG_RX_BUFFER_SIZE		,
+		.RxCallback   = NULL
+	}
+};
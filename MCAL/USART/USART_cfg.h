@@ -0,0 +1,78 @@
+/*
+ * @file  : USART_cfg.h
+ * @brief : pre-compile configurations for the USART peripherals
+ * @author: Alaa Hisham
+ * @date  : 25-03-2024
+ */
+
+#ifndef USART_CFG_H_
+#define USART_CFG_H_
+
+/*===========================================================================================================*/
+/*												    Includes	 										     */
+/*===========================================================================================================*/
+#include "STD_TYPES.h"
+#include "USART.h"
+
+/*===========================================================================================================*/
+/*												     Macros		 										     */
+/*===========================================================================================================*/
+/**
+ * @brief The number of channels configured in USART_cfg.c
+ */
+#define NUMBER_OF_CFG_USARTS		2
+
+/**
+ * @brief Size of the reception buffers defined in USART_cfg.c
+ *        (holds the bytes received while the application is busy: at 921600 bit/s
+ *        1 KB lasts about 11 ms)
+ */
+#define USART_CFG_RX_BUFFER_SIZE	1024
+
+/*===========================================================================================================*/
+/*												     Types		 										     */
+/*===========================================================================================================*/
+typedef struct
+{
+	/**
+	 * The USART peripheral
+	 * Options: USART_enuUsart1, USART_enuUsart2, USART_enuUsart6
+	 */
+	USART_enuChannel_t Channel;
+
+	/**
+	 * The baud rate in bit/s
+	 * Range: [PCLK / 65536 - PCLK / 16] (PCLK / 8 with USART_OVERSAMPLING_8)
+	 */
+	u32 BaudRate;
+
+	/**
+	 * The frame format
+	 * Options: USART_WORD_8BITS / USART_WORD_9BITS, USART_PARITY_NONE / EVEN / ODD,
+	 *          USART_STOP_1BIT / USART_STOP_2BITS
+	 *          (USART_WORD_9BITS with USART_PARITY_NONE is rejected: 9 data bits don't fit the byte DMA)
+	 */
+	u32 WordLength;
+	u32 Parity;
+	u32 StopBits;
+
+	/**
+	 * The receiver oversampling
+	 * Options: USART_OVERSAMPLING_16, USART_OVERSAMPLING_8
+	 */
+	u32 Oversampling;
+
+	/**
+	 * The circular reception buffer written by the DMA (NULL: reception disabled)
+	 * Range: RxBufferSize [2 - 65535]
+	 */
+	u8* RxBuffer;
+	u16 RxBufferSize;
+
+	/**
+	 * Called on idle line and every half buffer (can be NULL: the application polls)
+	 */
+	USART_RxCBF_t RxCallback;
+}USART_strConfig_t;
+
+#endif /* USART_CFG_H_ */
@@ -0,0 +1,499 @@
+/*
+ * @file  : DMACPY.c
+ * @brief : API Implementations for the asynchronous memory copy/fill service (DMA2 memory to memory)
+ * @author: Alaa Hisham
+ * @date  : 29-03-2024
+ */
+/*===========================================================================================================*/
+/*												    Includes		 										 */
+/*===========================================================================================================*/
+
+#include "STD_TYPES.h"
+
+#include "DMA.h"
+#include "DMACPY.h"
+#include "DMACPY_cfg.h"
+
+/*===========================================================================================================*/
+/*												     Macros		 										     */
+/*===========================================================================================================*/
+#define WORD_MASK           0x00000003
+#define BURST_MASK          0x0000000F      /* 4 words bursts on 16 bytes aligned buffers */
+#define BURST_WORDS         4
+
+/* Items per transfer: the largest count that keeps whole bursts */
+#define MAX_ITEMS           0xFFF0
+
+/* PRIMASK save/restore around the state shared with the interrupts */
+#define ENTER_CRITICAL(STATE)   __asm volatile ("mrs %0, primask\n\tcpsid i" : "=r" (STATE) : : "memory")
+#define EXIT_CRITICAL(STATE)    __asm volatile ("msr primask, %0" : : "r" (STATE) : "memory")
+
+/*===========================================================================================================*/
+/*												     Types		 										     */
+/*===========================================================================================================*/
+typedef struct
+{
+    DMA_enuStream_t Stream;
+    DMACPY_strRequest_t* Request;       /* NULL while the stream is free */
+} DMACPY_strSlot_t;
+
+/*===========================================================================================================*/
+/*										  	   Global Variables											     */
+/*===========================================================================================================*/
+static DMACPY_strSlot_t DMACPY_strSlots[DMACPY_CFG_STREAM_COUNT];
+
+static DMACPY_strRequest_t* DMACPY_pstrQueueHead = NULL;
+static DMACPY_strRequest_t* DMACPY_pstrQueueTail = NULL;
+
+static u8 DMACPY_u8Initialized = ZERO;
+
+/*===========================================================================================================*/
+/*										  	   Private Functions											 */
+/*===========================================================================================================*/
+/**
+ * @brief Common part of DMACPY_enuCopy / DMACPY_enuFill
+ */
+static STD_enuErrorStatus_t submit(DMACPY_strRequest_t* Add_pstrRequest);
+
+/**
+ * @brief Copies/fills a byte range of a request with the CPU
+ */
+static void cpu_transfer(DMACPY_strRequest_t* Add_pstrRequest, u32 Copy_u32Offset, u32 Copy_u32Size);
+
+/**
+ * @brief Programs the next transfer of the request of a slot (at most MAX_ITEMS items)
+ */
+static STD_enuErrorStatus_t start_chunk(DMACPY_strSlot_t* Add_pstrSlot);
+
+/**
+ * @brief Ends the request of a slot, starts the oldest queued request on the slot
+ *        then calls the callbacks (the queued requests that fail to start are ended too)
+ */
+static void finish_request(DMACPY_strSlot_t* Add_pstrSlot, DMACPY_enuState_t Copy_enuState);
+
+static void dma_event(DMA_enuStream_t Copy_enuStream, u8 Copy_u8Events);
+
+/*===========================================================================================================*/
+/*										  	  API Implementations											 */
+/*===========================================================================================================*/
+/**
+ * @brief Reserves the DMA2 streams listed in DMACPY_cfg.h
+ *
+ * @return STD_enuErrorStatus_t : STD_enuOk 			 : Successful Operation
+ * 								  STD_enuInvalidConfig	 : A configured stream is not a DMA2 stream
+ * 								  STD_enuOperationFailed : A stream is already reserved / the DMA2 clock could not be enabled
+ */
+STD_enuErrorStatus_t DMACPY_Init(void)
+{
+    STD_enuErrorStatus_t loc_enuErrorStatus = STD_enuOk;
+    const DMA_enuStream_t loc_enuStreams[DMACPY_CFG_STREAM_COUNT] = DMACPY_CFG_STREAMS;
+    u8 loc_u8Acquired = ZERO;
+    u8 loc_u8Iterator = ZERO;
+
+    for(loc_u8Iterator = ZERO; (loc_u8Iterator < DMACPY_CFG_STREAM_COUNT) && (STD_enuOk == loc_enuErrorStatus); loc_u8Iterator++)
+    {
+        if((loc_enuStreams[loc_u8Iterator] < DMA_enuDma2Stream0) || (loc_enuStreams[loc_u8Iterator] > DMA_enuDma2Stream7))
+        {
+            loc_enuErrorStatus = STD_enuInvalidConfig;
+        }
+        else if(STD_enuOk != DMA_enuAcquireStream(loc_enuStreams[loc_u8Iterator]))
+        {
+            loc_enuErrorStatus = STD_enuOperationFailed;
+        }
+        else
+        {
+            DMACPY_strSlots[loc_u8Iterator].Stream = loc_enuStreams[loc_u8Iterator];
+            DMACPY_strSlots[loc_u8Iterator].Request = NULL;
+            loc_u8Acquired++;
+        }
+    }
+
+    if(STD_enuOk == loc_enuErrorStatus)
+    {
+        DMACPY_u8Initialized = 1;
+    }
+    else
+    {
+        /* Give back the streams reserved before the failure */
+        for(loc_u8Iterator = ZERO; loc_u8Iterator < loc_u8Acquired; loc_u8Iterator++)
+        {
+            DMA_enuReleaseStream(loc_enuStreams[loc_u8Iterator]);
+        }
+    }
+
+    return loc_enuErrorStatus;
+}
+
+/**
+ * @brief Submits a copy of Size bytes from Source to Destination (the buffers must not overlap)
+ *
+ * @param[in] Add_pstrRequest	: the request (Destination/Source/Size/Callback set)
+ *
+ * @return STD_enuErrorStatus_t : STD_enuOk 		  : Successful Operation
+ * 								  STD_enuNullPtr	  : Add_pstrRequest, Destination or Source is a NULL pointer
+ * 								  STD_enuInvalidValue : Size is 0
+ * 								  STD_enuInvalidState : The service is not initialized / the request is still pending
+ * 								  STD_enuOperationFailed : The stream could not be started (the request is DMACPY_enuFailed)
+ */
+STD_enuErrorStatus_t DMACPY_enuCopy(DMACPY_strRequest_t* Add_pstrRequest)
+{
+    STD_enuErrorStatus_t loc_enuErrorStatus = STD_enuOk;
+
+    if((NULL == Add_pstrRequest) || (NULL == Add_pstrRequest->Source))
+    {
+        loc_enuErrorStatus = STD_enuNullPtr;
+    }
+    else if((DMACPY_enuQueued == Add_pstrRequest->State) || (DMACPY_enuRunning == Add_pstrRequest->State))
+    {
+        loc_enuErrorStatus = STD_enuInvalidState;
+    }
+    else
+    {
+        Add_pstrRequest->Fill = ZERO;
+        loc_enuErrorStatus = submit(Add_pstrRequest);
+    }
+
+    return loc_enuErrorStatus;
+}
+
+/**
+ * @brief Submits a fill of Size bytes of Destination with Value
+ *
+ * @param[in] Add_pstrRequest	: the request (Destination/Size/Value/Callback set)
+ *
+ * @return STD_enuErrorStatus_t : STD_enuOk 		  : Successful Operation
+ * 								  STD_enuNullPtr	  : Add_pstrRequest or Destination is a NULL pointer
+ * 								  STD_enuInvalidValue : Size is 0
+ * 								  STD_enuInvalidState : The service is not initialized / the request is still pending
+ * 								  STD_enuOperationFailed : The stream could not be started (the request is DMACPY_enuFailed)
+ */
+STD_enuErrorStatus_t DMACPY_enuFill(DMACPY_strRequest_t* Add_pstrRequest)
+{
+    STD_enuErrorStatus_t loc_enuErrorStatus = STD_enuOk;
+
+    if(NULL == Add_pstrRequest)
+    {
+        loc_enuErrorStatus = STD_enuNullPtr;
+    }
+    else if((DMACPY_enuQueued == Add_pstrRequest->State) || (DMACPY_enuRunning == Add_pstrRequest->State))
+    {
+        loc_enuErrorStatus = STD_enuInvalidState;
+    }
+    else
+    {
+        /* The DMA reads the value replicated in a word from a fixed address */
+        Add_pstrRequest->Fill = 1;
+        Add_pstrRequest->Pattern = (u32)Add_pstrRequest->Value * 0x01010101UL;
+        loc_enuErrorStatus = submit(Add_pstrRequest);
+    }
+
+    return loc_enuErrorStatus;
+}
+
+/*===========================================================================================================*/
+/*										  	 Private Implementations										 */
+/*===========================================================================================================*/
+static STD_enuErrorStatus_t submit(DMACPY_strRequest_t* Add_pstrRequest)
+{
+    STD_enuErrorStatus_t loc_enuErrorStatus = STD_enuOk;
+    u32 loc_u32Destination = (u32)Add_pstrRequest->Destination;
+    u32 loc_u32Primask = ZERO;
+    u8 loc_u8Iterator = ZERO;
+
+    if(NULL == Add_pstrRequest->Destination)
+    {
+        loc_enuErrorStatus = STD_enuNullPtr;
+    }
+    else if(ZERO == Add_pstrRequest->Size)
+    {
+        loc_enuErrorStatus = STD_enuInvalidValue;
+    }
+    else if(!DMACPY_u8Initialized)
+    {
+        loc_enuErrorStatus = STD_enuInvalidState;
+    }
+    else
+    {
+        /* Words when the source and the destination can be aligned together, bytes otherwise */
+        if(Add_pstrRequest->Fill || (ZERO == ((loc_u32Destination ^ (u32)Add_pstrRequest->Source) & WORD_MASK)))
+        {
+            Add_pstrRequest->Offset = (4 - (loc_u32Destination & WORD_MASK)) & WORD_MASK;
+            Add_pstrRequest->Length = (Add_pstrRequest->Size > Add_pstrRequest->Offset) ?
+                                      ((Add_pstrRequest->Size - Add_pstrRequest->Offset) & ~WORD_MASK) : ZERO;
+        }
+        else
+        {
+            Add_pstrRequest->Offset = ZERO;
+            Add_pstrRequest->Length = Add_pstrRequest->Size;
+        }
+
+        Add_pstrRequest->Done = ZERO;
+        Add_pstrRequest->Next = NULL;
+
+        if((Add_pstrRequest->Size < DMACPY_CFG_THRESHOLD) || (ZERO == Add_pstrRequest->Length))
+        {
+            cpu_transfer(Add_pstrRequest, ZERO, Add_pstrRequest->Size);
+            Add_pstrRequest->State = DMACPY_enuDone;
+
+            if(NULL != Add_pstrRequest->Callback)
+            {
+                Add_pstrRequest->Callback(Add_pstrRequest);
+            }
+            else
+            {
+                /* Do Nothing */
+            }
+        }
+        else
+        {
+            /* The unaligned head and tail are not worth a transfer */
+            cpu_transfer(Add_pstrRequest, ZERO, Add_pstrRequest->Offset);
+            cpu_transfer(Add_pstrRequest, Add_pstrRequest->Offset + Add_pstrRequest->Length,
+                         Add_pstrRequest->Size - Add_pstrRequest->Offset - Add_pstrRequest->Length);
+
+            Add_pstrRequest->State = DMACPY_enuQueued;
+
+            ENTER_CRITICAL(loc_u32Primask);
+
+            for(loc_u8Iterator = ZERO; (loc_u8Iterator < DMACPY_CFG_STREAM_COUNT) && (DMACPY_enuQueued == Add_pstrRequest->State); loc_u8Iterator++)
+            {
+                if(NULL != DMACPY_strSlots[loc_u8Iterator].Request)
+                {
+                    /* Do Nothing */
+                }
+                else
+                {
+                    DMACPY_strSlots[loc_u8Iterator].Request = Add_pstrRequest;
+
+                    if(STD_enuOk != start_chunk(&DMACPY_strSlots[loc_u8Iterator]))
+                    {
+                        DMACPY_strSlots[loc_u8Iterator].Request = NULL;
+                        Add_pstrRequest->State = DMACPY_enuFailed;
+                        loc_enuErrorStatus = STD_enuOperationFailed;
+                    }
+                    else
+                    {
+                        /* Do Nothing */
+                    }
+                }
+            }
+
+            if(DMACPY_enuQueued != Add_pstrRequest->State)
+            {
+                /* Do Nothing */
+            }
+            else if(NULL == DMACPY_pstrQueueTail)
+            {
+                DMACPY_pstrQueueHead = Add_pstrRequest;
+                DMACPY_pstrQueueTail = Add_pstrRequest;
+            }
+            else
+            {
+                DMACPY_pstrQueueTail->Next = Add_pstrRequest;
+                DMACPY_pstrQueueTail = Add_pstrRequest;
+            }
+
+            EXIT_CRITICAL(loc_u32Primask);
+        }
+    }
+
+    return loc_enuErrorStatus;
+}
+
+static void cpu_transfer(DMACPY_strRequest_t* Add_pstrRequest, u32 Copy_u32Offset, u32 Copy_u32Size)
+{
+    u8* loc_pu8Destination = (u8*)Add_pstrRequest->Destination + Copy_u32Offset;
+    const u8* loc_pu8Source = NULL;
+    u32 loc_u32Iterator = ZERO;
+
+    if(Add_pstrRequest->Fill)
+    {
+        for(loc_u32Iterator = ZERO; loc_u32Iterator < Copy_u32Size; loc_u32Iterator++)
+        {
+            loc_pu8Destination[loc_u32Iterator] = Add_pstrRequest->Value;
+        }
+    }
+    else
+    {
+        loc_pu8Source = (const u8*)Add_pstrRequest->Source + Copy_u32Offset;
+
+        for(loc_u32Iterator = ZERO; loc_u32Iterator < Copy_u32Size; loc_u32Iterator++)
+        {
+            loc_pu8Destination[loc_u32Iterator] = loc_pu8Source[loc_u32Iterator];
+        }
+    }
+}
+
+static STD_enuErrorStatus_t start_chunk(DMACPY_strSlot_t* Add_pstrSlot)
+{
+    STD_enuErrorStatus_t loc_enuErrorStatus = STD_enuOk;
+    DMACPY_strRequest_t* loc_pstrRequest = Add_pstrSlot->Request;
+    DMA_strConfig_t loc_strConfig = {ZERO};
+    u32 loc_u32Destination = (u32)loc_pstrRequest->Destination + loc_pstrRequest->Offset + loc_pstrRequest->Done;
+    u32 loc_u32Source = ZERO;
+    u32 loc_u32Items = ZERO;
+    u8 loc_u8Size = ZERO;
+
+    if(loc_pstrRequest->Fill)
+    {
+        loc_u32Source = (u32)&loc_pstrRequest->Pattern;
+        loc_u8Size = DMA_SIZE_WORD;
+    }
+    else
+    {
+        loc_u32Source = (u32)loc_pstrRequest->Source + loc_pstrRequest->Offset + loc_pstrRequest->Done;
+        loc_u8Size = (ZERO == ((loc_u32Destination | loc_u32Source) & WORD_MASK)) ? DMA_SIZE_WORD : DMA_SIZE_BYTE;
+        loc_strConfig.Mode = DMA_MODE_PERIPH_INC;
+    }
+
+    loc_u32Items = (loc_pstrRequest->Length - loc_pstrRequest->Done) >> loc_u8Size;
+    if(loc_u32Items > MAX_ITEMS)
+    {
+        loc_u32Items = MAX_ITEMS;
+    }
+    else
+    {
+        /* Do Nothing */
+    }
+
+    loc_pstrRequest->Chunk = loc_u32Items << loc_u8Size;
+    loc_pstrRequest->State = DMACPY_enuRunning;
+
+    loc_strConfig.Direction = DMA_MEM_TO_MEM;
+    loc_strConfig.Mode |= DMA_MODE_MEM_INC;
+    loc_strConfig.Priority = DMACPY_CFG_PRIORITY;
+    loc_strConfig.PeriphSize = loc_u8Size;
+    loc_strConfig.MemSize = loc_u8Size;
+    loc_strConfig.Fifo = DMA_FIFO_FULL;
+    loc_strConfig.Events = DMA_EVENT_COMPLETE | DMA_EVENT_ERROR;
+    loc_strConfig.Callback = dma_event;
+
+    /* Bursts never cross a 1 KB boundary on 16 bytes aligned buffers (the fill word is read singly) */
+    if((DMA_SIZE_WORD == loc_u8Size) && (ZERO == (loc_u32Destination & BURST_MASK)) && (ZERO == (loc_u32Items % BURST_WORDS)))
+    {
+        loc_strConfig.MemBurst = DMA_BURST_INC4;
+        loc_strConfig.PeriphBurst = (!loc_pstrRequest->Fill && (ZERO == (loc_u32Source & BURST_MASK))) ? DMA_BURST_INC4 : DMA_BURST_SINGLE;
+    }
+    else
+    {
+        /* Do Nothing */
+    }
+
+    loc_enuErrorStatus = DMA_enuConfigure(Add_pstrSlot->Stream, &loc_strConfig);
+
+    if(STD_enuOk == loc_enuErrorStatus)
+    {
+        loc_enuErrorStatus = DMA_enuStart(Add_pstrSlot->Stream, loc_u32Source, loc_u32Destination, (u16)loc_u32Items);
+    }
+    else
+    {
+        /* Do Nothing */
+    }
+
+    return loc_enuErrorStatus;
+}
+
+static void finish_request(DMACPY_strSlot_t* Add_pstrSlot, DMACPY_enuState_t Copy_enuState)
+{
+    DMACPY_strRequest_t* loc_pstrRequest = Add_pstrSlot->Request;
+    DMACPY_strRequest_t* loc_pstrFailed = NULL;
+    u32 loc_u32Primask = ZERO;
+
+    while(NULL != loc_pstrRequest)
+    {
+        loc_pstrRequest->State = Copy_enuState;
+        loc_pstrFailed = NULL;
+
+        /* The stream takes the oldest queued request before the callback, which may submit again */
+        ENTER_CRITICAL(loc_u32Primask);
+
+        Add_pstrSlot->Request = DMACPY_pstrQueueHead;
+
+        if(NULL != DMACPY_pstrQueueHead)
+        {
+            DMACPY_pstrQueueHead = DMACPY_pstrQueueHead->Next;
+            if(NULL == DMACPY_pstrQueueHead)
+            {
+                DMACPY_pstrQueueTail = NULL;
+            }
+            else
+            {
+                /* Do Nothing */
+            }
+
+            /* A request that can't be started frees the stream for the next one */
+            if(STD_enuOk != start_chunk(Add_pstrSlot))
+            {
+                loc_pstrFailed = Add_pstrSlot->Request;
+                Add_pstrSlot->Request = NULL;
+            }
+            else
+            {
+                /* Do Nothing */
+            }
+        }
+        else
+        {
+            /* Do Nothing */
+        }
+
+        EXIT_CRITICAL(loc_u32Primask);
+
+        if(NULL != loc_pstrRequest->Callback)
+        {
+            loc_pstrRequest->Callback(loc_pstrRequest);
+        }
+        else
+        {
+            /* Do Nothing */
+        }
+
+        loc_pstrRequest = loc_pstrFailed;
+        Copy_enuState = DMACPY_enuFailed;
+    }
+}
+
+static void dma_event(DMA_enuStream_t Copy_enuStream, u8 Copy_u8Events)
+{
+    DMACPY_strSlot_t* loc_pstrSlot = NULL;
+    DMACPY_strRequest_t* loc_pstrRequest = NULL;
+    u8 loc_u8Iterator = ZERO;
+
+    for(loc_u8Iterator = ZERO; loc_u8Iterator < DMACPY_CFG_STREAM_COUNT; loc_u8Iterator++)
+    {
+        if(Copy_enuStream == DMACPY_strSlots[loc_u8Iterator].Stream)
+        {
+            loc_pstrSlot = &DMACPY_strSlots[loc_u8Iterator];
+        }
+        else
+        {
+            /* Do Nothing */
+        }
+    }
+
+    if((NULL != loc_pstrSlot) && (NULL != loc_pstrSlot->Request))
+    {
+        loc_pstrRequest = loc_pstrSlot->Request;
+        loc_pstrRequest->Done += loc_pstrRequest->Chunk;
+
+        if((ZERO == (Copy_u8Events & DMA_EVENT_ERROR)) && (loc_pstrRequest->Done < loc_pstrRequest->Length))
+        {
+            if(STD_enuOk != start_chunk(loc_pstrSlot))
+            {
+                finish_request(loc_pstrSlot, DMACPY_enuFailed);
+            }
+            else
+            {
+                /* Do Nothing */
+            }
+        }
+        else
+        {
+            finish_request(loc_pstrSlot, (Copy_u8Events & DMA_EVENT_ERROR) ? DMACPY_enuFailed : DMACPY_enuDone);
+        }
+    }
+    else
+    {
+        /* Do Nothing */
+    }
+}
@@ -0,0 +1,102 @@
+/*
+ * @file  : DMACPY.h
+ * @brief : user interface for the asynchronous memory copy/fill service (DMA2 memory to memory)
+ * @author: Alaa Hisham
+ * @date  : 29-03-2024
+ */
+
+#ifndef DMACPY_H_
+#define DMACPY_H_
+
+/*===========================================================================================================*/
+/*												    Includes	 										     */
+/*===========================================================================================================*/
+#include "STD_TYPES.h"
+
+/*===========================================================================================================*/
+/*												     Types		 										     */
+/*===========================================================================================================*/
+typedef enum
+{
+	DMACPY_enuIdle		,	/* Never submitted */
+	DMACPY_enuQueued	,	/* Waiting for a free stream */
+	DMACPY_enuRunning	,	/* Being transferred by the DMA */
+	DMACPY_enuDone		,	/* Completed: the destination can be used */
+	DMACPY_enuFailed		/* DMA error / stream not started: the destination is partially written */
+}DMACPY_enuState_t;
+
+struct DMACPY_strRequest;
+
+/**
+ * Completion callback: called from interrupt context, or from the caller of DMACPY_enuCopy /
+ * DMACPY_enuFill for the requests under DMACPY_CFG_THRESHOLD
+ */
+typedef void (*DMACPY_CBF_t)(struct DMACPY_strRequest* Add_pstrRequest);
+
+/**
+ * Copy/fill request (statically allocated by the caller)
+ * The request and the buffers must stay untouched until the request is done or failed
+ * (State can be polled instead of using a callback).
+ */
+typedef struct DMACPY_strRequest
+{
+	void* Destination;
+	const void* Source;							/* Copy only */
+	u32 Size;									/* Bytes */
+	u8 Value;									/* Fill only */
+	DMACPY_CBF_t Callback;						/* Can be NULL */
+	volatile DMACPY_enuState_t State;			/* Managed by DMACPY */
+	u8 Fill;									/* Managed by DMACPY: fill (1) or copy (0) */
+	u32 Pattern;								/* Managed by DMACPY: the fill word read by the DMA */
+	u32 Offset;									/* Managed by DMACPY: first byte of the DMA part */
+	u32 Length;									/* Managed by DMACPY: bytes of the DMA part */
+	u32 Done;									/* Managed by DMACPY: bytes of the DMA part transferred */
+	u32 Chunk;									/* Managed by DMACPY: bytes of the running transfer */
+	struct DMACPY_strRequest* Next;				/* Managed by DMACPY */
+}DMACPY_strRequest_t;
+
+/*===========================================================================================================*/
+/*											 Function Prototypes											 */
+/*===========================================================================================================*/
+
+/**
+ * @brief Reserves the DMA2 streams listed in DMACPY_cfg.h
+ *
+ * Must be called after the drivers that reserve fixed streams (USART_Init).
+ *
+ * @return STD_enuErrorStatus_t : STD_enuOk 			 : Successful Operation
+ * 								  STD_enuInvalidConfig	 : A configured stream is not a DMA2 stream
+ * 								  STD_enuOperationFailed : A stream is already reserved / the DMA2 clock could not be enabled
+ */
+STD_enuErrorStatus_t DMACPY_Init(void);
+
+/**
+ * @brief Submits a copy of Size bytes from Source to Destination (the buffers must not overlap)
+ *
+ * The request runs as soon as a stream is free, in submission order. The bytes up to the first
+ * aligned word and after the last one are copied by the CPU before returning.
+ *
+ * @param[in] Add_pstrRequest	: the request (Destination/Source/Size/Callback set)
+ *
+ * @return STD_enuErrorStatus_t : STD_enuOk 		  : Successful Operation
+ * 								  STD_enuNullPtr	  : Add_pstrRequest, Destination or Source is a NULL pointer
+ * 								  STD_enuInvalidValue : Size is 0
+ * 								  STD_enuInvalidState : The service is not initialized / the request is still pending
+ * 								  STD_enuOperationFailed : The stream could not be started (the request is DMACPY_enuFailed)
+ */
+STD_enuErrorStatus_t DMACPY_enuCopy(DMACPY_strRequest_t* Add_pstrRequest);
+
+/**
+ * @brief Submits a fill of Size bytes of Destination with Value
+ *
+ * @param[in] Add_pstrRequest	: the request (Destination/Size/Value/Callback set)
+ *
+ * @return STD_enuErrorStatus_t : STD_enuOk 		  : Successful Operation
+ * 								  STD_enuNullPtr	  : Add_pstrRequest or Destination is a NULL pointer
+ * 								  STD_enuInvalidValue : Size is 0
+ * 								  STD_enuInvalidState : The service is not initialized / the request is still pending
+ * 								  STD_enuOperationFailed : The stream could not be started (the request is DMACPY_enuFailed)
+ */
+STD_enuErrorStatus_t DMACPY_enuFill(DMACPY_strRequest_t* Add_pstrRequest);
+
+#endif /* DMACPY_H_ */
@@ -0,0 +1,41 @@
+/*
+ * @file  : DMACPY_cfg.h
+ * @brief : pre-compile configurations for the DMA memory copy/fill service
+ * @author: Alaa Hisham
+ * @date  : 29-03-2024
+ */
+
+#ifndef DMACPY_CFG_H_
+#define DMACPY_CFG_H_
+
+/*===========================================================================================================*/
+/*												    Includes	 										     */
+/*===========================================================================================================*/
+#include "STD_TYPES.h"
+#include "DMA.h"
+
+/*===========================================================================================================*/
+/*												     Macros		 										     */
+/*===========================================================================================================*/
+/**
+ * @brief The DMA2 streams reserved by DMACPY_Init (memory to memory is only available on DMA2),
+ *        one request runs on each of them at a time
+ *        (their DMA2_StreamN_IRQn must be enabled in NVIC_cfg.c; streams 1, 2, 6 and 7 belong to the USARTs,
+ *        0 and 3 to SPI1, 0 and 1 to SPI4: 4 and 5 are the only free ones)
+ */
+#define DMACPY_CFG_STREAM_COUNT		2
+#define DMACPY_CFG_STREAMS			{DMA_enuDma2Stream4, DMA_enuDma2Stream5}
+
+/**
+ * @brief Requests smaller than this number of bytes are done by the CPU when they are submitted
+ *        (below it, programming the stream and taking the interrupt cost more than the copy)
+ */
+#define DMACPY_CFG_THRESHOLD		256
+
+/**
+ * @brief Priority of the streams against the other DMA2 streams
+ *        (low: the peripheral streams are served first)
+ */
+#define DMACPY_CFG_PRIORITY			DMA_PRIORITY_LOW
+
+#endif /* DMACPY_CFG_H_ */
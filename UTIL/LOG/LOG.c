@@ -2,16 +2,118 @@
 #include <stdlib.h>
 #include <stdarg.h>
 #include <string.h>
+#include <stdint.h>
+#include <stddef.h>
 #include <time.h>
+#include <sched.h>
+#include <pthread.h>
+#include <semaphore.h>
+#include <stdatomic.h>
 
 #include "LOG.h"
+#include "LOG_cfg.h"
+#include "LOG_bin.h"
+#include "LOG_file.h"
+#include "LOG_sink.h"
+#include "LOG_limit.h"
+#include "LOG_fmt.h"
+#include "LOG_kv.h"
+
+#define RING_MASK           (LOG_CFG_RING_RECORDS - 1)
+
+/* Copy one argument of the given type verbatim into the binary record */
+#define STORE_ARG(TYPE)                                                             \
+    do                                                                              \
+    {                                                                               \
+        TYPE value_ = va_arg(valist, TYPE);                                         \
+        memcpy(buffer + length, &value_, sizeof(value_));                           \
+        length += (int)sizeof(value_);                                              \
+    } while(0)
+
+/* Fixed texts of the logger itself: same formatter as the messages (no libc printf with LOG_CFG_INT_FORMAT) */
+#if LOG_CFG_INT_FORMAT
+#define FORMAT_TEXT         LOG_format
+#else
+#define FORMAT_TEXT         snprintf
+#endif
+
+/* Record kinds (output of each kind) */
+#define RECORD_TEXT         0   /* output channel */
+#define RECORD_BINARY       1   /* binary log */
+
+#if ((LOG_CFG_RING_RECORDS & RING_MASK) != 0)
+#error "LOG_CFG_RING_RECORDS must be a power of 2"
+#endif
+
+/* A ring record: seq == position when free for the producer reserving that position,
+   position + 1 once the message is written and ready for the writer thread */
+typedef struct
+{
+    atomic_size_t seq;
+    int kind;
+    LOG_enuSeverityLevel_t severity;
+    int length;
+    char text[LOG_CFG_RECORD_SIZE];
+}LOG_strRecord_t;
 
-int gl_log_channel = LOG_OUT_CONSOLE;
 LOG_enuSeverityLevel_t gl_min_severity = info;
-FILE *gl_fptr = NULL;
+
+/* modules pass everything by default: the effective level is the global one */
+unsigned char LOG_moduleLevel[LOG_CFG_MODULES] = {[0 ... (LOG_CFG_MODULES - 1)] = info};
+static unsigned char gl_module_own_level[LOG_CFG_MODULES] = {debug};
+static pthread_mutex_t gl_level_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static LOG_strRecord_t gl_ring[LOG_CFG_RING_RECORDS];
+static atomic_size_t gl_ring_head;      /* next position to reserve (producers) */
+static size_t gl_ring_tail;             /* next position to drain (writer thread only) */
+static atomic_ulong gl_dropped;
+static unsigned long gl_dropped_reported;
+
+static atomic_int gl_async_running;
+static atomic_int gl_active_callers;
+static atomic_int gl_stop_request;
+static atomic_int gl_writer_idle;
+static int gl_overflow_policy = LOG_OVERFLOW_DROP;
+static pthread_t gl_writer;
+static sem_t gl_wakeup;
+
+static _Atomic(FILE*) gl_bin_fptr = NULL;  /* published once the header is written */
+static atomic_int gl_bin_generation;    /* changes with every binary log, invalidates the call site ids */
+static int gl_bin_next_id;
+static struct timespec gl_bin_start;
+static pthread_mutex_t gl_bin_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static atomic_int gl_time_mode = LOG_TIME_DATE;
+static atomic_int gl_kv_format = LOG_KV_JSON;
+
+/* Per thread cache of the "[date" part of the time prefix, rebuilt when the second changes */
+static __thread time_t tl_time_second = -1;
+static __thread int tl_time_mode = -1;
+static __thread int tl_time_length;
+static __thread char tl_time_prefix[32];
+static __thread int tl_time_suffix_length;
+static __thread char tl_time_suffix[8];
+static __thread int tl_writer;          /* the writer thread: its notices skip the ring */
+
+static void update_module_levels(void);
+static void log_text(LOG_enuSeverityLevel_t severity, const char* message, va_list valist);
+static void log_notice(LOG_enuSeverityLevel_t severity, const char* message, ...);
+static void report_expired(const char* message, int severity, unsigned long repeated, unsigned long dropped);
+static void log_record(int kind, LOG_enuSeverityLevel_t severity, const char* data, int length);
+static int format_time(char* buffer);
+static int format_record(char* buffer, LOG_enuSeverityLevel_t severity, const char* message, va_list valist, int* timeLength);
+static void emit_record(int kind, LOG_enuSeverityLevel_t severity, const char* data, int length);
+static void flush_output(void);
+static int bin_intern(LOG_strBinSite_t* site, const char* message, int generation);
+static int put_varint(char* buffer, unsigned long long value);
+static int put_kv_string(char* buffer, int room, const char* text);
+static int ring_push(int kind, LOG_enuSeverityLevel_t severity, const char* data, int length);
+static int ring_drain(int maxRecords);
+static void* writer_thread(void* arg);
+static void wait_for_records(long expiry);
 
 /**
- * @brief Select where to generate log messages
+ * @brief Select where to generate log messages (sink 0)
  * 
  * @param[in] outputChannel: LOG_OUT_FILE: log the messages in a file
  *                           LOG_OUT_CONSOLE: log the messages to the console
@@ -20,7 +122,7 @@ FILE *gl_fptr = NULL;
 */
 void LOG_setOutputChannel(int outputChannel)
 {
-    gl_log_channel = outputChannel;
+    log_sink_set_channel(outputChannel);
 }
 
 /**
@@ -32,10 +134,27 @@ void LOG_setOutputChannel(int outputChannel)
 */
 void LOG_fileCfg(char* fileName)
 {
-    if(LOG_OUT_FILE == gl_log_channel)
+    /* the channel may be selected before or after the file */
+    LOG_fileOpen(fileName, NULL, 0, 0, 0);
+}
+
+/**
+ * @brief Close the log file (after writing the queued messages if the asynchronous mode is on)
+ *        (also done at exit)
+ * 
+ * @return
+*/
+void LOG_fileClose(void)
+{
+    if(atomic_load(&gl_async_running))
+    {
+        LOG_stopAsync();
+        log_file_close();
+        LOG_startAsync(gl_overflow_policy);
+    }
+    else
     {
-        /* Open file in append mode */
-        gl_fptr = fopen(fileName, "a");
+        log_file_close();
     }
 }
 
@@ -50,29 +169,15 @@ void LOG_fileCfg(char* fileName)
 */
 void LOG_write(LOG_enuSeverityLevel_t severity, const char* message, ...)
 {
-    if(severity >= gl_min_severity)
+    /* nothing to format if no sink takes it */
+    if((severity >= gl_min_severity) && (severity >= log_sink_min_severity()))
     {
         va_list valist;
 
-        time_t mytime = time(NULL);
-        char * time_str = ctime(&mytime);
-        time_str[strlen(time_str)-1] = '\0';
-
         /* initialize valist */
         va_start(valist, message);
-   
-        if(gl_log_channel == LOG_OUT_FILE)
-        {
-            fprintf(gl_fptr, "[%s] ", time_str);
-            vfprintf(gl_fptr, message, valist);
-            fprintf(gl_fptr, "\n");
-        }
-        else if(gl_log_channel == LOG_OUT_CONSOLE)
-        {
-            printf("[%s] ", time_str);
-            vprintf(message, valist);
-            printf("\n");
-        }
+
+        log_text(severity, message, valist);
 
         /* clean memory reserved for valist */
         va_end(valist);
@@ -94,10 +199,917 @@ void LOG_setSeverity(LOG_enuSeverityLevel_t severity)
 {
     if((unsigned int)severity <= error)
     {
+        pthread_mutex_lock(&gl_level_lock);
         gl_min_severity = severity;
+        update_module_levels();
+        pthread_mutex_unlock(&gl_level_lock);
+    }
+    else
+    {
+
+    }
+}
+
+/**
+ * @brief Select the minimum severity level of a module (checked by the LOG_xxx macros)
+ * 
+ * @param[in] module  : the module (LOG_MOD_xxx)
+ * @param[in] severity: the minimum severity level
+ * 
+ * @return
+*/
+void LOG_setModuleSeverity(int module, LOG_enuSeverityLevel_t severity)
+{
+    if((module >= 0) && (module < LOG_CFG_MODULES) && ((unsigned int)severity <= error))
+    {
+        pthread_mutex_lock(&gl_level_lock);
+        gl_module_own_level[module] = (unsigned char)severity;
+        update_module_levels();
+        pthread_mutex_unlock(&gl_level_lock);
+    }
+    else
+    {
+
+    }
+}
+
+/**
+ * @brief Start the asynchronous mode: LOG_write formats the message into a lock-free ring
+ *        and a writer thread drains it in batches to the output channel
+ * 
+ * @param[in] overflowPolicy: LOG_OVERFLOW_DROP : drop (and count) messages when the ring is full
+ *                            LOG_OVERFLOW_BLOCK: wait for a free record when the ring is full
+ * 
+ * @return 0 on success, -1 if already started or the writer thread could not be created
+*/
+int LOG_startAsync(int overflowPolicy)
+{
+    int ret = -1;
+    size_t i;
+
+    if((atomic_load(&gl_async_running) == 0)
+    && ((LOG_OVERFLOW_DROP == overflowPolicy) || (LOG_OVERFLOW_BLOCK == overflowPolicy)))
+    {
+        for(i = 0; i < LOG_CFG_RING_RECORDS; i++)
+        {
+            atomic_init(&gl_ring[i].seq, i);
+        }
+        atomic_store(&gl_ring_head, 0);
+        gl_ring_tail = 0;
+
+        gl_overflow_policy = overflowPolicy;
+        atomic_store(&gl_stop_request, 0);
+        atomic_store(&gl_writer_idle, 0);
+
+        if(sem_init(&gl_wakeup, 0, 0) == 0)
+        {
+            if(pthread_create(&gl_writer, NULL, writer_thread, NULL) == 0)
+            {
+                atomic_store(&gl_async_running, 1);
+                ret = 0;
+            }
+            else
+            {
+                sem_destroy(&gl_wakeup);
+            }
+        }
+    }
+    else
+    {
+
+    }
+
+    return ret;
+}
+
+/**
+ * @brief Stop the asynchronous mode: write all the queued messages then stop the writer thread
+ *        (LOG_write is synchronous again afterwards)
+ * 
+ * @return
+*/
+void LOG_stopAsync(void)
+{
+    if(atomic_exchange(&gl_async_running, 0))
+    {
+        /* callers already queuing finish before the writer sees the request */
+        while(atomic_load(&gl_active_callers) != 0)
+        {
+            sched_yield();
+        }
+
+        atomic_store(&gl_stop_request, 1);
+        sem_post(&gl_wakeup);
+        pthread_join(gl_writer, NULL);
+        sem_destroy(&gl_wakeup);
+    }
+    else
+    {
+
+    }
+}
+
+/**
+ * @brief Get the number of messages dropped because the ring was full (LOG_OVERFLOW_DROP)
+ * 
+ * @return the number of dropped messages since the program started
+*/
+unsigned long LOG_getDroppedCount(void)
+{
+    return atomic_load(&gl_dropped);
+}
+
+/**
+ * @brief Open the binary log written by LOG_BIN (truncates the file)
+ *        (should be called before logging starts, LOG_BIN messages are dropped while no file is open)
+ * 
+ * @param[in] fileName: the name of the binary log file
+ * 
+ * @return 0 on success, -1 if the file could not be opened
+*/
+int LOG_binOpen(const char* fileName)
+{
+    int ret = -1;
+    struct timespec now;
+    long long seconds;
+    unsigned int microseconds;
+    unsigned char version = LOG_BIN_VERSION;
+    unsigned char abi[LOG_BIN_ABI_SIZE];
+    FILE* fptr;
+
+    LOG_binClose();
+
+    fptr = fopen(fileName, "wb");
+
+    if(fptr != NULL)
+    {
+        /* header: the wall clock start time, records then carry monotonic offsets */
+        clock_gettime(CLOCK_REALTIME, &now);
+        clock_gettime(CLOCK_MONOTONIC, &gl_bin_start);
+        seconds = now.tv_sec;
+        microseconds = (unsigned int)(now.tv_nsec / 1000);
+
+        fwrite(LOG_BIN_MAGIC, 1, 4, fptr);
+        LOG_binGetAbi(abi);
+
+        fwrite(&version, 1, 1, fptr);
+        fwrite(abi, 1, LOG_BIN_ABI_SIZE, fptr);
+        fwrite(&seconds, sizeof(seconds), 1, fptr);
+        fwrite(&microseconds, sizeof(microseconds), 1, fptr);
+
+        pthread_mutex_lock(&gl_bin_lock);
+        atomic_fetch_add_explicit(&gl_bin_generation, 1, memory_order_release);
+        gl_bin_next_id = 0;
+        pthread_mutex_unlock(&gl_bin_lock);
+
+        /* the writers that see the file also see its start time and generation */
+        atomic_store_explicit(&gl_bin_fptr, fptr, memory_order_release);
+
+        ret = 0;
+    }
+
+    return ret;
+}
+
+/**
+ * @brief Close the binary log (after writing the queued messages if the asynchronous mode is on)
+ * 
+ * @return
+*/
+void LOG_binClose(void)
+{
+    FILE* fptr = atomic_load_explicit(&gl_bin_fptr, memory_order_acquire);
+
+    if(fptr != NULL)
+    {
+        /* the writer thread may still hold binary records: let it write them first */
+        if(atomic_load(&gl_async_running))
+        {
+            LOG_stopAsync();
+            atomic_store_explicit(&gl_bin_fptr, NULL, memory_order_release);
+            fclose(fptr);
+            LOG_startAsync(gl_overflow_policy);
+        }
+        else
+        {
+            atomic_store_explicit(&gl_bin_fptr, NULL, memory_order_release);
+            fclose(fptr);
+        }
+    }
+}
+
+/**
+ * @brief Binary logging backend of LOG_BIN (use the macro, it provides the call site state)
+ * 
+ * @param[in] site    : the call site state
+ * @param[in] severity: the message's severity level
+ * @param[in] message : the format string (must stay valid: string literal)
+ * 
+ * @return
+*/
+void LOG_binWrite(LOG_strBinSite_t* site, LOG_enuSeverityLevel_t severity, const char* message, ...)
+{
+    /* the file first: its generation is at least the one published with it */
+    FILE* fptr = atomic_load_explicit(&gl_bin_fptr, memory_order_acquire);
+    int generation = atomic_load_explicit(&gl_bin_generation, memory_order_acquire);
+
+    if((severity >= gl_min_severity) && (fptr != NULL))
+    {
+        va_list valist;
+        char buffer[LOG_CFG_RECORD_SIZE];
+        int length = 0;
+        int i;
+        struct timespec now;
+        unsigned long long microseconds;
+
+        /* first use in this binary log: define the format */
+        if(atomic_load_explicit(&site->generation, memory_order_acquire) != generation)
+        {
+            bin_intern(site, message, generation);
+        }
+
+        va_start(valist, message);
+
+        if(site->id < 0)
+        {
+            /* format not supported in binary form */
+            log_text(severity, message, valist);
+        }
+        else
+        {
+            clock_gettime(CLOCK_MONOTONIC, &now);
+            microseconds = (unsigned long long)(now.tv_sec - gl_bin_start.tv_sec) * 1000000ULL
+                         + (unsigned long long)((now.tv_nsec - gl_bin_start.tv_nsec) / 1000);
+
+            buffer[length++] = LOG_BIN_TAG_MESSAGE;
+            length += put_varint(buffer + length, (unsigned long long)site->id);
+            buffer[length++] = (char)severity;
+            length += put_varint(buffer + length, microseconds);
+
+            /* the raw arguments: no formatting here (size checked for the largest fixed type) */
+            for(i = 0; (i < site->argCount) && (length >= 0); i++)
+            {
+                int room = LOG_CFG_RECORD_SIZE - length;
+
+                if(room < (int)sizeof(long double) + 1)
+                {
+                    length = -1;
+                }
+                else
+                {
+                    switch(site->argTypes[i])
+                    {
+                    case LOG_BIN_ARG_INT:         STORE_ARG(int); break;
+                    case LOG_BIN_ARG_LONG:        STORE_ARG(long); break;
+                    case LOG_BIN_ARG_LLONG:       STORE_ARG(long long); break;
+                    case LOG_BIN_ARG_SIZE:        STORE_ARG(size_t); break;
+                    case LOG_BIN_ARG_INTMAX:      STORE_ARG(intmax_t); break;
+                    case LOG_BIN_ARG_PTRDIFF:     STORE_ARG(ptrdiff_t); break;
+                    case LOG_BIN_ARG_PTR:         STORE_ARG(void*); break;
+                    case LOG_BIN_ARG_DOUBLE:      STORE_ARG(double); break;
+                    case LOG_BIN_ARG_LDOUBLE:     STORE_ARG(long double); break;
+                    default:
+                    {
+                        /* string: truncated to the room left in the record */
+                        const char* v = va_arg(valist, const char*);
+                        size_t size = (v != NULL) ? strlen(v) : 0;
+
+                        if(size > (size_t)(room - 3))
+                        {
+                            size = (size_t)(room - 3);
+                        }
+                        length += put_varint(buffer + length, size);
+                        if(size > 0)
+                        {
+                            memcpy(buffer + length, v, size);
+                            length += (int)size;
+                        }
+                    }
+                    break;
+                    }
+                }
+            }
+
+            if(length > 0)
+            {
+                log_record(RECORD_BINARY, severity, buffer, length);
+            }
+        }
+
+        va_end(valist);
+    }
+    else
+    {
+        /* neglect the message */
+    }
+}
+
+/**
+ * @brief Select how the LOG_KV records are serialized
+ * 
+ * @param[in] format: LOG_KV_JSON: a JSON line to the text sinks
+ *                    LOG_KV_TLV : a TLV record to the binary log (dropped while it is not open)
+ * 
+ * @return
+*/
+void LOG_setKvFormat(int format)
+{
+    if((format == LOG_KV_JSON) || (format == LOG_KV_TLV))
+    {
+        atomic_store_explicit(&gl_kv_format, format, memory_order_relaxed);
+    }
+    else
+    {
+
+    }
+}
+
+/**
+ * @brief Structured logging backend of LOG_KV (use the macro)
+ * 
+ * @param[in] severity: the record's severity level
+ * @param[in] event   : the event name
+ * @param[in] fields  : the fields
+ * @param[in] count   : the number of fields
+ * 
+ * @return
+*/
+void LOG_kvWrite(LOG_enuSeverityLevel_t severity, const char* event, const LOG_strKvField_t* fields, int count)
+{
+    char buffer[LOG_CFG_RECORD_SIZE];
+    int length = 0;
+    int room;
+    int i;
+    struct timespec now;
+    unsigned long long microseconds;
+    unsigned long long value;
+
+    if((severity < gl_min_severity) || (event == NULL) || (count < 0))
+    {
+        /* neglect the record */
+    }
+    else if(atomic_load_explicit(&gl_kv_format, memory_order_relaxed) == LOG_KV_JSON)
+    {
+        if(severity >= log_sink_min_severity())
+        {
+            clock_gettime(CLOCK_REALTIME, &now);
+            length = log_kv_json(buffer, LOG_CFG_RECORD_SIZE, severity, (long long)now.tv_sec, now.tv_nsec / 1000,
+                                 event, fields, count);
+            log_record(RECORD_TEXT, severity, buffer, length);
+        }
+    }
+    else if(atomic_load_explicit(&gl_bin_fptr, memory_order_acquire) != NULL)
+    {
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        microseconds = (unsigned long long)(now.tv_sec - gl_bin_start.tv_sec) * 1000000ULL
+                     + (unsigned long long)((now.tv_nsec - gl_bin_start.tv_nsec) / 1000);
+
+        /* the count is written last: only the fields that fit are kept (key and string lengths below 128) */
+        buffer[length++] = LOG_BIN_TAG_KV;
+        buffer[length++] = 0;
+        buffer[length++] = (char)severity;
+        length += put_varint(buffer + length, microseconds);
+        length += put_kv_string(buffer + length, LOG_CFG_RECORD_SIZE - length, event);
+
+        for(i = 0; (i < count) && (i < 0x7F); i++)
+        {
+            /* type, key, then at least a varint or an empty string */
+            room = LOG_CFG_RECORD_SIZE - length - (1 + 1 + (int)strlen(fields[i].key));
+            if(room < ((fields[i].type == LOG_KV_STR) ? 1 : 10))
+            {
+                break;
+            }
+
+            buffer[length++] = (char)fields[i].type;
+            length += put_kv_string(buffer + length, LOG_CFG_RECORD_SIZE - length, fields[i].key);
+
+            if(fields[i].type == LOG_KV_STR)
+            {
+                length += put_kv_string(buffer + length, LOG_CFG_RECORD_SIZE - length, fields[i].value.s);
+            }
+            else
+            {
+                /* zigzag: small negative numbers stay short */
+                value = (fields[i].type == LOG_KV_INT)
+                      ? (((unsigned long long)fields[i].value.i << 1) ^ (unsigned long long)(fields[i].value.i >> 63))
+                      : fields[i].value.u;
+                length += put_varint(buffer + length, value);
+            }
+        }
+
+        /* the fields that fit (fewer than 128: one varint byte) */
+        buffer[1] = (char)i;
+
+        log_record(RECORD_BINARY, severity, buffer, length);
+    }
+    else
+    {
+        /* no binary log open */
+    }
+}
+
+/* Effective level of each module (under gl_level_lock): the inline check of the LOG_xxx macros is the only gate */
+static void update_module_levels(void)
+{
+    int module;
+
+    for(module = 0; module < LOG_CFG_MODULES; module++)
+    {
+        LOG_moduleLevel[module] = (gl_module_own_level[module] > (unsigned char)gl_min_severity)
+                                ? gl_module_own_level[module] : (unsigned char)gl_min_severity;
+    }
+}
+
+/* Format and log a text message (severity already checked) */
+static void log_text(LOG_enuSeverityLevel_t severity, const char* message, va_list valist)
+{
+    char buffer[LOG_CFG_RECORD_SIZE];
+    int length;
+    int timeLength;
+    unsigned long dropped;
+    unsigned long repeated;
+
+    /* the copies of the sites whose repeat window is over (one load while none is due) */
+    log_limit_expire(report_expired);
+
+    /* a call site over its rate costs no formatting */
+    if(log_limit_check(message))
+    {
+        /* format once, on the caller's thread */
+        length = format_record(buffer, severity, message, valist, &timeLength);
+
+        if(!log_limit_repeat(message, (int)severity, buffer + timeLength, length - timeLength, &repeated))
+        {
+            /* the drops are taken only with a written message: a copy leaves them to the next one */
+            dropped = log_limit_dropped(message);
+
+            if(repeated > 0)
+            {
+                log_notice(severity, "[LOG] last message repeated %lu times", repeated);
+            }
+            if(dropped > 0)
+            {
+                log_notice(severity, "[LOG] %lu messages like the next one dropped (rate limit)", dropped);
+            }
+
+            log_record(RECORD_TEXT, severity, buffer, length);
+        }
+    }
+    else
+    {
+        /* dropped, counted by the rate limit */
+    }
+}
+
+/* Log a message of the logger itself (not rate limited) */
+static void log_notice(LOG_enuSeverityLevel_t severity, const char* message, ...)
+{
+    char buffer[LOG_CFG_RECORD_SIZE];
+    int length;
+    int timeLength;
+    va_list valist;
+
+    va_start(valist, message);
+    length = format_record(buffer, severity, message, valist, &timeLength);
+    va_end(valist);
+
+    if(tl_writer)
+    {
+        /* the writer thread cannot wait for room in its own ring: written right away (flushed with the batch) */
+        log_sink_emit_crash(severity, buffer, length);
+        emit_record(RECORD_TEXT, severity, buffer, length);
+    }
+    else
+    {
+        log_record(RECORD_TEXT, severity, buffer, length);
+    }
+}
+
+/* Report the copies of a message whose repeat window expired */
+static void report_expired(const char* message, int severity, unsigned long repeated, unsigned long dropped)
+{
+    if(dropped > 0)
+    {
+        log_notice((LOG_enuSeverityLevel_t)severity, "[LOG] \"%s\" repeated %lu times, %lu more dropped (rate limit)",
+                   message, repeated, dropped);
+    }
+    else
+    {
+        log_notice((LOG_enuSeverityLevel_t)severity, "[LOG] \"%s\" repeated %lu times", message, repeated);
+    }
+}
+
+/* Queue a record for the writer thread, or write it right away in synchronous mode */
+static void log_record(int kind, LOG_enuSeverityLevel_t severity, const char* data, int length)
+{
+    atomic_fetch_add(&gl_active_callers, 1);
+
+    /* the crash ring must not depend on the writer thread */
+    if(kind == RECORD_TEXT)
+    {
+        log_sink_emit_crash(severity, data, length);
+    }
+
+    if(atomic_load(&gl_async_running))
+    {
+        ring_push(kind, severity, data, length);
+    }
+    else
+    {
+        emit_record(kind, severity, data, length);
+
+        /* binary records stay in the stdio buffer until LOG_binClose */
+        if(kind == RECORD_TEXT)
+        {
+            flush_output();
+        }
+    }
+
+    atomic_fetch_sub(&gl_active_callers, 1);
+}
+
+/**
+ * @brief Select the time prefix of the text messages
+ * 
+ * @param[in] mode: LOG_TIME_DATE         : "[Mon Oct 19 10:17:47.123456 2026] " local wall clock
+ *                  LOG_TIME_RAW_REALTIME : "[1697710667.123456] " seconds since the epoch
+ *                  LOG_TIME_RAW_MONOTONIC: "[5123.123456] " seconds of the monotonic clock
+ * 
+ * @return
+*/
+void LOG_setTimeMode(int mode)
+{
+    if((mode == LOG_TIME_DATE) || (mode == LOG_TIME_RAW_REALTIME) || (mode == LOG_TIME_RAW_MONOTONIC))
+    {
+        atomic_store_explicit(&gl_time_mode, mode, memory_order_relaxed);
+    }
+    else
+    {
+
+    }
+}
+
+/* Write "[time] " with microseconds, returns its length (the libc date formatting runs once per second per thread) */
+static int format_time(char* buffer)
+{
+    int mode = atomic_load_explicit(&gl_time_mode, memory_order_relaxed);
+    struct timespec now;
+    struct tm date;
+    long fraction;
+    int length;
+    int i;
+
+    clock_gettime((mode == LOG_TIME_RAW_MONOTONIC) ? CLOCK_MONOTONIC : CLOCK_REALTIME, &now);
+
+    if((now.tv_sec != tl_time_second) || (mode != tl_time_mode))
+    {
+        if(mode == LOG_TIME_DATE)
+        {
+            localtime_r(&now.tv_sec, &date);
+            tl_time_length = (int)strftime(tl_time_prefix, sizeof(tl_time_prefix), "[%a %b %e %H:%M:%S", &date);
+
+            /* the year comes after the time, as in ctime */
+            tl_time_suffix_length = (int)strftime(tl_time_suffix, sizeof(tl_time_suffix), " %Y", &date);
+        }
+        else
+        {
+            tl_time_length = FORMAT_TEXT(tl_time_prefix, sizeof(tl_time_prefix), "[%lld", (long long)now.tv_sec);
+            tl_time_suffix_length = 0;
+        }
+
+        tl_time_second = now.tv_sec;
+        tl_time_mode = mode;
+    }
+
+    memcpy(buffer, tl_time_prefix, tl_time_length);
+    length = tl_time_length;
+
+    /* ".uuuuuu" without printf */
+    buffer[length++] = '.';
+    fraction = now.tv_nsec / 1000;
+    for(i = 5; i >= 0; i--)
+    {
+        buffer[length + i] = (char)('0' + (fraction % 10));
+        fraction /= 10;
+    }
+    length += 6;
+
+    memcpy(buffer + length, tl_time_suffix, tl_time_suffix_length);
+    length += tl_time_suffix_length;
+
+    buffer[length++] = ']';
+    buffer[length++] = ' ';
+
+    return length;
+}
+
+/* Format "[time] message\n" into a record sized buffer, returns the text length */
+static int format_record(char* buffer, LOG_enuSeverityLevel_t severity, const char* message, va_list valist, int* timeLength)
+{
+    int length;
+    int ret;
+
+    (void)severity;
+
+    length = format_time(buffer);
+    *timeLength = length;
+
+#if LOG_CFG_INT_FORMAT
+    ret = LOG_vformat(buffer + length, LOG_CFG_RECORD_SIZE - length, message, valist);
+#else
+    ret = vsnprintf(buffer + length, LOG_CFG_RECORD_SIZE - length, message, valist);
+#endif
+    if(ret > 0)
+    {
+        length += ret;
+    }
+
+    /* truncated: keep room for the line end */
+    if(length > LOG_CFG_RECORD_SIZE - 2)
+    {
+        length = LOG_CFG_RECORD_SIZE - 2;
+    }
+    buffer[length++] = '\n';
+    buffer[length] = '\0';
+
+    return length;
+}
+
+/* Write one record to its output (buffered by stdio) */
+static void emit_record(int kind, LOG_enuSeverityLevel_t severity, const char* data, int length)
+{
+    FILE* fptr;
+
+    if(kind == RECORD_BINARY)
+    {
+        fptr = atomic_load_explicit(&gl_bin_fptr, memory_order_acquire);
+        if(fptr != NULL)
+        {
+            fwrite(data, 1, length, fptr);
+        }
     }
     else
     {
+        log_sink_emit(severity, data, length);
+    }
+}
+
+static void flush_output(void)
+{
+    FILE* fptr = atomic_load_explicit(&gl_bin_fptr, memory_order_acquire);
+
+    if(fptr != NULL)
+    {
+        fflush(fptr);
+    }
+
+    log_sink_flush();
+}
+
+/* Give the call site a format id in the current binary log and write the format definition */
+static int bin_intern(LOG_strBinSite_t* site, const char* message, int generation)
+{
+    char buffer[LOG_CFG_RECORD_SIZE];
+    int length = 0;
+    size_t size = strlen(message);
+
+    pthread_mutex_lock(&gl_bin_lock);
+
+    /* another thread may have done it meanwhile */
+    if(atomic_load_explicit(&site->generation, memory_order_relaxed) != generation)
+    {
+        site->argCount = LOG_binParseFormat(message, site->argTypes, LOG_CFG_BIN_MAX_ARGS);
+
+        if((site->argCount < 0) || (size > LOG_CFG_RECORD_SIZE - 12))
+        {
+            site->id = -1;
+        }
+        else
+        {
+            site->id = ++gl_bin_next_id;
+
+            /* queued before any message using the id can be */
+            buffer[length++] = LOG_BIN_TAG_FORMAT;
+            length += put_varint(buffer + length, (unsigned long long)site->id);
+            length += put_varint(buffer + length, size);
+            memcpy(buffer + length, message, size);
+            log_record(RECORD_BINARY, info, buffer, length + (int)size);
+        }
+
+        atomic_store_explicit(&site->generation, generation, memory_order_release);
+    }
+
+    pthread_mutex_unlock(&gl_bin_lock);
+
+    return site->id;
+}
+
+/* LEB128: 7 bits per byte, low bits first, returns the number of bytes */
+static int put_varint(char* buffer, unsigned long long value)
+{
+    int length = 0;
+
+    while(value >= 0x80)
+    {
+        buffer[length++] = (char)((value & 0x7F) | 0x80);
+        value >>= 7;
+    }
+    buffer[length++] = (char)value;
+
+    return length;
+}
+
+/* length (varint, one byte) | characters, truncated to room, returns the number of bytes */
+static int put_kv_string(char* buffer, int room, const char* text)
+{
+    int size = (text != NULL) ? (int)strlen(text) : 0;
+
+    if(size > room - 1)
+    {
+        size = room - 1;
+    }
+    if(size > 0x7F)
+    {
+        size = 0x7F;
+    }
+
+    buffer[0] = (char)size;
+    if(size > 0)
+    {
+        memcpy(buffer + 1, text, size);
+    }
+
+    return size + 1;
+}
+
+/* Multi-producer enqueue: reserve a position with a CAS on the head, then publish the record */
+static int ring_push(int kind, LOG_enuSeverityLevel_t severity, const char* data, int length)
+{
+    int ret = 0;
+    size_t pos = atomic_load_explicit(&gl_ring_head, memory_order_relaxed);
+    LOG_strRecord_t* slot = NULL;
+    intptr_t diff;
+
+    while(slot == NULL)
+    {
+        LOG_strRecord_t* candidate = &gl_ring[pos & RING_MASK];
+        diff = (intptr_t)atomic_load_explicit(&candidate->seq, memory_order_acquire) - (intptr_t)pos;
+
+        if(diff == 0)
+        {
+            if(atomic_compare_exchange_weak_explicit(&gl_ring_head, &pos, pos + 1,
+                                                     memory_order_relaxed, memory_order_relaxed))
+            {
+                slot = candidate;
+            }
+        }
+        else if(diff < 0)
+        {
+            /* ring full */
+            if(gl_overflow_policy == LOG_OVERFLOW_DROP)
+            {
+                atomic_fetch_add_explicit(&gl_dropped, 1, memory_order_relaxed);
+                ret = -1;
+                break;
+            }
+            else
+            {
+                sched_yield();
+                pos = atomic_load_explicit(&gl_ring_head, memory_order_relaxed);
+            }
+        }
+        else
+        {
+            /* another producer took this position */
+            pos = atomic_load_explicit(&gl_ring_head, memory_order_relaxed);
+        }
+    }
+
+    if(slot != NULL)
+    {
+        slot->kind = kind;
+        slot->severity = severity;
+        slot->length = length;
+        memcpy(slot->text, data, length);
+        atomic_store_explicit(&slot->seq, pos + 1, memory_order_release);
+    }
+
+    /* only pay for the system call when the writer is waiting */
+    if(atomic_exchange_explicit(&gl_writer_idle, 0, memory_order_acq_rel))
+    {
+        sem_post(&gl_wakeup);
+    }
+
+    return ret;
+}
+
+/* Single consumer: write up to maxRecords ready records, returns the number written */
+static int ring_drain(int maxRecords)
+{
+    int count = 0;
+    LOG_strRecord_t* slot = &gl_ring[gl_ring_tail & RING_MASK];
+
+    while((count < maxRecords)
+       && (atomic_load_explicit(&slot->seq, memory_order_acquire) == gl_ring_tail + 1))
+    {
+        emit_record(slot->kind, slot->severity, slot->text, slot->length);
+
+        /* hand the record back to the producers one lap later */
+        atomic_store_explicit(&slot->seq, gl_ring_tail + LOG_CFG_RING_RECORDS, memory_order_release);
+        gl_ring_tail++;
+        count++;
+
+        slot = &gl_ring[gl_ring_tail & RING_MASK];
+    }
+
+    return count;
+}
+
+static void* writer_thread(void* arg)
+{
+    int running = 1;
+    unsigned long dropped;
+    char notice[64];
+    int length;
+
+    (void)arg;
+
+    tl_writer = 1;
+
+    while(running)
+    {
+        if(ring_drain(LOG_CFG_WRITER_BATCH) > 0)
+        {
+            dropped = atomic_load_explicit(&gl_dropped, memory_order_relaxed);
+            if(dropped != gl_dropped_reported)
+            {
+                length = FORMAT_TEXT(notice, sizeof(notice), "[LOG] %lu messages dropped\n", dropped - gl_dropped_reported);
+                emit_record(RECORD_TEXT, warning, notice, length);
+                gl_dropped_reported = dropped;
+            }
+
+            /* one flush per batch instead of one per message */
+            flush_output();
+        }
+        else if(atomic_load(&gl_stop_request))
+        {
+            running = 0;
+        }
+        else
+        {
+            atomic_store(&gl_writer_idle, 1);
+
+            /* re-check after announcing the wait: a record published meanwhile must not be missed */
+            if(atomic_load_explicit(&gl_ring[gl_ring_tail & RING_MASK].seq, memory_order_acquire) == gl_ring_tail + 1)
+            {
+                atomic_store(&gl_writer_idle, 0);
+            }
+            else
+            {
+                /* wakes up for the next repeat window end as well */
+                wait_for_records(log_limit_expire(report_expired));
+            }
+        }
+    }
+
+    flush_output();
+
+    return NULL;
+}
+
+/* Sleep until a producer posts the wakeup, at most one flush period when the file has a timed flush
+   or expiry ms when it is not negative */
+static void wait_for_records(long expiry)
+{
+    long period = log_file_period_ms();
+    struct timespec deadline;
+
+    if((expiry >= 0) && ((period == 0) || (expiry < period)))
+    {
+        period = (expiry > 0) ? expiry : 1;
+    }
 
+    if(period > 0)
+    {
+        clock_gettime(CLOCK_REALTIME, &deadline);
+        deadline.tv_sec += period / 1000;
+        deadline.tv_nsec += (long)(period % 1000) * 1000000;
+        if(deadline.tv_nsec >= 1000000000)
+        {
+            deadline.tv_sec++;
+            deadline.tv_nsec -= 1000000000;
+        }
+
+        if(sem_timedwait(&gl_wakeup, &deadline) != 0)
+        {
+            /* timed out (or interrupted): the producers were not told the writer stopped waiting */
+            atomic_store(&gl_writer_idle, 0);
+        }
+
+        log_file_tick();
+    }
+    else
+    {
+        sem_wait(&gl_wakeup);
     }
-}
\ No newline at end of file
+}
@@ -1,19 +1,179 @@
 #ifndef LOG_H_
 #define LOG_H_
 
+#include <stddef.h>
+#include <stdatomic.h>
+
+#include "LOG_cfg.h"
+
 #define LOG_OUT_FILE        0
 #define LOG_OUT_CONSOLE     1
 
+/* Sink types */
+#define LOG_SINK_CONSOLE    1
+#define LOG_SINK_FILE       2   /* the file of LOG_fileOpen */
+#define LOG_SINK_MEMORY     3   /* a ring of text lines in a user buffer */
+#define LOG_SINK_CALLBACK   4
+#define LOG_SINK_CRASH      5   /* a ring of records surviving a crash or reset in a user region (see LOG_crashRead) */
+
+/* Overflow policies of the asynchronous mode */
+#define LOG_OVERFLOW_DROP   0
+#define LOG_OVERFLOW_BLOCK  1
+
+/* Flush policies of the log file (LOG_FLUSH_ALWAYS or an OR of the others) */
+#define LOG_FLUSH_ALWAYS    0
+#define LOG_FLUSH_ON_ERROR  1
+#define LOG_FLUSH_EVERY_N   2
+#define LOG_FLUSH_EVERY_MS  4
+
+/* Serialization of the LOG_KV records */
+#define LOG_KV_JSON         0   /* JSON lines to the text sinks */
+#define LOG_KV_TLV          1   /* TLV records in the binary log (LOG_binOpen, decoded to JSON lines) */
+
+/* Types of the LOG_KV fields (also their TLV type byte) */
+#define LOG_KV_UINT         'u'
+#define LOG_KV_INT          'i'
+#define LOG_KV_STR          's'
+#define LOG_KV_BOOL         'b'
+
+/* Time prefix of the text messages */
+#define LOG_TIME_DATE           0
+#define LOG_TIME_RAW_REALTIME   1
+#define LOG_TIME_RAW_MONOTONIC  2
+
 typedef enum
 {
+    debug ,
     info ,
     warning ,
     error
 }LOG_enuSeverityLevel_t;
 
+/* Per call site state of LOG_BIN (the format id in the current binary log) */
+typedef struct
+{
+    atomic_int generation;
+    int id;
+    int argCount;
+    char argTypes[LOG_CFG_BIN_MAX_ARGS];
+}LOG_strBinSite_t;
+
+/**
+ * @brief Log a message in binary form (see LOG_binOpen): the format string is stored once,
+ *        then each call only stores its id, a timestamp and the raw arguments
+ *        (no formatting on the caller's thread, decode offline with LOG_decode)
+ * 
+ * Example: LOG_BIN(warning, "pin %d of port %s is stuck", pin, portName);
+*/
+#define LOG_BIN(severity, message, ...)                                             \
+    do                                                                              \
+    {                                                                               \
+        static LOG_strBinSite_t log_bin_site_;                                      \
+        LOG_binWrite(&log_bin_site_, (severity), message, ##__VA_ARGS__);           \
+    } while(0)
+
+/* Sink formatter: decorates the record formatted once by LOG_write ("[time] message\n"),
+   returns the length of the text written to buffer ('\0' terminated)
+   (not called for the records without a time prefix: the LOG_KV JSON lines reach the sinks unchanged) */
+typedef int (*LOG_formatter_t)(char* buffer, int size, LOG_enuSeverityLevel_t severity, const char* text, int timeLength, int length);
+
+/* Callback sink: gets the text of every accepted message (from the logging threads in synchronous mode) */
+typedef void (*LOG_sinkCallback_t)(void* context, LOG_enuSeverityLevel_t severity, const char* text, int length);
+
+typedef struct
+{
+    int type;                           /* LOG_SINK_xxx */
+    LOG_enuSeverityLevel_t minSeverity;
+    LOG_formatter_t formatter;          /* NULL: the record as formatted, or LOG_formatSeverity, LOG_formatMessage ... */
+    LOG_sinkCallback_t callback;        /* LOG_SINK_CALLBACK */
+    void* context;                      /* LOG_SINK_CALLBACK: passed to the callback */
+    char* buffer;                       /* LOG_SINK_MEMORY, LOG_SINK_CRASH: the ring */
+    size_t size;                        /* LOG_SINK_MEMORY, LOG_SINK_CRASH: size of the ring */
+}LOG_strSink_t;
+
+/* A record read back from a crash ring */
+typedef struct
+{
+    unsigned long long sequence;        /* number of the record since the ring was created */
+    LOG_enuSeverityLevel_t severity;
+    int length;
+    char text[LOG_CFG_CRASH_RECORD_SIZE];
+}LOG_strCrashRecord_t;
+
+/* A field of a LOG_KV record (built by the K_xxx macros, the strings must stay valid during the call) */
+typedef struct
+{
+    const char* key;
+    int type;                           /* LOG_KV_xxx */
+    union
+    {
+        unsigned long long u;
+        long long i;
+        const char* s;
+    }value;
+}LOG_strKvField_t;
+
+#define K_U32(key, v)               {(key), LOG_KV_UINT, {.u = (unsigned int)(v)}}
+#define K_U64(key, v)               {(key), LOG_KV_UINT, {.u = (unsigned long long)(v)}}
+#define K_I32(key, v)               {(key), LOG_KV_INT, {.i = (int)(v)}}
+#define K_I64(key, v)               {(key), LOG_KV_INT, {.i = (long long)(v)}}
+#define K_BOOL(key, v)              {(key), LOG_KV_BOOL, {.u = ((v) != 0)}}
+#define K_STR(key, v)               {(key), LOG_KV_STR, {.s = (v)}}
+
+/**
+ * @brief Log a structured record: an event name and typed fields, serialized without formatting
+ *        as a JSON line or a TLV record (LOG_setKvFormat)
+ * 
+ * Example: LOG_KV(warning, "pin_stuck", K_U32("pin", pin), K_STR("port", portName));
+*/
+#define LOG_KV(severity, event, ...)                                                \
+    do                                                                              \
+    {                                                                               \
+        const LOG_strKvField_t log_kv_fields_[] = {{NULL, 0, {0}}, ##__VA_ARGS__};  \
+        LOG_kvWrite((severity), (event), log_kv_fields_ + 1,                        \
+                    (int)(sizeof(log_kv_fields_) / sizeof(log_kv_fields_[0])) - 1); \
+    } while(0)
+
+/* Effective runtime level of each module: the higher of its own level and the global one
+   (kept by LOG_setSeverity and LOG_setModuleSeverity) */
+extern unsigned char LOG_moduleLevel[LOG_CFG_MODULES];
+
+/**
+ * @brief Check a module's effective runtime level (no call, no argument evaluation)
+ * 
+ * @param[in] module  : the module (LOG_MOD_xxx, an unknown module uses LOG_MOD_DEFAULT)
+ * @param[in] severity: the message's severity level
+ * 
+ * @return non zero if the message passes the module's level and the global level
+*/
+static inline int LOG_isEnabled(int module, LOG_enuSeverityLevel_t severity)
+{
+    return (unsigned int)severity >= LOG_moduleLevel[((unsigned int)module < LOG_CFG_MODULES) ? module : LOG_MOD_DEFAULT];
+}
+
+/**
+ * @brief Log a message of a module: removed at compile time below LOG_CFG_COMPILE_LEVEL,
+ *        otherwise the module's level and the global level of LOG_setSeverity are checked
+ *        before the arguments are evaluated (a disabled message costs no call)
+ * 
+ * Example: LOG_INFO(LOG_MOD_APP, "button %d pressed", index);
+*/
+#define LOG_AT(severity, module, ...)                                               \
+    do                                                                              \
+    {                                                                               \
+        if(((severity) >= LOG_CFG_COMPILE_LEVEL) && LOG_isEnabled((module), (severity))) \
+        {                                                                           \
+            LOG_write((severity), __VA_ARGS__);                                     \
+        }                                                                           \
+    } while(0)
+
+#define LOG_DEBUG(module, ...)      LOG_AT(debug, module, __VA_ARGS__)
+#define LOG_INFO(module, ...)       LOG_AT(info, module, __VA_ARGS__)
+#define LOG_WARNING(module, ...)    LOG_AT(warning, module, __VA_ARGS__)
+#define LOG_ERROR(module, ...)      LOG_AT(error, module, __VA_ARGS__)
 
 /**
- * @brief Select where to generate log messages
+ * @brief Select where to generate log messages (sink 0)
  * 
  * @param[in] outputChannel: LOG_OUT_FILE: log the messages in a file
  *                           LOG_OUT_CONSOLE: log the messages to the console
@@ -24,6 +184,7 @@ void LOG_setOutputChannel(int outputChannel);
 
 /**
  * @brief Select the file to log to (in case the output channel is set to LOG_OUT_FILE)
+ *        (same as LOG_fileOpen without user buffer and rotation)
  * 
  * @param[in] fileName: the name of the file to log messages to
  * 
@@ -31,6 +192,52 @@ void LOG_setOutputChannel(int outputChannel);
 */
 void LOG_fileCfg(char* fileName);
 
+/**
+ * @brief Open the log file of the LOG_OUT_FILE channel (appends, closes the previous file)
+ * 
+ * @param[in] fileName  : the name of the file to log messages to
+ * @param[in] buffer    : stdio buffer of the file, split in two halves so the next file can be
+ *                        opened while the rotated one is still being closed (NULL: allocated by stdio)
+ * @param[in] bufferSize: size of the buffer in bytes
+ * @param[in] maxBytes  : rotate once the file reaches this size (0: no rotation)
+ * @param[in] maxFiles  : number of rotated files kept: name.1 (newest) ... name.maxFiles (oldest)
+ * 
+ * @return 0 on success, -1 if the file could not be opened or the parameters are invalid
+*/
+int LOG_fileOpen(const char* fileName, char* buffer, size_t bufferSize, long maxBytes, int maxFiles);
+
+/**
+ * @brief Select when the log file is flushed (between flushes the records stay in the file buffer)
+ * 
+ * @param[in] policy      : LOG_FLUSH_ALWAYS: after every message (synchronous mode) or batch (asynchronous mode)
+ *                          or any combination of:
+ *                          LOG_FLUSH_ON_ERROR : after every error message
+ *                          LOG_FLUSH_EVERY_N  : every everyRecords messages
+ *                          LOG_FLUSH_EVERY_MS : everyMs milliseconds after the first unflushed message
+ *                                               (checked at each message, and by the writer thread while idle)
+ *                          (only when the buffer is full if none applies)
+ * @param[in] everyRecords: the number of messages of LOG_FLUSH_EVERY_N
+ * @param[in] everyMs     : the period of LOG_FLUSH_EVERY_MS
+ * 
+ * @return 0 on success, -1 for an invalid policy
+*/
+int LOG_fileSetFlushPolicy(int policy, int everyRecords, int everyMs);
+
+/**
+ * @brief Flush the log file now
+ * 
+ * @return
+*/
+void LOG_fileFlush(void);
+
+/**
+ * @brief Close the log file (after writing the queued messages if the asynchronous mode is on)
+ *        (also done at exit)
+ * 
+ * @return
+*/
+void LOG_fileClose(void);
+
 /**
  * @brief display message on the output channel according to the set severity level
  *         (if no minimum severity level is set then all messages are displayed)
@@ -51,4 +258,189 @@ void LOG_write(LOG_enuSeverityLevel_t severity, const char* message, ...);
 */
 void LOG_setSeverity(LOG_enuSeverityLevel_t severity);
 
+/**
+ * @brief Add a sink: every text message of at least its minimum severity is written to it too
+ *        (sinks are meant to be set up before logging, a removed slot may be reused by the next add)
+ * 
+ * Example (errors on the console, everything in a file):
+ *     LOG_setOutputChannel(LOG_OUT_FILE);
+ *     LOG_addSink(&(LOG_strSink_t){.type = LOG_SINK_CONSOLE, .minSeverity = error, .formatter = LOG_formatSeverity});
+ * 
+ * @param[in] sink: the sink settings (copied)
+ * 
+ * @return the sink id, -1 if the settings are invalid or the table is full (LOG_CFG_MAX_SINKS)
+*/
+int LOG_addSink(const LOG_strSink_t* sink);
+
+/**
+ * @brief Remove a sink (sink 0 is the output channel: LOG_setOutputChannel adds it back)
+ * 
+ * @param[in] sink: the sink id
+ * 
+ * @return
+*/
+void LOG_removeSink(int sink);
+
+/**
+ * @brief Select the minimum severity level of a sink
+ * 
+ * @param[in] sink    : the sink id (0: the output channel)
+ * @param[in] severity: the minimum severity level
+ * 
+ * @return
+*/
+void LOG_setSinkSeverity(int sink, LOG_enuSeverityLevel_t severity);
+
+/**
+ * @brief Copy the newest complete lines held by a memory sink
+ * 
+ * @param[in]  sink  : the sink id of a LOG_SINK_MEMORY sink
+ * @param[out] buffer: receives the lines, '\0' terminated
+ * @param[in]  size  : size of the buffer
+ * 
+ * @return the number of characters copied (0 if the sink is not a memory sink)
+*/
+size_t LOG_readMemorySink(int sink, char* buffer, size_t size);
+
+/**
+ * @brief Read the newest records of a crash ring, e.g. after a reset
+ *        (may run while the ring is still written: records overwritten during the copy are skipped)
+ * 
+ * A LOG_SINK_CRASH sink keeps fixed size records in its region (8 bytes aligned), written
+ * without lock on the caller's thread: on target the region can be a .noinit RAM section,
+ * on the host an mmap'd file. The sink keeps the records of a valid ring found in its region.
+ * 
+ * @param[in]  region : the region given to the LOG_SINK_CRASH sink
+ * @param[in]  size   : size of the region
+ * @param[out] records: receives the records, oldest first
+ * @param[in]  count  : the maximum number of records to read
+ * 
+ * @return the number of records read, -1 if the region holds no valid ring
+*/
+int LOG_crashRead(const void* region, size_t size, LOG_strCrashRecord_t* records, int count);
+
+/* Sink formatters: "[time] ERROR: message" and "message" */
+int LOG_formatSeverity(char* buffer, int size, LOG_enuSeverityLevel_t severity, const char* text, int timeLength, int length);
+int LOG_formatMessage(char* buffer, int size, LOG_enuSeverityLevel_t severity, const char* text, int timeLength, int length);
+
+/**
+ * @brief Select the minimum severity level of a module (checked by the LOG_xxx macros)
+ * 
+ * @param[in] module  : the module (LOG_MOD_xxx)
+ * @param[in] severity: the minimum severity level
+ * 
+ * @return
+*/
+void LOG_setModuleSeverity(int module, LOG_enuSeverityLevel_t severity);
+
+/**
+ * @brief Limit the rate of the messages of each call site (LOG_write format string)
+ *        (the dropped ones are counted and reported before the next written message of the site)
+ * 
+ * @param[in] messagesPerSecond: the sustained rate of a call site, 0 for no limit
+ * @param[in] burst            : the number of messages a quiet call site may write at once
+ * 
+ * @return
+*/
+void LOG_setRateLimit(int messagesPerSecond, int burst);
+
+/**
+ * @brief Select the repeat window: a message identical to the previous one of its call site is not
+ *        written again within the window, the number of copies is written instead with the next
+ *        different message, or once the window expires (by the next LOG_write, or the writer
+ *        thread in asynchronous mode)
+ * 
+ * @param[in] milliseconds: the window, 0 to write all the repeats
+ * 
+ * @return
+*/
+void LOG_setRepeatWindow(int milliseconds);
+
+/**
+ * @brief Select how the LOG_KV records are serialized
+ * 
+ * @param[in] format: LOG_KV_JSON: a JSON line to the text sinks
+ *                    LOG_KV_TLV : a TLV record to the binary log (dropped while it is not open)
+ * 
+ * @return
+*/
+void LOG_setKvFormat(int format);
+
+/**
+ * @brief Structured logging backend of LOG_KV (use the macro)
+ * 
+ * @param[in] severity: the record's severity level
+ * @param[in] event   : the event name
+ * @param[in] fields  : the fields
+ * @param[in] count   : the number of fields
+ * 
+ * @return
+*/
+void LOG_kvWrite(LOG_enuSeverityLevel_t severity, const char* event, const LOG_strKvField_t* fields, int count);
+
+/**
+ * @brief Select the time prefix of the text messages
+ * 
+ * @param[in] mode: LOG_TIME_DATE         : "[Mon Oct 19 10:17:47.123456 2026] " local wall clock
+ *                  LOG_TIME_RAW_REALTIME : "[1697710667.123456] " seconds since the epoch
+ *                  LOG_TIME_RAW_MONOTONIC: "[5123.123456] " seconds of the monotonic clock
+ * 
+ * @return
+*/
+void LOG_setTimeMode(int mode);
+
+/**
+ * @brief Start the asynchronous mode: LOG_write formats the message into a lock-free ring
+ *        and a writer thread drains it in batches to the output channel
+ * 
+ * @param[in] overflowPolicy: LOG_OVERFLOW_DROP : drop (and count) messages when the ring is full
+ *                            LOG_OVERFLOW_BLOCK: wait for a free record when the ring is full
+ * 
+ * @return 0 on success, -1 if already started or the writer thread could not be created
+*/
+int LOG_startAsync(int overflowPolicy);
+
+/**
+ * @brief Stop the asynchronous mode: write all the queued messages then stop the writer thread
+ *        (LOG_write is synchronous again afterwards)
+ * 
+ * @return
+*/
+void LOG_stopAsync(void);
+
+/**
+ * @brief Get the number of messages dropped because the ring was full (LOG_OVERFLOW_DROP)
+ * 
+ * @return the number of dropped messages since the program started
+*/
+unsigned long LOG_getDroppedCount(void);
+
+/**
+ * @brief Open the binary log written by LOG_BIN (truncates the file)
+ *        (should be called before logging starts, LOG_BIN messages are dropped while no file is open)
+ * 
+ * @param[in] fileName: the name of the binary log file
+ * 
+ * @return 0 on success, -1 if the file could not be opened
+*/
+int LOG_binOpen(const char* fileName);
+
+/**
+ * @brief Close the binary log (after writing the queued messages if the asynchronous mode is on)
+ * 
+ * @return
+*/
+void LOG_binClose(void);
+
+/**
+ * @brief Binary logging backend of LOG_BIN (use the macro, it provides the call site state)
+ * 
+ * @param[in] site    : the call site state
+ * @param[in] severity: the message's severity level
+ * @param[in] message : the format string (must stay valid: string literal)
+ * 
+ * @return
+*/
+void LOG_binWrite(LOG_strBinSite_t* site, LOG_enuSeverityLevel_t severity, const char* message, ...);
+
 #endif
\ No newline at end of file
@@ -0,0 +1,338 @@
+/*
+ * Throughput and latency benchmark of LOG_write, and of the LOG_format formatter against libc
+ *
+ * Build: gcc -O2 -pthread -o log_bench LOG_bench.c LOG.c LOG_bin.c LOG_file.c LOG_sink.c LOG_crash.c
+ *            LOG_limit.c LOG_fmt.c LOG_kv.c
+ * Usage: log_bench [-m modes] [-t max threads] [-n calls per thread] [-a] [-o results]
+ *
+ *   -m : comma separated modes (default null,filtered,file)
+ *          null     : formatted and given to a sink that discards it
+ *          filtered : below the minimum severity (the cost of a disabled message)
+ *          file     : the buffered log file log_bench.log
+ *          console  : stdout (redirect it: log_bench -m console > /dev/null)
+ *          format   : LOG_format of the same message into a local buffer (no LOG_write)
+ *          snprintf : libc snprintf of the same message into a local buffer (no LOG_write)
+ *   -t : threads run 1, 2, 4 ... up to this number (default 4)
+ *   -n : LOG_write calls per thread (default 100000)
+ *   -a : also run every LOG_write case in asynchronous mode
+ *   -o : JSON lines results, one per case (default log_bench.jsonl)
+ *
+ * The rate limit and the repeat check are turned off. Latencies are per call, measured
+ * with the monotonic clock (its own cost is reported as timer_ns), throughput is the
+ * number of calls over the time from the first thread's first call to the last thread's
+ * last call (before the asynchronous writer drains).
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+
+#include "LOG.h"
+#include "LOG_fmt.h"
+
+#define MODE_NULL           0
+#define MODE_FILTERED       1
+#define MODE_FILE           2
+#define MODE_CONSOLE        3
+#define MODE_FORMAT         4
+#define MODE_SNPRINTF       5
+#define MODES               6
+
+#define FILE_NAME           "log_bench.log"
+
+/* The message of every mode */
+#define BENCH_MESSAGE       "bench thread %d call %d value %u name %s"
+
+static const char* const gl_mode_names[MODES] = {"null", "filtered", "file", "console", "format", "snprintf"};
+
+static int gl_calls = 100000;
+static pthread_barrier_t gl_start;
+
+/* One thread's latencies and run time (nanoseconds) */
+typedef struct
+{
+    pthread_t thread;
+    int index;
+    int mode;
+    LOG_enuSeverityLevel_t severity;
+    long long* latencies;
+    long long first;                    /* before the first call */
+    long long last;                     /* after the last call */
+}LOG_strBenchThread_t;
+
+static long long now_ns(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (long long)now.tv_sec * 1000000000LL + now.tv_nsec;
+}
+
+static void discard(void* context, LOG_enuSeverityLevel_t severity, const char* text, int length)
+{
+    (void)context;
+    (void)severity;
+    (void)text;
+    (void)length;
+}
+
+static int compare(const void* a, const void* b)
+{
+    long long x = *(const long long*)a;
+    long long y = *(const long long*)b;
+
+    return (x > y) - (x < y);
+}
+
+static void* bench_thread(void* arg)
+{
+    LOG_strBenchThread_t* self = (LOG_strBenchThread_t*)arg;
+    char buffer[256];
+    long long start;
+    int i;
+
+    pthread_barrier_wait(&gl_start);
+
+    self->first = now_ns();
+
+    for(i = 0; i < gl_calls; i++)
+    {
+        start = now_ns();
+        if(self->mode == MODE_FORMAT)
+        {
+            (void)LOG_format(buffer, sizeof(buffer), BENCH_MESSAGE, self->index, i, i * 7u, "sensor");
+        }
+        else if(self->mode == MODE_SNPRINTF)
+        {
+            (void)snprintf(buffer, sizeof(buffer), BENCH_MESSAGE, self->index, i, i * 7u, "sensor");
+        }
+        else
+        {
+            LOG_write(self->severity, BENCH_MESSAGE, self->index, i, i * 7u, "sensor");
+        }
+        self->latencies[i] = now_ns() - start;
+    }
+
+    self->last = now_ns();
+
+    return NULL;
+}
+
+/* Measure the clock_gettime pair around a call, reported with the results */
+static long long timer_cost(void)
+{
+    long long start = now_ns();
+    long long sink = 0;
+    int i;
+
+    for(i = 0; i < 100000; i++)
+    {
+        sink += now_ns();
+    }
+
+    return (now_ns() - start + (sink & 1)) / 100000;
+}
+
+/* Select the output of a mode, returns the severity the threads log with */
+static LOG_enuSeverityLevel_t set_mode(int mode, int* nullSink)
+{
+    LOG_enuSeverityLevel_t severity = info;
+
+    if(*nullSink >= 0)
+    {
+        LOG_removeSink(*nullSink);
+        *nullSink = -1;
+    }
+
+    if((mode == MODE_NULL) || (mode == MODE_FILTERED))
+    {
+        LOG_removeSink(0);
+        *nullSink = LOG_addSink(&(LOG_strSink_t){.type = LOG_SINK_CALLBACK, .minSeverity = debug, .callback = discard});
+        severity = (mode == MODE_FILTERED) ? debug : info;
+    }
+    else if(mode == MODE_FILE)
+    {
+        LOG_fileOpen(FILE_NAME, NULL, 0, 0, 0);
+        LOG_fileSetFlushPolicy(LOG_FLUSH_ON_ERROR, 0, 0);
+        LOG_setOutputChannel(LOG_OUT_FILE);
+    }
+    else if(mode == MODE_CONSOLE)
+    {
+        LOG_setOutputChannel(LOG_OUT_CONSOLE);
+    }
+    else
+    {
+        /* the formatters alone: no output */
+    }
+
+    return severity;
+}
+
+static void run_case(FILE* results, int mode, int async, int threads, long long timer)
+{
+    static int nullSink = -1;
+    LOG_strBenchThread_t* list = calloc((size_t)threads, sizeof(LOG_strBenchThread_t));
+    long long* all = malloc((size_t)threads * (size_t)gl_calls * sizeof(long long));
+    LOG_enuSeverityLevel_t severity = set_mode(mode, &nullSink);
+    long long total = (long long)threads * gl_calls;
+    long long start;
+    long long end;
+    long long elapsed;
+    long long drained;
+    int i;
+
+    if((list == NULL) || (all == NULL))
+    {
+        fprintf(stderr, "out of memory\n");
+        exit(1);
+    }
+
+    if(async)
+    {
+        LOG_startAsync(LOG_OVERFLOW_BLOCK);
+    }
+
+    pthread_barrier_init(&gl_start, NULL, (unsigned int)threads + 1);
+
+    for(i = 0; i < threads; i++)
+    {
+        list[i].index = i;
+        list[i].mode = mode;
+        list[i].severity = severity;
+        list[i].latencies = all + (size_t)i * (size_t)gl_calls;
+        pthread_create(&list[i].thread, NULL, bench_thread, &list[i]);
+    }
+
+    pthread_barrier_wait(&gl_start);
+
+    for(i = 0; i < threads; i++)
+    {
+        pthread_join(list[i].thread, NULL);
+    }
+
+    /* the threads' own clocks: the barrier may release them long before this thread runs again */
+    start = list[0].first;
+    end = list[0].last;
+    for(i = 1; i < threads; i++)
+    {
+        start = (list[i].first < start) ? list[i].first : start;
+        end = (list[i].last > end) ? list[i].last : end;
+    }
+    elapsed = end - start;
+
+    /* the queued messages are not part of the callers' cost, only of the total */
+    LOG_stopAsync();
+    LOG_fileFlush();
+    drained = now_ns() - start;
+
+    pthread_barrier_destroy(&gl_start);
+
+    qsort(all, (size_t)total, sizeof(long long), compare);
+
+    fprintf(results, "{\"mode\":\"%s\",\"async\":%d,\"threads\":%d,\"calls\":%lld,\"calls_per_sec\":%.0f,"
+                     "\"total_sec\":%.6f,\"p50_ns\":%lld,\"p99_ns\":%lld,\"p999_ns\":%lld,\"max_ns\":%lld,\"timer_ns\":%lld}\n",
+            gl_mode_names[mode], async, threads, total, (double)total * 1e9 / (double)elapsed, (double)drained / 1e9,
+            all[total / 2], all[total * 99 / 100], all[total * 999 / 1000], all[total - 1], timer);
+
+    fprintf(stderr, "%-8s %-5s %2d threads: %12.0f calls/s  p50 %6lld ns  p99 %7lld ns  p999 %8lld ns\n",
+            gl_mode_names[mode], async ? "async" : "sync", threads, (double)total * 1e9 / (double)elapsed,
+            all[total / 2], all[total * 99 / 100], all[total * 999 / 1000]);
+
+    free(all);
+    free(list);
+}
+
+int main(int argc, char* argv[])
+{
+    const char* modes = "null,filtered,file";
+    const char* output = "log_bench.jsonl";
+    int maxThreads = 4;
+    int async = 0;
+    int valid = 1;
+    int selected[MODES] = {0, 0, 0, 0, 0, 0};
+    FILE* results;
+    long long timer;
+    int mode;
+    int threads;
+    int i;
+
+    for(i = 1; (i < argc) && valid; i++)
+    {
+        if((strcmp(argv[i], "-m") == 0) && (i + 1 < argc))
+        {
+            modes = argv[++i];
+        }
+        else if((strcmp(argv[i], "-t") == 0) && (i + 1 < argc))
+        {
+            maxThreads = atoi(argv[++i]);
+        }
+        else if((strcmp(argv[i], "-n") == 0) && (i + 1 < argc))
+        {
+            gl_calls = atoi(argv[++i]);
+        }
+        else if(strcmp(argv[i], "-a") == 0)
+        {
+            async = 1;
+        }
+        else if((strcmp(argv[i], "-o") == 0) && (i + 1 < argc))
+        {
+            output = argv[++i];
+        }
+        else
+        {
+            valid = 0;
+        }
+    }
+
+    for(mode = 0; mode < MODES; mode++)
+    {
+        const char* found = strstr(modes, gl_mode_names[mode]);
+        size_t length = strlen(gl_mode_names[mode]);
+
+        selected[mode] = (found != NULL) && ((found == modes) || (found[-1] == ','))
+                      && ((found[length] == '\0') || (found[length] == ','));
+    }
+
+    if(!valid || (maxThreads < 1) || (gl_calls < 1))
+    {
+        fprintf(stderr, "usage: %s [-m null,filtered,file,console,format,snprintf] [-t max threads] [-n calls per thread] [-a] [-o results]\n", argv[0]);
+        return 1;
+    }
+
+    if((results = fopen(output, "w")) == NULL)
+    {
+        perror(output);
+        return 1;
+    }
+
+    LOG_setRateLimit(0, 0);
+    LOG_setRepeatWindow(0);
+    LOG_setSeverity(info);
+
+    timer = timer_cost();
+
+    for(mode = 0; mode < MODES; mode++)
+    {
+        /* 1, 2, 4 ... then maxThreads */
+        threads = 1;
+        while(selected[mode] && (threads <= maxThreads))
+        {
+            run_case(results, mode, 0, threads, timer);
+
+            /* the formatters do not depend on the LOG mode */
+            if(async && (mode != MODE_FORMAT) && (mode != MODE_SNPRINTF))
+            {
+                run_case(results, mode, 1, threads, timer);
+            }
+
+            threads = (threads == maxThreads) ? (maxThreads + 1) : ((threads * 2 < maxThreads) ? (threads * 2) : maxThreads);
+        }
+    }
+
+    LOG_fileClose();
+    fclose(results);
+
+    return 0;
+}
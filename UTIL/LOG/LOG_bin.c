@@ -0,0 +1,560 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <time.h>
+
+#include "LOG_bin.h"
+#include "LOG_cfg.h"
+
+#define SPEC_MAX            32
+#define DECODE_MAX_ARGS     32
+
+/* One stored argument, read back from the stream */
+typedef union
+{
+    int i;
+    long l;
+    long long q;
+    size_t z;
+    intmax_t j;
+    ptrdiff_t t;
+    void* p;
+    double d;
+    long double D;
+}LOG_uniArg_t;
+
+static const char* parse_spec(const char* p, char* argTypes, int* count, int maxArgs);
+static int read_varint(FILE* in, unsigned long long* value);
+static int decode_kv(FILE* in, FILE* out, unsigned long long count, long long startSec, unsigned int startUsec);
+static int read_json_string(FILE* in, FILE* out);
+static int print_spec(FILE* out, const char* spec, char type, const int* stars, int starCount, const LOG_uniArg_t* arg, const char* str);
+
+/**
+ * @brief Get the argument types a printf format string expects (including '*' width/precision)
+ * 
+ * @param[in]  message : the format string
+ * @param[out] argTypes: the type code of each argument (LOG_BIN_ARG_xxx)
+ * @param[in]  maxArgs : the size of argTypes
+ * 
+ * @return the number of arguments, -1 if the format is not supported or has more than maxArgs arguments
+*/
+int LOG_binParseFormat(const char* message, char* argTypes, int maxArgs)
+{
+    int count = 0;
+    const char* p = message;
+
+    while((p != NULL) && (*p != '\0'))
+    {
+        if(*p != '%')
+        {
+            p++;
+        }
+        else if(p[1] == '%')
+        {
+            p += 2;
+        }
+        else
+        {
+            p = parse_spec(p + 1, argTypes, &count, maxArgs);
+        }
+    }
+
+    return (p == NULL) ? -1 : count;
+}
+
+/**
+ * @brief Get the ABI description written in the binary log header: byte order (1: little endian),
+ *        then the sizes of int, long, long long, size_t, intmax_t, ptrdiff_t, void*, double and long double
+ * 
+ * @param[out] abi: the description (LOG_BIN_ABI_SIZE bytes)
+ * 
+ * @return
+*/
+void LOG_binGetAbi(unsigned char* abi)
+{
+    const unsigned int one = 1;
+
+    abi[0] = *(const unsigned char*)&one;
+    abi[1] = (unsigned char)sizeof(int);
+    abi[2] = (unsigned char)sizeof(long);
+    abi[3] = (unsigned char)sizeof(long long);
+    abi[4] = (unsigned char)sizeof(size_t);
+    abi[5] = (unsigned char)sizeof(intmax_t);
+    abi[6] = (unsigned char)sizeof(ptrdiff_t);
+    abi[7] = (unsigned char)sizeof(void*);
+    abi[8] = (unsigned char)sizeof(double);
+    abi[9] = (unsigned char)sizeof(long double);
+}
+
+/**
+ * @brief Decode a binary log stream back to text lines ("[date time.us] message")
+ * 
+ * @param[in] in : the binary stream (opened in binary mode)
+ * @param[in] out: the text output
+ * 
+ * @return the number of decoded messages, -1 if the stream is not a valid binary log (or was written
+ *         on a different ABI)
+*/
+long LOG_binDecode(FILE* in, FILE* out)
+{
+    char magic[4];
+    unsigned char version;
+    unsigned char abi[LOG_BIN_ABI_SIZE];
+    unsigned char ownAbi[LOG_BIN_ABI_SIZE];
+    long long startSec;
+    unsigned int startUsec;
+    char** formats = NULL;
+    unsigned long long formatCount = 0;
+    long messages = 0;
+    int tag;
+    int valid = 1;
+
+    LOG_binGetAbi(ownAbi);
+
+    if((fread(magic, 1, 4, in) != 4) || (memcmp(magic, LOG_BIN_MAGIC, 4) != 0)
+    || (fread(&version, 1, 1, in) != 1) || (version != LOG_BIN_VERSION)
+    || (fread(abi, 1, LOG_BIN_ABI_SIZE, in) != LOG_BIN_ABI_SIZE) || (memcmp(abi, ownAbi, LOG_BIN_ABI_SIZE) != 0)
+    || (fread(&startSec, sizeof(startSec), 1, in) != 1) || (fread(&startUsec, sizeof(startUsec), 1, in) != 1))
+    {
+        valid = 0;
+    }
+
+    while(valid && ((tag = fgetc(in)) != EOF))
+    {
+        unsigned long long id;
+        unsigned long long value;
+
+        if(!read_varint(in, &id))
+        {
+            valid = 0;
+        }
+        else if(tag == LOG_BIN_TAG_FORMAT)
+        {
+            /* ids are given in order starting at 1: a new id is the next slot */
+            int known = (id < formatCount);
+            char** grown = NULL;
+            char* text = NULL;
+
+            if((id == 0) || (id > formatCount + (formatCount == 0)))
+            {
+                valid = 0;
+            }
+            else if((grown = known ? formats : realloc(formats, (size_t)(id + 1) * sizeof(char*))) == NULL)
+            {
+                valid = 0;
+            }
+            else
+            {
+                formats = grown;
+                while(formatCount <= id)
+                {
+                    formats[formatCount++] = NULL;
+                }
+
+                if(read_varint(in, &value) && (value <= LOG_CFG_RECORD_SIZE)
+                && ((text = malloc((size_t)value + 1)) != NULL) && (fread(text, 1, (size_t)value, in) == value))
+                {
+                    text[value] = '\0';
+                    free(formats[id]);
+                    formats[id] = text;
+                }
+                else
+                {
+                    free(text);
+                    valid = 0;
+                }
+            }
+        }
+        else if(tag == LOG_BIN_TAG_KV)
+        {
+            /* id: the field count */
+            if(decode_kv(in, out, id, startSec, startUsec))
+            {
+                messages++;
+            }
+            else
+            {
+                valid = 0;
+            }
+        }
+        else if((tag == LOG_BIN_TAG_MESSAGE) && (id < formatCount) && (formats[id] != NULL))
+        {
+            const char* p = formats[id];
+            char types[DECODE_MAX_ARGS];
+            int count = LOG_binParseFormat(p, types, DECODE_MAX_ARGS);
+            int severity = fgetc(in);
+            int next = 0;
+            time_t seconds;
+            struct tm date;
+            char dateStr[32];
+
+            if((count < 0) || (severity == EOF) || !read_varint(in, &value))
+            {
+                valid = 0;
+            }
+            else
+            {
+                seconds = (time_t)(startSec + (long long)((startUsec + value) / 1000000ULL));
+                localtime_r(&seconds, &date);
+                strftime(dateStr, sizeof(dateStr), "%Y-%m-%d %H:%M:%S", &date);
+                fprintf(out, "[%s.%06llu] ", dateStr, (startUsec + value) % 1000000ULL);
+            }
+
+            /* copy the text and print every conversion with its stored argument */
+            while(valid && (*p != '\0'))
+            {
+                if(*p != '%')
+                {
+                    fputc(*p++, out);
+                }
+                else if(p[1] == '%')
+                {
+                    fputc('%', out);
+                    p += 2;
+                }
+                else
+                {
+                    char specTypes[3];
+                    int specCount = 0;
+                    const char* end = parse_spec(p + 1, specTypes, &specCount, 3);
+                    char spec[SPEC_MAX];
+                    int stars[2] = {0, 0};
+                    int s;
+                    LOG_uniArg_t arg;
+                    char* str = NULL;
+
+                    for(s = 0; (s < specCount) && valid; s++)
+                    {
+                        char type = types[next++];
+
+                        if(type == LOG_BIN_ARG_STRING)
+                        {
+                            if(read_varint(in, &value) && (value <= LOG_CFG_RECORD_SIZE)
+                            && ((str = malloc((size_t)value + 1)) != NULL) && (fread(str, 1, (size_t)value, in) == value))
+                            {
+                                str[value] = '\0';
+                            }
+                            else
+                            {
+                                valid = 0;
+                            }
+                        }
+                        else
+                        {
+                            size_t size = (type == LOG_BIN_ARG_INT) ? sizeof(int) :
+                                          (type == LOG_BIN_ARG_LONG) ? sizeof(long) :
+                                          (type == LOG_BIN_ARG_LLONG) ? sizeof(long long) :
+                                          (type == LOG_BIN_ARG_SIZE) ? sizeof(size_t) :
+                                          (type == LOG_BIN_ARG_INTMAX) ? sizeof(intmax_t) :
+                                          (type == LOG_BIN_ARG_PTRDIFF) ? sizeof(ptrdiff_t) :
+                                          (type == LOG_BIN_ARG_PTR) ? sizeof(void*) :
+                                          (type == LOG_BIN_ARG_DOUBLE) ? sizeof(double) : sizeof(long double);
+
+                            if(fread(&arg, 1, size, in) != size)
+                            {
+                                valid = 0;
+                            }
+                            else if(s < specCount - 1)
+                            {
+                                stars[s] = arg.i;
+                            }
+                        }
+                    }
+
+                    if(valid && ((size_t)(end - p) < SPEC_MAX))
+                    {
+                        memcpy(spec, p, (size_t)(end - p));
+                        spec[end - p] = '\0';
+                        print_spec(out, spec, specTypes[specCount - 1], stars, specCount - 1, &arg, str);
+                    }
+
+                    free(str);
+                    p = end;
+                }
+            }
+
+            if(valid)
+            {
+                fputc('\n', out);
+                messages++;
+            }
+        }
+        else
+        {
+            valid = 0;
+        }
+    }
+
+    while(formatCount > 0)
+    {
+        free(formats[--formatCount]);
+    }
+    free(formats);
+
+    return valid ? messages : -1;
+}
+
+/* Parse one conversion (p is just after the '%'), returns the character after it or NULL if unsupported */
+static const char* parse_spec(const char* p, char* argTypes, int* count, int maxArgs)
+{
+    char length = 0;
+    char type = 0;
+
+    /* flags */
+    while((*p != '\0') && (strchr("-+ #0'", *p) != NULL))
+    {
+        p++;
+    }
+
+    /* width */
+    if(*p == '*')
+    {
+        if(*count >= maxArgs)
+        {
+            return NULL;
+        }
+        argTypes[(*count)++] = LOG_BIN_ARG_INT;
+        p++;
+    }
+    else
+    {
+        while((*p >= '0') && (*p <= '9'))
+        {
+            p++;
+        }
+    }
+
+    /* precision */
+    if(*p == '.')
+    {
+        p++;
+        if(*p == '*')
+        {
+            if(*count >= maxArgs)
+            {
+                return NULL;
+            }
+            argTypes[(*count)++] = LOG_BIN_ARG_INT;
+            p++;
+        }
+        else
+        {
+            while((*p >= '0') && (*p <= '9'))
+            {
+                p++;
+            }
+        }
+    }
+
+    /* length modifier */
+    if((*p == 'h') || (*p == 'l'))
+    {
+        length = (*p == 'l') ? 'l' : 0;
+        p++;
+        if(*p == p[-1])
+        {
+            length = (length == 'l') ? 'q' : 0;
+            p++;
+        }
+    }
+    else if((*p == 'z') || (*p == 'j') || (*p == 't') || (*p == 'L'))
+    {
+        length = *p++;
+    }
+
+    switch(*p)
+    {
+    case 'd': case 'i': case 'u': case 'o': case 'x': case 'X': case 'c':
+        type = (length == 0) ? LOG_BIN_ARG_INT :
+               (length == 'L') ? 0 : length;
+        break;
+    case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+        type = (length == 'L') ? LOG_BIN_ARG_LDOUBLE : LOG_BIN_ARG_DOUBLE;
+        break;
+    case 's':
+        type = (length == 0) ? LOG_BIN_ARG_STRING : 0;
+        break;
+    case 'p': case 'n':
+        type = LOG_BIN_ARG_PTR;
+        break;
+    default:
+        type = 0;
+    }
+
+    if((type == 0) || (*count >= maxArgs))
+    {
+        return NULL;
+    }
+
+    argTypes[(*count)++] = type;
+
+    return p + 1;
+}
+
+static int read_varint(FILE* in, unsigned long long* value)
+{
+    int byte;
+    int shift = 0;
+
+    *value = 0;
+    do
+    {
+        byte = fgetc(in);
+        if((byte == EOF) || (shift > 63))
+        {
+            return 0;
+        }
+        *value |= (unsigned long long)(byte & 0x7F) << shift;
+        shift += 7;
+    }
+    while(byte & 0x80);
+
+    return 1;
+}
+
+/* printf one conversion with up to two '*' arguments */
+#define PRINT_ARG(VALUE)                                                        \
+    ((starCount == 0) ? fprintf(out, spec, VALUE) :                             \
+     (starCount == 1) ? fprintf(out, spec, stars[0], VALUE) :                   \
+                        fprintf(out, spec, stars[0], stars[1], VALUE))
+
+static int print_spec(FILE* out, const char* spec, char type, const int* stars, int starCount, const LOG_uniArg_t* arg, const char* str)
+{
+    int ret = 0;
+
+    switch(type)
+    {
+    case LOG_BIN_ARG_INT:     ret = PRINT_ARG(arg->i); break;
+    case LOG_BIN_ARG_LONG:    ret = PRINT_ARG(arg->l); break;
+    case LOG_BIN_ARG_LLONG:   ret = PRINT_ARG(arg->q); break;
+    case LOG_BIN_ARG_SIZE:    ret = PRINT_ARG(arg->z); break;
+    case LOG_BIN_ARG_INTMAX:  ret = PRINT_ARG(arg->j); break;
+    case LOG_BIN_ARG_PTRDIFF: ret = PRINT_ARG(arg->t); break;
+    case LOG_BIN_ARG_DOUBLE:  ret = PRINT_ARG(arg->d); break;
+    case LOG_BIN_ARG_LDOUBLE: ret = PRINT_ARG(arg->D); break;
+    case LOG_BIN_ARG_STRING:  ret = PRINT_ARG(str != NULL ? str : "(null)"); break;
+    case LOG_BIN_ARG_PTR:
+        /* %n has nothing to write back */
+        ret = (spec[strlen(spec) - 1] == 'n') ? 0 : PRINT_ARG(arg->p);
+        break;
+    default:
+        break;
+    }
+
+    return ret;
+}
+
+/* Print a LOG_KV record as the JSON line LOG_KV_JSON writes, returns 0 if the stream is invalid */
+static int decode_kv(FILE* in, FILE* out, unsigned long long count, long long startSec, unsigned int startUsec)
+{
+    static const char* const severities[] = {"debug", "info", "warning", "error"};
+    int valid = 1;
+    int severity = fgetc(in);
+    int type;
+    unsigned long long microseconds;
+    unsigned long long value;
+    unsigned long long i;
+
+    if((severity < 0) || (severity > 3) || !read_varint(in, &microseconds))
+    {
+        valid = 0;
+    }
+    else
+    {
+        microseconds += startUsec;
+        fprintf(out, "{\"ts\":%lld.%06llu,\"sev\":\"%s\",\"event\":",
+                startSec + (long long)(microseconds / 1000000ULL), microseconds % 1000000ULL, severities[severity]);
+        valid = read_json_string(in, out);
+    }
+
+    for(i = 0; valid && (i < count); i++)
+    {
+        type = fgetc(in);
+        fputc(',', out);
+
+        if((type == EOF) || !read_json_string(in, out))
+        {
+            valid = 0;
+        }
+        else
+        {
+            fputc(':', out);
+
+            if(type == 's')
+            {
+                valid = read_json_string(in, out);
+            }
+            else if(!read_varint(in, &value))
+            {
+                valid = 0;
+            }
+            else if(type == 'i')
+            {
+                /* zigzag */
+                fprintf(out, "%lld", (long long)(value >> 1) ^ -(long long)(value & 1));
+            }
+            else if(type == 'b')
+            {
+                fputs(value ? "true" : "false", out);
+            }
+            else
+            {
+                fprintf(out, "%llu", value);
+            }
+        }
+    }
+
+    if(valid)
+    {
+        fputs("}\n", out);
+    }
+
+    return valid;
+}
+
+/* Copy a length prefixed string as a JSON string, returns 0 if the stream is invalid */
+static int read_json_string(FILE* in, FILE* out)
+{
+    int valid = 1;
+    unsigned long long length;
+    unsigned long long i;
+    int c;
+
+    if(!read_varint(in, &length))
+    {
+        valid = 0;
+    }
+    else
+    {
+        fputc('"', out);
+
+        for(i = 0; valid && (i < length); i++)
+        {
+            c = fgetc(in);
+
+            if(c == EOF)
+            {
+                valid = 0;
+            }
+            else if((c == '"') || (c == '\\'))
+            {
+                fputc('\\', out);
+                fputc(c, out);
+            }
+            else if(c < 0x20)
+            {
+                fprintf(out, "\\u%04x", c);
+            }
+            else
+            {
+                fputc(c, out);
+            }
+        }
+
+        fputc('"', out);
+    }
+
+    return valid;
+}
@@ -0,0 +1,77 @@
+#ifndef LOG_BIN_H_
+#define LOG_BIN_H_
+
+#include <stdio.h>
+
+/*
+ * Binary log stream (written by LOG_BIN, read back by LOG_binDecode):
+ *
+ *   header : "LOGB" | version (1 byte) | ABI (LOG_BIN_ABI_SIZE bytes, see LOG_binGetAbi)
+ *            | start time: seconds (8 bytes) | microseconds (4 bytes)
+ *   then any number of records, each starting with a tag byte:
+ *   'F'    : format definition  -> id (varint) | length (varint) | format string (no '\0')
+ *   'M'    : message            -> id (varint) | severity (1 byte) | microseconds since start (varint)
+ *                                  | the arguments, stored verbatim in the writer's native layout
+ *                                    (strings as length (varint) | characters)
+ *   'K'    : LOG_KV record     -> field count (varint) | severity (1 byte) | microseconds since start (varint)
+ *                                  | event: length (varint) | characters
+ *                                  | each field: type (1 byte: LOG_KV_xxx) | key: length (varint) | characters
+ *                                    | value: varint ('u', 'b'), zigzag varint ('i'), length (varint) | characters ('s')
+ *
+ * A format is always defined before the first message using its id (ids are given in order starting at 1).
+ * Lengths are at most LOG_CFG_RECORD_SIZE (a record never spans more).
+ * Fixed size fields and arguments use the native byte order and type sizes: the decoder rejects
+ * a log whose ABI differs from its own.
+ */
+#define LOG_BIN_MAGIC           "LOGB"
+#define LOG_BIN_VERSION         2
+#define LOG_BIN_ABI_SIZE        10
+#define LOG_BIN_TAG_FORMAT      'F'
+#define LOG_BIN_TAG_MESSAGE     'M'
+#define LOG_BIN_TAG_KV          'K'
+
+/* Argument type codes produced by LOG_binParseFormat */
+#define LOG_BIN_ARG_INT         'i'     /* int (also char/short, promoted) */
+#define LOG_BIN_ARG_LONG        'l'     /* long */
+#define LOG_BIN_ARG_LLONG       'q'     /* long long */
+#define LOG_BIN_ARG_SIZE        'z'     /* size_t */
+#define LOG_BIN_ARG_INTMAX      'j'     /* intmax_t */
+#define LOG_BIN_ARG_PTRDIFF     't'     /* ptrdiff_t */
+#define LOG_BIN_ARG_PTR         'p'     /* void* (%p, %n is stored but not written back) */
+#define LOG_BIN_ARG_DOUBLE      'd'     /* double (also float, promoted) */
+#define LOG_BIN_ARG_LDOUBLE     'D'     /* long double */
+#define LOG_BIN_ARG_STRING      's'     /* const char* (the characters are stored) */
+
+/**
+ * @brief Get the argument types a printf format string expects (including '*' width/precision)
+ * 
+ * @param[in]  message : the format string
+ * @param[out] argTypes: the type code of each argument (LOG_BIN_ARG_xxx)
+ * @param[in]  maxArgs : the size of argTypes
+ * 
+ * @return the number of arguments, -1 if the format is not supported or has more than maxArgs arguments
+*/
+int LOG_binParseFormat(const char* message, char* argTypes, int maxArgs);
+
+/**
+ * @brief Get the ABI description written in the binary log header: byte order (1: little endian),
+ *        then the sizes of int, long, long long, size_t, intmax_t, ptrdiff_t, void*, double and long double
+ * 
+ * @param[out] abi: the description (LOG_BIN_ABI_SIZE bytes)
+ * 
+ * @return
+*/
+void LOG_binGetAbi(unsigned char* abi);
+
+/**
+ * @brief Decode a binary log stream back to text lines ("[date time.us] message", LOG_KV records as JSON lines)
+ * 
+ * @param[in] in : the binary stream (opened in binary mode)
+ * @param[in] out: the text output
+ * 
+ * @return the number of decoded messages, -1 if the stream is not a valid binary log (or was written
+ *         on a different ABI)
+*/
+long LOG_binDecode(FILE* in, FILE* out);
+
+#endif
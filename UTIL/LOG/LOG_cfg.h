@@ -0,0 +1,99 @@
+#ifndef LOG_CFG_H_
+#define LOG_CFG_H_
+
+/**
+ * @brief Number of records in the asynchronous ring (must be a power of 2)
+ */
+#define LOG_CFG_RING_RECORDS        1024
+
+/**
+ * @brief Size of one record: formatted message including the time prefix
+ *        (longer messages are truncated)
+ */
+#define LOG_CFG_RECORD_SIZE         256
+
+/**
+ * @brief Maximum number of records the writer thread drains before flushing the output
+ */
+#define LOG_CFG_WRITER_BATCH        64
+
+/**
+ * @brief Maximum number of arguments of a LOG_BIN message (formats with more are logged as text)
+ */
+#define LOG_CFG_BIN_MAX_ARGS        16
+
+/**
+ * @brief Format the text messages with the integer-only formatter of LOG_fmt.h instead of libc vsnprintf
+ *        (1 on target: no floating point printf; messages may then only use its conversions,
+ *        can be given by the build: -DLOG_CFG_INT_FORMAT=1)
+ */
+#ifndef LOG_CFG_INT_FORMAT
+#define LOG_CFG_INT_FORMAT          0
+#endif
+
+/**
+ * @brief Maximum number of sinks, including sink 0 (the output channel)
+ */
+#define LOG_CFG_MAX_SINKS           8
+
+/**
+ * @brief Default rate limit of each LOG_write call site: sustained messages per second (0: no limit)
+ *        and burst (changed at runtime by LOG_setRateLimit, can be given by the build)
+ */
+#ifndef LOG_CFG_LIMIT_RATE
+#define LOG_CFG_LIMIT_RATE          0
+#endif
+#ifndef LOG_CFG_LIMIT_BURST
+#define LOG_CFG_LIMIT_BURST         0
+#endif
+
+/**
+ * @brief Default repeat window in ms (0: repeats are written), changed at runtime by LOG_setRepeatWindow
+ *        (can be given by the build)
+ */
+#ifndef LOG_CFG_REPEAT_WINDOW_MS
+#define LOG_CFG_REPEAT_WINDOW_MS    0
+#endif
+
+/**
+ * @brief Number of call sites tracked by the rate limit and the repeat check (must be a power of 2)
+ *        (sites beyond it are not limited)
+ */
+#define LOG_CFG_LIMIT_SITES         256
+
+/**
+ * @brief Bytes of the last text kept by each call site: a text is only a repeat when its hash, its
+ *        length and these first bytes match (a hash collision alone does not hide a message)
+ */
+#define LOG_CFG_REPEAT_COMPARE      64
+
+/**
+ * @brief Text size of a LOG_SINK_CRASH record (longer messages are truncated)
+ */
+#define LOG_CFG_CRASH_RECORD_SIZE   128
+
+/**
+ * @brief stdio buffer size of the log file when LOG_fileOpen is given no buffer
+ */
+#define LOG_CFG_FILE_BUFFER         65536
+
+/**
+ * @brief Lowest severity compiled in by the LOG_DEBUG/LOG_INFO/LOG_WARNING/LOG_ERROR macros
+ *        (calls below it are removed with their arguments)
+ *        Options: debug, info, warning, error (can be given by the build: -DLOG_CFG_COMPILE_LEVEL=warning)
+ */
+#ifndef LOG_CFG_COMPILE_LEVEL
+#define LOG_CFG_COMPILE_LEVEL       debug
+#endif
+
+/**
+ * @brief Modules with their own runtime level (first argument of the LOG_xxx macros)
+ */
+#define LOG_MOD_DEFAULT             0
+#define LOG_MOD_APP                 1
+#define LOG_MOD_HAL                 2
+#define LOG_MOD_MCAL                3
+
+#define LOG_CFG_MODULES             4
+
+#endif
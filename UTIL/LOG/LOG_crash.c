@@ -0,0 +1,169 @@
+#include <string.h>
+#include <stdint.h>
+#include <stdatomic.h>
+
+#include "LOG.h"
+#include "LOG_cfg.h"
+#include "LOG_crash.h"
+
+#define CRASH_MAGIC         0x52474F4CUL    /* "LOGR" */
+#define CRASH_VERSION       1
+
+typedef struct
+{
+    unsigned int magic;
+    unsigned int version;
+    unsigned int recordSize;
+    unsigned int recordCount;
+    atomic_ullong head;                     /* next sequence number */
+}LOG_strCrashHeader_t;
+
+typedef struct
+{
+    atomic_ullong seq;                      /* sequence + 1 once published, 0 while being written */
+    int severity;
+    int length;
+    char text[LOG_CFG_CRASH_RECORD_SIZE];
+}LOG_strCrashSlot_t;
+
+static int valid_header(const LOG_strCrashHeader_t* header, size_t size);
+
+/**
+ * @brief Read the newest records of a crash ring, e.g. after a reset
+ *        (may run while the ring is still written: records overwritten during the copy are skipped)
+ * 
+ * @param[in]  region : the region given to the LOG_SINK_CRASH sink
+ * @param[in]  size   : size of the region
+ * @param[out] records: receives the records, oldest first
+ * @param[in]  count  : the maximum number of records to read
+ * 
+ * @return the number of records read, -1 if the region holds no valid ring
+*/
+int LOG_crashRead(const void* region, size_t size, LOG_strCrashRecord_t* records, int count)
+{
+    int ret = -1;
+    LOG_strCrashHeader_t* header = (LOG_strCrashHeader_t*)region;
+    LOG_strCrashSlot_t* slots;
+    LOG_strCrashSlot_t* slot;
+    unsigned long long head;
+    unsigned long long oldest;
+    unsigned long long seq;
+    int found = 0;
+    int i;
+
+    if((records != NULL) && (count >= 0) && valid_header(header, size))
+    {
+        slots = (LOG_strCrashSlot_t*)(header + 1);
+        head = atomic_load_explicit(&header->head, memory_order_acquire);
+        oldest = (head > header->recordCount) ? (head - header->recordCount) : 0;
+
+        /* newest first, into the end of the output: records lost to a crash in the middle of a write are skipped */
+        for(seq = head; (seq > oldest) && (found < count); seq--)
+        {
+            slot = &slots[(seq - 1) % header->recordCount];
+
+            if(atomic_load_explicit(&slot->seq, memory_order_acquire) == seq)
+            {
+                records[count - 1 - found].sequence = seq - 1;
+                records[count - 1 - found].severity = (LOG_enuSeverityLevel_t)slot->severity;
+                records[count - 1 - found].length = slot->length;
+                memcpy(records[count - 1 - found].text, slot->text, LOG_CFG_CRASH_RECORD_SIZE);
+                atomic_thread_fence(memory_order_acquire);
+
+                /* keep it only if no writer took the record meanwhile */
+                if((atomic_load_explicit(&slot->seq, memory_order_relaxed) == seq)
+                && (slot->length >= 0) && (slot->length < LOG_CFG_CRASH_RECORD_SIZE))
+                {
+                    records[count - 1 - found].text[records[count - 1 - found].length] = '\0';
+                    found++;
+                }
+            }
+        }
+
+        /* move them to the start, oldest first */
+        for(i = 0; i < found; i++)
+        {
+            records[i] = records[count - found + i];
+        }
+
+        ret = found;
+    }
+    else
+    {
+
+    }
+
+    return ret;
+}
+
+int log_crash_attach(void* region, size_t size)
+{
+    int ret = -1;
+    LOG_strCrashHeader_t* header = (LOG_strCrashHeader_t*)region;
+    LOG_strCrashSlot_t* slots;
+    unsigned int i;
+
+    if((region != NULL) && (((uintptr_t)region % sizeof(unsigned long long)) == 0)
+    && (size >= sizeof(LOG_strCrashHeader_t) + sizeof(LOG_strCrashSlot_t)))
+    {
+        /* a ring left by the previous run (or reset) is kept and appended to */
+        if(!valid_header(header, size))
+        {
+            header->magic = 0;
+            header->version = CRASH_VERSION;
+            header->recordSize = sizeof(LOG_strCrashSlot_t);
+            header->recordCount = (unsigned int)((size - sizeof(LOG_strCrashHeader_t)) / sizeof(LOG_strCrashSlot_t));
+            atomic_init(&header->head, 0);
+
+            slots = (LOG_strCrashSlot_t*)(header + 1);
+            for(i = 0; i < header->recordCount; i++)
+            {
+                atomic_init(&slots[i].seq, 0);
+            }
+
+            /* valid only once completely initialized */
+            atomic_thread_fence(memory_order_release);
+            header->magic = CRASH_MAGIC;
+        }
+
+        ret = 0;
+    }
+    else
+    {
+
+    }
+
+    return ret;
+}
+
+void log_crash_write(void* region, LOG_enuSeverityLevel_t severity, const char* text, int length)
+{
+    LOG_strCrashHeader_t* header = (LOG_strCrashHeader_t*)region;
+    LOG_strCrashSlot_t* slot;
+    unsigned long long seq;
+
+    seq = atomic_fetch_add_explicit(&header->head, 1, memory_order_relaxed);
+    slot = &((LOG_strCrashSlot_t*)(header + 1))[seq % header->recordCount];
+
+    /* a reset before the record is published leaves it marked as being written */
+    atomic_store_explicit(&slot->seq, 0, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+
+    if(length > LOG_CFG_CRASH_RECORD_SIZE - 1)
+    {
+        length = LOG_CFG_CRASH_RECORD_SIZE - 1;
+    }
+    slot->severity = (int)severity;
+    slot->length = length;
+    memcpy(slot->text, text, length);
+
+    atomic_store_explicit(&slot->seq, seq + 1, memory_order_release);
+}
+
+/* A ring written with the same layout that fits in the region */
+static int valid_header(const LOG_strCrashHeader_t* header, size_t size)
+{
+    return (header != NULL) && (header->magic == CRASH_MAGIC) && (header->version == CRASH_VERSION)
+        && (header->recordSize == sizeof(LOG_strCrashSlot_t)) && (header->recordCount > 0)
+        && (sizeof(LOG_strCrashHeader_t) + (size_t)header->recordCount * sizeof(LOG_strCrashSlot_t) <= size);
+}
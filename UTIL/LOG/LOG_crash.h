@@ -0,0 +1,26 @@
+#ifndef LOG_CRASH_H_
+#define LOG_CRASH_H_
+
+#include <stddef.h>
+
+#include "LOG.h"
+
+/*
+ * Crash ring used by the LOG_SINK_CRASH sinks (the user API is in LOG.h).
+ * The whole ring lives in the caller's region so it survives the process or a reset:
+ *
+ *   header : magic | version | record size | record count | head (next sequence number)
+ *   records: sequence + 1 (0 while being written) | severity | length | text
+ *
+ * A writer takes a sequence number with a fetch-add on the head and owns record
+ * (sequence % count) until it publishes it, no lock is taken.
+ */
+
+/* Check the region's header: keep the records of a valid ring, initialize it otherwise
+   returns 0, -1 if the region is too small or misaligned */
+int log_crash_attach(void* region, size_t size);
+
+/* Append a text record (truncated to the record size) */
+void log_crash_write(void* region, LOG_enuSeverityLevel_t severity, const char* text, int length);
+
+#endif /* LOG_CRASH_H_ */
@@ -0,0 +1,49 @@
+/*
+ * Offline decoder for binary logs written with LOG_BIN (LOG_binOpen)
+ *
+ * Build: gcc -o log_decode LOG_decode.c LOG_bin.c
+ * Usage: log_decode <binary log> [text output]   (default output: console)
+ */
+#include <stdio.h>
+
+#include "LOG_bin.h"
+
+int main(int argc, char* argv[])
+{
+    FILE* in = NULL;
+    FILE* out = stdout;
+    long messages = -1;
+
+    if((argc < 2) || (argc > 3))
+    {
+        fprintf(stderr, "usage: %s <binary log> [text output]\n", argv[0]);
+    }
+    else if((in = fopen(argv[1], "rb")) == NULL)
+    {
+        perror(argv[1]);
+    }
+    else if((argc == 3) && ((out = fopen(argv[2], "w")) == NULL))
+    {
+        perror(argv[2]);
+    }
+    else
+    {
+        messages = LOG_binDecode(in, out);
+
+        if(messages < 0)
+        {
+            fprintf(stderr, "%s: not a valid binary log (truncated or written on a different ABI)\n", argv[1]);
+        }
+    }
+
+    if(in != NULL)
+    {
+        fclose(in);
+    }
+    if((out != NULL) && (out != stdout))
+    {
+        fclose(out);
+    }
+
+    return (messages < 0) ? 1 : 0;
+}
@@ -0,0 +1,346 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sched.h>
+#include <pthread.h>
+#include <stdatomic.h>
+
+#include "LOG.h"
+#include "LOG_cfg.h"
+#include "LOG_file.h"
+#include "LOG_fmt.h"
+
+#define FILE_NAME_SIZE      256
+
+/* Same formatter as the messages (no libc printf with LOG_CFG_INT_FORMAT) */
+#if LOG_CFG_INT_FORMAT
+#define FORMAT_TEXT         LOG_format
+#else
+#define FORMAT_TEXT         snprintf
+#endif
+
+/* The open file and its counters (all protected by gl_file_lock) */
+static FILE *gl_file = NULL;
+static long gl_file_bytes;
+static int gl_file_records;             /* records since the last flush */
+static int gl_file_dirty;               /* written but not flushed */
+static long long gl_file_last_flush;    /* monotonic milliseconds */
+static pthread_mutex_t gl_file_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/* Settings of the open file */
+static char gl_file_name[FILE_NAME_SIZE];
+static char* gl_file_buffer;            /* user buffer, split in two halves: the open file and the next one */
+static size_t gl_file_half_size;
+static int gl_file_half;                /* half used by the open file */
+static long gl_file_max_bytes;
+static int gl_file_max_files;
+
+/* Flush policy (changed under gl_file_lock) */
+static int gl_flush_policy = LOG_FLUSH_ALWAYS;
+static int gl_flush_records;
+static int gl_flush_ms;
+
+static atomic_int gl_file_rotating;
+static int gl_file_exit_registered;
+
+static FILE* open_file(int half);
+static void rotate_file(void);
+static void flush_locked(void);
+static long long now_ms(void);
+static void close_at_exit(void);
+
+/**
+ * @brief Open the log file of the LOG_OUT_FILE channel (appends, closes the previous file)
+ * 
+ * @param[in] fileName  : the name of the file to log messages to
+ * @param[in] buffer    : stdio buffer of the file, split in two halves so the next file can be
+ *                        opened while the rotated one is still being closed (NULL: allocated by stdio)
+ * @param[in] bufferSize: size of the buffer in bytes
+ * @param[in] maxBytes  : rotate once the file reaches this size (0: no rotation)
+ * @param[in] maxFiles  : number of rotated files kept: name.1 (newest) ... name.maxFiles (oldest)
+ * 
+ * @return 0 on success, -1 if the file could not be opened or the parameters are invalid
+*/
+int LOG_fileOpen(const char* fileName, char* buffer, size_t bufferSize, long maxBytes, int maxFiles)
+{
+    int ret = -1;
+    FILE* fptr;
+
+    if((fileName != NULL) && (strlen(fileName) < FILE_NAME_SIZE) && (maxBytes >= 0)
+    && ((maxBytes == 0) || (maxFiles > 0)) && ((buffer == NULL) || (bufferSize >= 2)))
+    {
+        LOG_fileClose();
+
+        strcpy(gl_file_name, fileName);
+        gl_file_buffer = buffer;
+        gl_file_half_size = (bufferSize != 0) ? (bufferSize / 2) : LOG_CFG_FILE_BUFFER;
+        gl_file_half = 0;
+        gl_file_max_bytes = maxBytes;
+        gl_file_max_files = maxFiles;
+
+        fptr = open_file(gl_file_half);
+
+        if(fptr != NULL)
+        {
+            pthread_mutex_lock(&gl_file_lock);
+            gl_file = fptr;
+            fseek(gl_file, 0, SEEK_END);
+            gl_file_bytes = ftell(gl_file);
+            gl_file_records = 0;
+            gl_file_dirty = 0;
+            gl_file_last_flush = now_ms();
+            pthread_mutex_unlock(&gl_file_lock);
+
+            /* the buffered records must reach the file even if LOG_fileClose is never called */
+            if(!gl_file_exit_registered)
+            {
+                atexit(close_at_exit);
+                gl_file_exit_registered = 1;
+            }
+
+            ret = 0;
+        }
+    }
+    else
+    {
+
+    }
+
+    return ret;
+}
+
+/**
+ * @brief Select when the log file is flushed (between flushes the records stay in the file buffer)
+ * 
+ * @param[in] policy      : LOG_FLUSH_ALWAYS: after every message (synchronous mode) or batch (asynchronous mode)
+ *                          or any combination of:
+ *                          LOG_FLUSH_ON_ERROR : after every error message
+ *                          LOG_FLUSH_EVERY_N  : every everyRecords messages
+ *                          LOG_FLUSH_EVERY_MS : everyMs milliseconds after the first unflushed message
+ *                                               (checked at each message, and by the writer thread while idle)
+ *                          (only when the buffer is full if none applies)
+ * @param[in] everyRecords: the number of messages of LOG_FLUSH_EVERY_N
+ * @param[in] everyMs     : the period of LOG_FLUSH_EVERY_MS
+ * 
+ * @return 0 on success, -1 for an invalid policy
+*/
+int LOG_fileSetFlushPolicy(int policy, int everyRecords, int everyMs)
+{
+    int ret = -1;
+
+    if(((policy & ~(LOG_FLUSH_ON_ERROR | LOG_FLUSH_EVERY_N | LOG_FLUSH_EVERY_MS)) == 0)
+    && (((policy & LOG_FLUSH_EVERY_N) == 0) || (everyRecords > 0))
+    && (((policy & LOG_FLUSH_EVERY_MS) == 0) || (everyMs > 0)))
+    {
+        pthread_mutex_lock(&gl_file_lock);
+        gl_flush_policy = policy;
+        gl_flush_records = everyRecords;
+        gl_flush_ms = everyMs;
+        pthread_mutex_unlock(&gl_file_lock);
+
+        ret = 0;
+    }
+    else
+    {
+
+    }
+
+    return ret;
+}
+
+/**
+ * @brief Flush the log file now
+ * 
+ * @return
+*/
+void LOG_fileFlush(void)
+{
+    pthread_mutex_lock(&gl_file_lock);
+    flush_locked();
+    pthread_mutex_unlock(&gl_file_lock);
+}
+
+/* Flush and close the log file (no record may be queued for it: see LOG_fileClose) */
+void log_file_close(void)
+{
+    FILE* fptr;
+
+    /* a rotation in progress still uses the name and the buffer */
+    while(atomic_load(&gl_file_rotating))
+    {
+        sched_yield();
+    }
+
+    pthread_mutex_lock(&gl_file_lock);
+    fptr = gl_file;
+    gl_file = NULL;
+    pthread_mutex_unlock(&gl_file_lock);
+
+    if(fptr != NULL)
+    {
+        fclose(fptr);
+    }
+}
+
+void log_file_write(LOG_enuSeverityLevel_t severity, const char* data, int length)
+{
+    int rotate = 0;
+
+    pthread_mutex_lock(&gl_file_lock);
+
+    if(gl_file != NULL)
+    {
+        fwrite(data, 1, length, gl_file);
+        gl_file_bytes += length;
+        gl_file_records++;
+
+        if(!gl_file_dirty)
+        {
+            /* the timed flush counts from the first record waiting in the buffer */
+            gl_file_dirty = 1;
+            if(gl_flush_policy & LOG_FLUSH_EVERY_MS)
+            {
+                gl_file_last_flush = now_ms();
+            }
+        }
+
+        if(((gl_flush_policy & LOG_FLUSH_ON_ERROR) && (severity >= error))
+        || ((gl_flush_policy & LOG_FLUSH_EVERY_N) && (gl_file_records >= gl_flush_records)))
+        {
+            flush_locked();
+        }
+        else if((gl_flush_policy & LOG_FLUSH_EVERY_MS) && (now_ms() - gl_file_last_flush >= gl_flush_ms))
+        {
+            flush_locked();
+        }
+
+        /* one writer rotates, the others keep writing to the current file meanwhile */
+        if((gl_file_max_bytes > 0) && (gl_file_bytes >= gl_file_max_bytes)
+        && !atomic_exchange(&gl_file_rotating, 1))
+        {
+            rotate = 1;
+        }
+    }
+
+    pthread_mutex_unlock(&gl_file_lock);
+
+    if(rotate)
+    {
+        rotate_file();
+    }
+}
+
+void log_file_sync(void)
+{
+    if(gl_flush_policy == LOG_FLUSH_ALWAYS)
+    {
+        LOG_fileFlush();
+    }
+}
+
+void log_file_tick(void)
+{
+    if(gl_flush_policy & LOG_FLUSH_EVERY_MS)
+    {
+        pthread_mutex_lock(&gl_file_lock);
+        if(gl_file_dirty && (now_ms() - gl_file_last_flush >= gl_flush_ms))
+        {
+            flush_locked();
+        }
+        pthread_mutex_unlock(&gl_file_lock);
+    }
+}
+
+int log_file_period_ms(void)
+{
+    return (gl_flush_policy & LOG_FLUSH_EVERY_MS) ? gl_flush_ms : 0;
+}
+
+/* Open the log file (append) fully buffered with the given half of the user buffer */
+static FILE* open_file(int half)
+{
+    FILE* fptr = fopen(gl_file_name, "a");
+
+    if(fptr != NULL)
+    {
+        setvbuf(fptr, (gl_file_buffer != NULL) ? (gl_file_buffer + half * gl_file_half_size) : NULL,
+                _IOFBF, gl_file_half_size);
+    }
+
+    return fptr;
+}
+
+/*
+ * name.(n-1) -> name.n ... name -> name.1, then swap in a new name.
+ * The renamed file stays open, so records written meanwhile land at the end of name.1,
+ * and only the pointer swap is done under the lock: the old file is flushed and closed outside.
+ */
+static void rotate_file(void)
+{
+    char from[FILE_NAME_SIZE + 16];
+    char to[FILE_NAME_SIZE + 16];
+    FILE* fptr;
+    FILE* old = NULL;
+    int i;
+
+    for(i = gl_file_max_files - 1; i >= 1; i--)
+    {
+        FORMAT_TEXT(from, sizeof(from), "%s.%d", gl_file_name, i);
+        FORMAT_TEXT(to, sizeof(to), "%s.%d", gl_file_name, i + 1);
+        rename(from, to);
+    }
+
+    FORMAT_TEXT(to, sizeof(to), "%s.1", gl_file_name);
+    rename(gl_file_name, to);
+
+    fptr = open_file(!gl_file_half);
+
+    pthread_mutex_lock(&gl_file_lock);
+    if(fptr != NULL)
+    {
+        old = gl_file;
+        gl_file = fptr;
+        gl_file_half = !gl_file_half;
+        gl_file_records = 0;
+        gl_file_dirty = 0;
+    }
+    /* on failure keep writing to name.1, next attempt after another maxBytes */
+    gl_file_bytes = 0;
+    pthread_mutex_unlock(&gl_file_lock);
+
+    if(old != NULL)
+    {
+        fclose(old);
+    }
+
+    atomic_store(&gl_file_rotating, 0);
+}
+
+/* Flush the open file (gl_file_lock held) */
+static void flush_locked(void)
+{
+    if((gl_file != NULL) && gl_file_dirty)
+    {
+        fflush(gl_file);
+        gl_file_records = 0;
+        gl_file_dirty = 0;
+        gl_file_last_flush = now_ms();
+    }
+}
+
+static long long now_ms(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (long long)now.tv_sec * 1000 + now.tv_nsec / 1000000;
+}
+
+static void close_at_exit(void)
+{
+    /* the writer thread writes the queued records first */
+    LOG_stopAsync();
+    log_file_close();
+}
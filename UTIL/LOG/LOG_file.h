@@ -0,0 +1,27 @@
+#ifndef LOG_FILE_H_
+#define LOG_FILE_H_
+
+#include "LOG.h"
+
+/*
+ * File sink used by LOG.c for the LOG_OUT_FILE channel (the user API is in LOG.h):
+ * a fully buffered stdio stream that is flushed according to the flush policy
+ * and rotated to name.1, name.2 ... once it reaches its size limit.
+ */
+
+/* Flush and close the log file (no record may be queued for it: see LOG_fileClose) */
+void log_file_close(void);
+
+/* Write one formatted record, then flush/rotate as the policy requires */
+void log_file_write(LOG_enuSeverityLevel_t severity, const char* data, int length);
+
+/* End of a write call (synchronous mode) or of a batch (writer thread): flushes with LOG_FLUSH_ALWAYS */
+void log_file_sync(void);
+
+/* Flush if the LOG_FLUSH_EVERY_MS period elapsed since the last flush */
+void log_file_tick(void);
+
+/* The LOG_FLUSH_EVERY_MS period, 0 if the timed flush is off (bounds the writer thread's sleep) */
+int log_file_period_ms(void);
+
+#endif /* LOG_FILE_H_ */
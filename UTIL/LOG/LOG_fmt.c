@@ -0,0 +1,409 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "LOG_fmt.h"
+
+/* Flags of a conversion */
+#define FLAG_LEFT           0x01    /* '-' */
+#define FLAG_ZERO           0x02    /* '0' */
+
+/* Length modifiers */
+#define LENGTH_INT          0
+#define LENGTH_LONG         1
+#define LENGTH_LLONG        2
+#define LENGTH_SIZE         3
+#define LENGTH_LDOUBLE      4
+
+/* Enough for a 64 bit number in decimal with sign, point and MAX_FRACTION digits,
+   or a sign and MAX_DIGITS digits */
+#define MAX_FRACTION        20
+#define MAX_DIGITS          40
+#define NUMBER_SIZE         48
+
+/* Printed for the floating point conversions (their argument is skipped) */
+#define FLOAT_PLACEHOLDER   "<float>"
+
+/* The output buffer and the number of characters in it */
+typedef struct
+{
+    char* buffer;
+    int size;
+    int length;
+}LOG_strFmtOut_t;
+
+static const char gl_lower_digits[] = "0123456789abcdef";
+static const char gl_upper_digits[] = "0123456789ABCDEF";
+
+static void put_text(LOG_strFmtOut_t* out, const char* text, int length, int width, int flags);
+static int put_unsigned(char* end, unsigned long long value, unsigned int base, const char* digits, int precision);
+
+/**
+ * @brief Format into a caller buffer (always '\0' terminated when size > 0)
+ * 
+ * @param[out] buffer : receives the text
+ * @param[in]  size   : size of the buffer
+ * @param[in]  message: the format string
+ * @param[in]  valist : the arguments
+ * 
+ * @return the number of characters written (without the '\0', the text is truncated to size - 1)
+*/
+int LOG_vformat(char* buffer, int size, const char* message, va_list valist)
+{
+    LOG_strFmtOut_t out = {buffer, size, 0};
+    char number[NUMBER_SIZE];
+    char* text;
+    const char* string;
+    unsigned long long value;
+    long long signedValue;
+    int flags;
+    int width;
+    int precision;
+    int lengthModifier;
+    int length;
+    int negative;
+    char character;
+
+    while((message != NULL) && (*message != '\0'))
+    {
+        if(*message != '%')
+        {
+            /* copy the plain text up to the next conversion at once */
+            string = message;
+            while((*message != '\0') && (*message != '%'))
+            {
+                message++;
+            }
+            put_text(&out, string, (int)(message - string), 0, 0);
+            continue;
+        }
+
+        message++;
+
+        flags = 0;
+        while((*message == '-') || (*message == '0'))
+        {
+            flags |= (*message == '-') ? FLAG_LEFT : FLAG_ZERO;
+            message++;
+        }
+
+        width = 0;
+        if(*message == '*')
+        {
+            width = va_arg(valist, int);
+            if(width < 0)
+            {
+                flags |= FLAG_LEFT;
+                width = -width;
+            }
+            message++;
+        }
+        while((*message >= '0') && (*message <= '9'))
+        {
+            width = width * 10 + (*message - '0');
+            message++;
+        }
+
+        precision = -1;
+        if(*message == '.')
+        {
+            message++;
+            precision = 0;
+            if(*message == '*')
+            {
+                precision = va_arg(valist, int);
+                message++;
+            }
+            while((*message >= '0') && (*message <= '9'))
+            {
+                precision = precision * 10 + (*message - '0');
+                message++;
+            }
+        }
+
+        lengthModifier = LENGTH_INT;
+        while((*message == 'h') || (*message == 'l') || (*message == 'z') || (*message == 'j')
+           || (*message == 't') || (*message == 'L'))
+        {
+            /* char and short are promoted to int, intmax_t is long long and ptrdiff_t has the size of size_t */
+            if(*message == 'l')
+            {
+                lengthModifier = (lengthModifier == LENGTH_LONG) ? LENGTH_LLONG : LENGTH_LONG;
+            }
+            else if(*message == 'j')
+            {
+                lengthModifier = LENGTH_LLONG;
+            }
+            else if((*message == 'z') || (*message == 't'))
+            {
+                lengthModifier = LENGTH_SIZE;
+            }
+            else if(*message == 'L')
+            {
+                lengthModifier = LENGTH_LDOUBLE;
+            }
+            message++;
+        }
+
+        /* precision of an integer: minimum number of digits (the '0' flag is then ignored) */
+        if((precision >= 0) && (*message != 'q') && (*message != 's'))
+        {
+            flags &= ~FLAG_ZERO;
+            if(precision > MAX_DIGITS)
+            {
+                precision = MAX_DIGITS;
+            }
+        }
+
+        switch(*message)
+        {
+            case 'd':
+            case 'i':
+            case 'q':
+                if(lengthModifier == LENGTH_LLONG)
+                {
+                    signedValue = va_arg(valist, long long);
+                }
+                else if(lengthModifier == LENGTH_LONG)
+                {
+                    signedValue = va_arg(valist, long);
+                }
+                else if(lengthModifier == LENGTH_SIZE)
+                {
+                    signedValue = (long long)va_arg(valist, size_t);
+                }
+                else
+                {
+                    signedValue = va_arg(valist, int);
+                }
+
+                negative = (signedValue < 0);
+                value = negative ? (0ULL - (unsigned long long)signedValue) : (unsigned long long)signedValue;
+                text = number + NUMBER_SIZE;
+
+                if((*message == 'q') && (precision > 0))
+                {
+                    if(precision > MAX_FRACTION)
+                    {
+                        precision = MAX_FRACTION;
+                    }
+
+                    /* the fractional digits, then the point */
+                    for(length = 0; length < precision; length++)
+                    {
+                        *--text = (char)('0' + (value % 10));
+                        value /= 10;
+                    }
+                    *--text = '.';
+                    precision = -1;
+                }
+                else if(*message == 'q')
+                {
+                    precision = -1;
+                }
+
+                text -= put_unsigned(text, value, 10, gl_lower_digits, precision);
+
+                if(negative)
+                {
+                    *--text = '-';
+                }
+
+                length = (int)(number + NUMBER_SIZE - text);
+
+                /* the zeros go after the sign */
+                if((flags & FLAG_ZERO) && !(flags & FLAG_LEFT) && negative && (width > length))
+                {
+                    put_text(&out, "-", 1, 0, 0);
+                    put_text(&out, text + 1, length - 1, width - 1, flags);
+                }
+                else
+                {
+                    put_text(&out, text, length, width, flags);
+                }
+                break;
+
+            case 'u':
+            case 'x':
+            case 'X':
+                if(lengthModifier == LENGTH_LLONG)
+                {
+                    value = va_arg(valist, unsigned long long);
+                }
+                else if(lengthModifier == LENGTH_LONG)
+                {
+                    value = va_arg(valist, unsigned long);
+                }
+                else if(lengthModifier == LENGTH_SIZE)
+                {
+                    value = va_arg(valist, size_t);
+                }
+                else
+                {
+                    value = va_arg(valist, unsigned int);
+                }
+
+                length = put_unsigned(number + NUMBER_SIZE, value, (*message == 'u') ? 10 : 16,
+                                      (*message == 'X') ? gl_upper_digits : gl_lower_digits, precision);
+                put_text(&out, number + NUMBER_SIZE - length, length, width, flags);
+                break;
+
+            case 'p':
+                length = put_unsigned(number + NUMBER_SIZE, (unsigned long long)(size_t)va_arg(valist, void*), 16,
+                                      gl_lower_digits, precision);
+                text = number + NUMBER_SIZE - length;
+                *--text = 'x';
+                *--text = '0';
+                put_text(&out, text, length + 2, width, flags & ~FLAG_ZERO);
+                break;
+
+            case 'n':
+                /* nothing is written back */
+                (void)va_arg(valist, void*);
+                break;
+
+            case 'f':
+            case 'F':
+            case 'e':
+            case 'E':
+            case 'g':
+            case 'G':
+            case 'a':
+            case 'A':
+                /* no floating point: the argument is skipped so the next ones stay in place */
+                if(lengthModifier == LENGTH_LDOUBLE)
+                {
+                    (void)va_arg(valist, long double);
+                }
+                else
+                {
+                    (void)va_arg(valist, double);
+                }
+                put_text(&out, FLOAT_PLACEHOLDER, (int)sizeof(FLOAT_PLACEHOLDER) - 1, width, flags & ~FLAG_ZERO);
+                break;
+
+            case 'c':
+                character = (char)va_arg(valist, int);
+                put_text(&out, &character, 1, width, flags & ~FLAG_ZERO);
+                break;
+
+            case 's':
+                string = va_arg(valist, const char*);
+                if(string == NULL)
+                {
+                    string = "(null)";
+                }
+                length = 0;
+                while((string[length] != '\0') && ((precision < 0) || (length < precision)))
+                {
+                    length++;
+                }
+                put_text(&out, string, length, width, flags & ~FLAG_ZERO);
+                break;
+
+            case '%':
+                put_text(&out, "%", 1, 0, 0);
+                break;
+
+            case '\0':
+                /* '%' at the end of the format */
+                message--;
+                break;
+
+            default:
+                /* unknown conversion (takes no argument): copied as is */
+                put_text(&out, message, 1, 0, 0);
+                break;
+        }
+
+        message++;
+    }
+
+    if(size > 0)
+    {
+        buffer[out.length] = '\0';
+    }
+
+    return out.length;
+}
+
+/**
+ * @brief Format into a caller buffer (always '\0' terminated when size > 0)
+ * 
+ * @param[out] buffer : receives the text
+ * @param[in]  size   : size of the buffer
+ * @param[in]  message: the format string
+ * 
+ * @return the number of characters written (without the '\0', the text is truncated to size - 1)
+*/
+int LOG_format(char* buffer, int size, const char* message, ...)
+{
+    int length;
+    va_list valist;
+
+    va_start(valist, message);
+    length = LOG_vformat(buffer, size, message, valist);
+    va_end(valist);
+
+    return length;
+}
+
+/* Append text padded to width (with spaces, or zeros on the left with FLAG_ZERO), truncated to the buffer */
+static void put_text(LOG_strFmtOut_t* out, const char* text, int length, int width, int flags)
+{
+    int padding = (width > length) ? (width - length) : 0;
+    char pad = (flags & FLAG_ZERO) ? '0' : ' ';
+
+    if(!(flags & FLAG_LEFT))
+    {
+        while((padding > 0) && (out->length < out->size - 1))
+        {
+            out->buffer[out->length++] = pad;
+            padding--;
+        }
+    }
+
+    if(length > out->size - 1 - out->length)
+    {
+        length = out->size - 1 - out->length;
+    }
+    if(length > 0)
+    {
+        memcpy(out->buffer + out->length, text, length);
+        out->length += length;
+    }
+
+    while((padding > 0) && (out->length < out->size - 1))
+    {
+        out->buffer[out->length++] = ' ';
+        padding--;
+    }
+}
+
+/* Write the digits of value backwards ending at end, at least precision of them (-1: one, 0: none for 0),
+   returns their number (32 bit divisions when it fits) */
+static int put_unsigned(char* end, unsigned long long value, unsigned int base, const char* digits, int precision)
+{
+    char* text = end;
+    unsigned long small;
+
+    while(value > 0xFFFFFFFFULL)
+    {
+        *--text = digits[value % base];
+        value /= base;
+    }
+
+    small = (unsigned long)value;
+    while((small != 0) || ((text == end) && (precision != 0)))
+    {
+        *--text = digits[small % base];
+        small /= base;
+    }
+
+    while(end - text < precision)
+    {
+        *--text = '0';
+    }
+
+    return (int)(end - text);
+}
@@ -0,0 +1,47 @@
+#ifndef LOG_FMT_H_
+#define LOG_FMT_H_
+
+#include <stdarg.h>
+
+/*
+ * Compact integer-only formatter (no floating point, no malloc, no static state: reentrant and ISR safe)
+ *
+ *   %[-][0][width|*][.precision|.*][hh|h|l|ll|z|j|t]conversion
+ *
+ *   d i   : signed decimal (precision: minimum number of digits)
+ *   u     : unsigned decimal (precision: minimum number of digits)
+ *   x X   : unsigned hexadecimal (precision: minimum number of digits)
+ *   c     : character
+ *   s     : string (precision: maximum number of characters, NULL prints "(null)")
+ *   q     : fixed point: a signed integer scaled by 10^precision ("%.3q" of 3300 -> "3.300")
+ *   p     : pointer in hexadecimal ("0x...")
+ *   %     : '%'
+ *
+ * The floating point conversions (f e g a, also with L) skip their argument and print "<float>",
+ * %n skips its pointer. Anything else is copied as is.
+ */
+
+/**
+ * @brief Format into a caller buffer (always '\0' terminated when size > 0)
+ * 
+ * @param[out] buffer : receives the text
+ * @param[in]  size   : size of the buffer
+ * @param[in]  message: the format string
+ * @param[in]  valist : the arguments
+ * 
+ * @return the number of characters written (without the '\0', the text is truncated to size - 1)
+*/
+int LOG_vformat(char* buffer, int size, const char* message, va_list valist);
+
+/**
+ * @brief Format into a caller buffer (always '\0' terminated when size > 0)
+ * 
+ * @param[out] buffer : receives the text
+ * @param[in]  size   : size of the buffer
+ * @param[in]  message: the format string
+ * 
+ * @return the number of characters written (without the '\0', the text is truncated to size - 1)
+*/
+int LOG_format(char* buffer, int size, const char* message, ...);
+
+#endif /* LOG_FMT_H_ */
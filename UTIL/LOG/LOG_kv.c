@@ -0,0 +1,196 @@
+#include <string.h>
+
+#include "LOG.h"
+#include "LOG_kv.h"
+
+/* Kept free at the end of the buffer for ,"truncated":true}\n */
+#define TRUNCATED_ROOM      20
+
+/* The record buffer and the number of characters in it */
+typedef struct
+{
+    char* buffer;
+    int size;                           /* usable size (TRUNCATED_ROOM kept aside) */
+    int length;
+    int full;
+}LOG_strKvOut_t;
+
+static const char* const gl_severity_names[] = {"debug", "info", "warning", "error"};
+static const char gl_hex_digits[] = "0123456789abcdef";
+
+static void put_raw(LOG_strKvOut_t* out, const char* text, int length);
+static void put_string(LOG_strKvOut_t* out, const char* text);
+static void put_unsigned(LOG_strKvOut_t* out, unsigned long long value, int minDigits);
+static int put_field(LOG_strKvOut_t* out, const LOG_strKvField_t* field);
+
+int log_kv_json(char* buffer, int size, LOG_enuSeverityLevel_t severity, long long seconds, long microseconds,
+                const char* event, const LOG_strKvField_t* fields, int count)
+{
+    LOG_strKvOut_t out = {buffer, size - TRUNCATED_ROOM, 0, 0};
+    int start;
+    int i;
+
+    put_raw(&out, "{\"ts\":", 6);
+    put_unsigned(&out, (unsigned long long)seconds, 1);
+    put_raw(&out, ".", 1);
+    put_unsigned(&out, (unsigned long long)microseconds, 6);
+    put_raw(&out, ",\"sev\":\"", 8);
+    put_raw(&out, gl_severity_names[severity], (int)strlen(gl_severity_names[severity]));
+    put_raw(&out, "\",\"event\":", 10);
+
+    start = out.length;
+    put_string(&out, event);
+    if(out.full)
+    {
+        /* no room for the fields either */
+        out.length = start;
+        put_raw(&out, "null", 4);
+        out.full = 1;
+    }
+
+    /* a field that does not fit is taken back whole */
+    for(i = 0; (i < count) && !out.full; i++)
+    {
+        if(!put_field(&out, &fields[i]))
+        {
+            out.full = 1;
+        }
+    }
+
+    out.size += TRUNCATED_ROOM;
+    if(out.full)
+    {
+        put_raw(&out, ",\"truncated\":true", 17);
+    }
+    put_raw(&out, "}\n", 2);
+
+    return out.length;
+}
+
+/* Append one ,"key":value pair, returns 0 (and appends nothing) if it does not fit */
+static int put_field(LOG_strKvOut_t* out, const LOG_strKvField_t* field)
+{
+    int start = out->length;
+
+    put_raw(out, ",", 1);
+    put_string(out, field->key);
+    put_raw(out, ":", 1);
+
+    switch(field->type)
+    {
+        case LOG_KV_UINT:
+            put_unsigned(out, field->value.u, 1);
+            break;
+
+        case LOG_KV_INT:
+            if(field->value.i < 0)
+            {
+                put_raw(out, "-", 1);
+                put_unsigned(out, 0ULL - (unsigned long long)field->value.i, 1);
+            }
+            else
+            {
+                put_unsigned(out, (unsigned long long)field->value.i, 1);
+            }
+            break;
+
+        case LOG_KV_BOOL:
+            if(field->value.u)
+            {
+                put_raw(out, "true", 4);
+            }
+            else
+            {
+                put_raw(out, "false", 5);
+            }
+            break;
+
+        case LOG_KV_STR:
+            put_string(out, field->value.s);
+            break;
+
+        default:
+            put_raw(out, "null", 4);
+            break;
+    }
+
+    if(out->full)
+    {
+        out->length = start;
+    }
+
+    return !out->full;
+}
+
+/* Append characters, sets full instead of writing a part of them */
+static void put_raw(LOG_strKvOut_t* out, const char* text, int length)
+{
+    if(out->length + length <= out->size)
+    {
+        memcpy(out->buffer + out->length, text, length);
+        out->length += length;
+    }
+    else
+    {
+        out->full = 1;
+    }
+}
+
+/* Append a JSON string: quotes, backslashes and control characters are escaped */
+static void put_string(LOG_strKvOut_t* out, const char* text)
+{
+    const char* run;
+    char escape[6] = {'\\', 'u', '0', '0', 0, 0};
+
+    if(text == NULL)
+    {
+        put_raw(out, "null", 4);
+    }
+    else
+    {
+        put_raw(out, "\"", 1);
+
+        while(*text != '\0')
+        {
+            /* the characters needing no escape are copied at once */
+            run = text;
+            while((*text != '\0') && (*text != '"') && (*text != '\\') && ((unsigned char)*text >= 0x20))
+            {
+                text++;
+            }
+            put_raw(out, run, (int)(text - run));
+
+            if((*text == '"') || (*text == '\\'))
+            {
+                escape[1] = *text;
+                put_raw(out, escape, 2);
+                text++;
+            }
+            else if(*text != '\0')
+            {
+                escape[1] = 'u';
+                escape[4] = gl_hex_digits[((unsigned char)*text >> 4) & 0x0F];
+                escape[5] = gl_hex_digits[(unsigned char)*text & 0x0F];
+                put_raw(out, escape, 6);
+                text++;
+            }
+        }
+
+        put_raw(out, "\"", 1);
+    }
+}
+
+/* Append a decimal number with at least minDigits digits */
+static void put_unsigned(LOG_strKvOut_t* out, unsigned long long value, int minDigits)
+{
+    char digits[24];
+    int length = 0;
+
+    do
+    {
+        digits[sizeof(digits) - 1 - length++] = (char)('0' + (value % 10));
+        value /= 10;
+    } while((value != 0) || (length < minDigits));
+
+    put_raw(out, digits + sizeof(digits) - length, length);
+}
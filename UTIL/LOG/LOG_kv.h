@@ -0,0 +1,18 @@
+#ifndef LOG_KV_H_
+#define LOG_KV_H_
+
+#include "LOG.h"
+
+/*
+ * JSON-lines serialization of the LOG_KV records, written straight into the record buffer:
+ *
+ *   {"ts":1697710667.123456,"sev":"info","event":"pin_stuck","pin":5,"port":"A"}
+ *
+ * A record too long for the buffer keeps the fields that fit and ends with "truncated":true.
+ */
+
+/* Serialize one record with its line end, returns its length */
+int log_kv_json(char* buffer, int size, LOG_enuSeverityLevel_t severity, long long seconds, long microseconds,
+                const char* event, const LOG_strKvField_t* fields, int count);
+
+#endif /* LOG_KV_H_ */
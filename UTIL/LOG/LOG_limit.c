@@ -0,0 +1,309 @@
+#include <stdint.h>
+#include <limits.h>
+#include <string.h>
+#include <time.h>
+#include <stdatomic.h>
+#include <pthread.h>
+
+#include "LOG.h"
+#include "LOG_cfg.h"
+#include "LOG_limit.h"
+
+#define SITES_MASK          (LOG_CFG_LIMIT_SITES - 1)
+
+#if ((LOG_CFG_LIMIT_SITES & SITES_MASK) != 0)
+#error "LOG_CFG_LIMIT_SITES must be a power of 2"
+#endif
+
+/* A call site: claimed once by storing its format pointer in key, never released */
+typedef struct
+{
+    atomic_uintptr_t key;
+    atomic_llong tat;                   /* theoretical arrival time of the next message (microseconds) */
+    atomic_ulong dropped;               /* dropped by the rate limit since the last written message */
+    unsigned int hash;                  /* last text: hash, length and first bytes (under lock) */
+    int length;
+    char text[LOG_CFG_REPEAT_COMPARE];
+    pthread_mutex_t lock;
+    atomic_ulong repeats;               /* copies of the last text not written */
+    atomic_int severity;                /* severity of the last copy */
+    atomic_llong written;               /* time the last text was written (microseconds) */
+}LOG_strLimitSite_t;
+
+static LOG_strLimitSite_t gl_sites[LOG_CFG_LIMIT_SITES] =
+{
+    [0 ... (LOG_CFG_LIMIT_SITES - 1)] = {.lock = PTHREAD_MUTEX_INITIALIZER}
+};
+
+/* earliest end of the repeat window of a site with copies pending (LLONG_MAX: none) */
+static atomic_llong gl_next_expiry_us = LLONG_MAX;
+
+/* 0: no rate limit */
+static atomic_llong gl_interval_us = (LOG_CFG_LIMIT_RATE > 0) ? (1000000LL / LOG_CFG_LIMIT_RATE) : 0;
+static atomic_llong gl_tolerance_us = (LOG_CFG_LIMIT_RATE > 0) ? (((LOG_CFG_LIMIT_BURST > 1) ? (LOG_CFG_LIMIT_BURST - 1) : 0) * (1000000LL / LOG_CFG_LIMIT_RATE)) : 0;
+
+/* 0: repeats are written */
+static atomic_llong gl_repeat_window_us = LOG_CFG_REPEAT_WINDOW_MS * 1000LL;
+
+static LOG_strLimitSite_t* find_site(const char* message);
+static long long now_us(void);
+static void lower_expiry(long long expiry);
+
+/**
+ * @brief Limit the rate of the messages of each call site (LOG_write format string)
+ *        (the dropped ones are counted and reported before the next written message of the site)
+ * 
+ * @param[in] messagesPerSecond: the sustained rate of a call site, 0 for no limit
+ * @param[in] burst            : the number of messages a quiet call site may write at once
+ * 
+ * @return
+*/
+void LOG_setRateLimit(int messagesPerSecond, int burst)
+{
+    if((messagesPerSecond > 0) && (burst > 0))
+    {
+        atomic_store(&gl_tolerance_us, (burst - 1) * (1000000LL / messagesPerSecond));
+        atomic_store(&gl_interval_us, 1000000LL / messagesPerSecond);
+    }
+    else if(messagesPerSecond == 0)
+    {
+        atomic_store(&gl_interval_us, 0);
+    }
+    else
+    {
+
+    }
+}
+
+/**
+ * @brief Select the repeat window: a message identical to the previous one of its call site is not
+ *        written again within the window, the number of copies is written instead with the next
+ *        different message, or once the window expires
+ * 
+ * @param[in] milliseconds: the window, 0 to write all the repeats
+ * 
+ * @return
+*/
+void LOG_setRepeatWindow(int milliseconds)
+{
+    if(milliseconds >= 0)
+    {
+        atomic_store(&gl_repeat_window_us, milliseconds * 1000LL);
+    }
+    else
+    {
+
+    }
+}
+
+int log_limit_check(const char* message)
+{
+    int pass = 1;
+    long long interval = atomic_load_explicit(&gl_interval_us, memory_order_relaxed);
+    long long tolerance;
+    long long now;
+    long long tat;
+    long long next;
+    LOG_strLimitSite_t* site;
+
+    if((interval > 0) && ((site = find_site(message)) != NULL))
+    {
+        tolerance = atomic_load_explicit(&gl_tolerance_us, memory_order_relaxed);
+        now = now_us();
+        tat = atomic_load_explicit(&site->tat, memory_order_relaxed);
+
+        /* the bucket is empty when the site is more than the burst ahead of its rate */
+        do
+        {
+            next = (tat > now) ? tat : now;
+            if(next - now > tolerance)
+            {
+                pass = 0;
+                break;
+            }
+            next += interval;
+        } while(!atomic_compare_exchange_weak_explicit(&site->tat, &tat, next,
+                                                      memory_order_relaxed, memory_order_relaxed));
+
+        if(!pass)
+        {
+            atomic_fetch_add_explicit(&site->dropped, 1, memory_order_relaxed);
+        }
+    }
+
+    return pass;
+}
+
+unsigned long log_limit_dropped(const char* message)
+{
+    unsigned long dropped = 0;
+    LOG_strLimitSite_t* site;
+
+    /* no site was claimed while the rate limit is off: nothing to take */
+    if((atomic_load_explicit(&gl_interval_us, memory_order_relaxed) > 0) && ((site = find_site(message)) != NULL))
+    {
+        dropped = atomic_exchange_explicit(&site->dropped, 0, memory_order_relaxed);
+    }
+
+    return dropped;
+}
+
+int log_limit_repeat(const char* message, int severity, const char* text, int length, unsigned long* repeated)
+{
+    int repeat = 0;
+    long long window = atomic_load_explicit(&gl_repeat_window_us, memory_order_relaxed);
+    long long now;
+    unsigned int hash = 2166136261u;
+    int compare = (length < LOG_CFG_REPEAT_COMPARE) ? length : LOG_CFG_REPEAT_COMPARE;
+    int same;
+    LOG_strLimitSite_t* site;
+    int i;
+
+    *repeated = 0;
+
+    if((window > 0) && ((site = find_site(message)) != NULL))
+    {
+        /* FNV-1a */
+        for(i = 0; i < length; i++)
+        {
+            hash = (hash ^ (unsigned char)text[i]) * 16777619u;
+        }
+
+        now = now_us();
+
+        pthread_mutex_lock(&site->lock);
+        same = (site->hash == hash) && (site->length == length) && (memcmp(site->text, text, compare) == 0);
+        if(!same)
+        {
+            site->hash = hash;
+            site->length = length;
+            memcpy(site->text, text, compare);
+        }
+        pthread_mutex_unlock(&site->lock);
+
+        if(same && (now - atomic_load_explicit(&site->written, memory_order_relaxed) < window))
+        {
+            atomic_store_explicit(&site->severity, severity, memory_order_relaxed);
+
+            /* first copy: the window end is where log_limit_expire reports it */
+            if(atomic_fetch_add_explicit(&site->repeats, 1, memory_order_relaxed) == 0)
+            {
+                lower_expiry(atomic_load_explicit(&site->written, memory_order_relaxed) + window);
+            }
+            repeat = 1;
+        }
+        else
+        {
+            *repeated = atomic_exchange_explicit(&site->repeats, 0, memory_order_relaxed);
+            atomic_store_explicit(&site->written, now, memory_order_relaxed);
+        }
+    }
+
+    return repeat;
+}
+
+long log_limit_expire(LOG_limitReport_t report)
+{
+    long long window = atomic_load_explicit(&gl_repeat_window_us, memory_order_relaxed);
+    long long expiry = atomic_load_explicit(&gl_next_expiry_us, memory_order_relaxed);
+    long long now = 0;
+    long long end;
+    unsigned long repeated;
+    uintptr_t key;
+    int i;
+
+    if(expiry != LLONG_MAX)
+    {
+        now = now_us();
+
+        if(now >= expiry)
+        {
+            /* rescan: the sites still pending (or getting a first copy meanwhile) lower it again */
+            atomic_store_explicit(&gl_next_expiry_us, LLONG_MAX, memory_order_relaxed);
+
+            for(i = 0; i < LOG_CFG_LIMIT_SITES; i++)
+            {
+                key = atomic_load_explicit(&gl_sites[i].key, memory_order_acquire);
+
+                if((key != 0) && (atomic_load_explicit(&gl_sites[i].repeats, memory_order_relaxed) > 0))
+                {
+                    end = atomic_load_explicit(&gl_sites[i].written, memory_order_relaxed) + window;
+
+                    if(now < end)
+                    {
+                        lower_expiry(end);
+                    }
+                    else if((repeated = atomic_exchange_explicit(&gl_sites[i].repeats, 0, memory_order_relaxed)) > 0)
+                    {
+                        report((const char*)key, atomic_load_explicit(&gl_sites[i].severity, memory_order_relaxed),
+                               repeated, atomic_exchange_explicit(&gl_sites[i].dropped, 0, memory_order_relaxed));
+                    }
+                    else
+                    {
+                        /* reported by the site's next message meanwhile */
+                    }
+                }
+            }
+
+            expiry = atomic_load_explicit(&gl_next_expiry_us, memory_order_relaxed);
+        }
+    }
+
+    /* rounded up: waiting that long finds the window over */
+    return (expiry == LLONG_MAX) ? -1 : (long)((expiry > now) ? ((expiry - now + 999) / 1000) : 0);
+}
+
+/* Open addressing on the format pointer, the site is claimed with a CAS (NULL when the table is full) */
+static LOG_strLimitSite_t* find_site(const char* message)
+{
+    LOG_strLimitSite_t* site = NULL;
+    uintptr_t key = (uintptr_t)message;
+    uintptr_t current;
+    size_t index = (size_t)((key >> 3) * 2654435761u) & SITES_MASK;
+    int probe;
+
+    for(probe = 0; (probe < LOG_CFG_LIMIT_SITES) && (site == NULL); probe++)
+    {
+        current = atomic_load_explicit(&gl_sites[index].key, memory_order_acquire);
+
+        if((current == 0)
+        && atomic_compare_exchange_strong_explicit(&gl_sites[index].key, &current, key,
+                                                   memory_order_acq_rel, memory_order_acquire))
+        {
+            current = key;
+        }
+
+        if(current == key)
+        {
+            site = &gl_sites[index];
+        }
+        else
+        {
+            index = (index + 1) & SITES_MASK;
+        }
+    }
+
+    return site;
+}
+
+/* Keep the earliest window end in gl_next_expiry_us */
+static void lower_expiry(long long expiry)
+{
+    long long current = atomic_load_explicit(&gl_next_expiry_us, memory_order_relaxed);
+
+    while((expiry < current)
+       && !atomic_compare_exchange_weak_explicit(&gl_next_expiry_us, &current, expiry,
+                                                 memory_order_relaxed, memory_order_relaxed))
+    {
+
+    }
+}
+
+static long long now_us(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (long long)now.tv_sec * 1000000 + now.tv_nsec / 1000;
+}
@@ -0,0 +1,32 @@
+#ifndef LOG_LIMIT_H_
+#define LOG_LIMIT_H_
+
+/*
+ * Log storm protection used by LOG.c (the user API is in LOG.h), per call site:
+ * the site is its format string pointer, found in a fixed table without locking.
+ *
+ *   rate limit : token bucket (GCRA: one compare-and-swap on the site's theoretical arrival time),
+ *                checked before the message is formatted
+ *   repeats    : a message identical to the site's previous one is not written again
+ *                within the repeat window, its copies are counted instead and reported
+ *                with the site's next written message or once the window expires
+ */
+
+/* Reports the copies (and the rate limit drops) of a site whose repeat window expired */
+typedef void (*LOG_limitReport_t)(const char* message, int severity, unsigned long repeated, unsigned long dropped);
+
+/* Token bucket of the message's site: returns 1 if the message may be written (the drops are counted) */
+int log_limit_check(const char* message);
+
+/* Number of messages of the site dropped since its last written one (reset: call when writing a message) */
+unsigned long log_limit_dropped(const char* message);
+
+/* Repeat check of the formatted text (without the time): returns 1 if it repeats the site's previous text,
+   otherwise *repeated is the number of copies of the previous text that were not written */
+int log_limit_repeat(const char* message, int severity, const char* text, int length, unsigned long* repeated);
+
+/* Report the sites whose repeat window expired with copies pending,
+   returns the ms until the next window expires (-1: no copies pending) */
+long log_limit_expire(LOG_limitReport_t report);
+
+#endif /* LOG_LIMIT_H_ */
@@ -0,0 +1,462 @@
+#include <stdio.h>
+#include <string.h>
+#include <pthread.h>
+#include <stdatomic.h>
+
+#include "LOG.h"
+#include "LOG_cfg.h"
+#include "LOG_file.h"
+#include "LOG_crash.h"
+#include "LOG_sink.h"
+
+#define SINK_FREE           0
+
+/* Room for the decorations a formatter adds to a record */
+#define FORMAT_EXTRA        32
+
+/* A sink slot: the settings are written before the type is published (type != SINK_FREE) */
+typedef struct
+{
+    atomic_int type;
+    atomic_int minSeverity;
+    LOG_formatter_t formatter;
+    LOG_sinkCallback_t callback;
+    void* context;
+    char* buffer;
+    size_t size;
+    size_t written;                     /* memory sink: total bytes written (under gl_memory_lock) */
+}LOG_strSinkSlot_t;
+
+/* sink 0: the output channel, console by default */
+static LOG_strSinkSlot_t gl_sinks[LOG_CFG_MAX_SINKS] = {{.type = LOG_SINK_CONSOLE, .minSeverity = debug}};
+static atomic_int gl_sink_min = debug;
+static atomic_int gl_crash_sinks;       /* number of LOG_SINK_CRASH sinks */
+static pthread_mutex_t gl_sink_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_mutex_t gl_memory_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static const char* const gl_severity_names[] = {"DEBUG: ", "INFO: ", "WARNING: ", "ERROR: "};
+
+static void update_min_severity(void);
+static int time_length(const char* data, int length);
+static int format_for(LOG_strSinkSlot_t* sink, LOG_enuSeverityLevel_t severity, const char* data, int length,
+                      char* formatted, LOG_formatter_t* last, int* formattedLength, const char** text);
+static void memory_write(LOG_strSinkSlot_t* sink, const char* data, int length);
+
+/**
+ * @brief Add a sink: every text message of at least its minimum severity is written to it too
+ *        (sinks are meant to be set up before logging, a removed slot may be reused by the next add)
+ * 
+ * @param[in] sink: the sink settings (copied)
+ * 
+ * @return the sink id, -1 if the settings are invalid or the table is full (LOG_CFG_MAX_SINKS)
+*/
+int LOG_addSink(const LOG_strSink_t* sink)
+{
+    int ret = -1;
+    int i;
+
+    if((sink != NULL) && ((unsigned int)sink->minSeverity <= error)
+    && ((sink->type == LOG_SINK_CONSOLE) || (sink->type == LOG_SINK_FILE)
+     || ((sink->type == LOG_SINK_MEMORY) && (sink->buffer != NULL) && (sink->size > 0))
+     || ((sink->type == LOG_SINK_CRASH) && (log_crash_attach(sink->buffer, sink->size) == 0))
+     || ((sink->type == LOG_SINK_CALLBACK) && (sink->callback != NULL))))
+    {
+        pthread_mutex_lock(&gl_sink_lock);
+
+        for(i = 0; (i < LOG_CFG_MAX_SINKS) && (ret < 0); i++)
+        {
+            if(atomic_load(&gl_sinks[i].type) == SINK_FREE)
+            {
+                gl_sinks[i].formatter = sink->formatter;
+                gl_sinks[i].callback = sink->callback;
+                gl_sinks[i].context = sink->context;
+                gl_sinks[i].buffer = sink->buffer;
+                gl_sinks[i].size = sink->size;
+                gl_sinks[i].written = 0;
+                atomic_store(&gl_sinks[i].minSeverity, sink->minSeverity);
+                atomic_store_explicit(&gl_sinks[i].type, sink->type, memory_order_release);
+                ret = i;
+
+                if(sink->type == LOG_SINK_CRASH)
+                {
+                    atomic_fetch_add(&gl_crash_sinks, 1);
+                }
+            }
+        }
+
+        update_min_severity();
+
+        pthread_mutex_unlock(&gl_sink_lock);
+    }
+    else
+    {
+
+    }
+
+    return ret;
+}
+
+/**
+ * @brief Remove a sink (sink 0 is the output channel: LOG_setOutputChannel adds it back)
+ * 
+ * @param[in] sink: the sink id
+ * 
+ * @return
+*/
+void LOG_removeSink(int sink)
+{
+    if((sink >= 0) && (sink < LOG_CFG_MAX_SINKS))
+    {
+        pthread_mutex_lock(&gl_sink_lock);
+        if(atomic_exchange(&gl_sinks[sink].type, SINK_FREE) == LOG_SINK_CRASH)
+        {
+            atomic_fetch_sub(&gl_crash_sinks, 1);
+        }
+        update_min_severity();
+        pthread_mutex_unlock(&gl_sink_lock);
+    }
+    else
+    {
+
+    }
+}
+
+/**
+ * @brief Select the minimum severity level of a sink
+ * 
+ * @param[in] sink    : the sink id (0: the output channel)
+ * @param[in] severity: the minimum severity level
+ * 
+ * @return
+*/
+void LOG_setSinkSeverity(int sink, LOG_enuSeverityLevel_t severity)
+{
+    if((sink >= 0) && (sink < LOG_CFG_MAX_SINKS) && ((unsigned int)severity <= error))
+    {
+        pthread_mutex_lock(&gl_sink_lock);
+        atomic_store(&gl_sinks[sink].minSeverity, severity);
+        update_min_severity();
+        pthread_mutex_unlock(&gl_sink_lock);
+    }
+    else
+    {
+
+    }
+}
+
+/**
+ * @brief Copy the newest complete lines held by a memory sink
+ * 
+ * @param[in]  sink  : the sink id of a LOG_SINK_MEMORY sink
+ * @param[out] buffer: receives the lines, '\0' terminated
+ * @param[in]  size  : size of the buffer
+ * 
+ * @return the number of characters copied (0 if the sink is not a memory sink)
+*/
+size_t LOG_readMemorySink(int sink, char* buffer, size_t size)
+{
+    size_t length = 0;
+    size_t start;
+    size_t first;
+    LOG_strSinkSlot_t* slot;
+
+    if((sink >= 0) && (sink < LOG_CFG_MAX_SINKS) && (buffer != NULL) && (size > 0)
+    && (atomic_load(&gl_sinks[sink].type) == LOG_SINK_MEMORY))
+    {
+        slot = &gl_sinks[sink];
+
+        pthread_mutex_lock(&gl_memory_lock);
+
+        length = slot->written;
+        if(length > slot->size)
+        {
+            length = slot->size;
+        }
+        if(length > size - 1)
+        {
+            length = size - 1;
+        }
+
+        /* the ring may wrap: copy in up to two parts */
+        start = (slot->written - length) % slot->size;
+        first = slot->size - start;
+        if(first > length)
+        {
+            first = length;
+        }
+        memcpy(buffer, slot->buffer + start, first);
+        memcpy(buffer + first, slot->buffer, length - first);
+
+        /* drop the partly overwritten first line */
+        if(length < slot->written)
+        {
+            start = 0;
+            while((start < length) && (buffer[start] != '\n'))
+            {
+                start++;
+            }
+            start = (start < length) ? (start + 1) : length;
+            length -= start;
+            memmove(buffer, buffer + start, length);
+        }
+
+        pthread_mutex_unlock(&gl_memory_lock);
+
+        buffer[length] = '\0';
+    }
+    else
+    {
+
+    }
+
+    return length;
+}
+
+/**
+ * @brief Formatter adding the severity after the time: "[time] ERROR: message"
+ * 
+ * @param[out] buffer    : receives the text
+ * @param[in]  size      : size of the buffer
+ * @param[in]  severity  : the message's severity level
+ * @param[in]  text      : the record as formatted by LOG_write: "[time] message\n"
+ * @param[in]  timeLength: length of the "[time] " part of the text
+ * @param[in]  length    : length of the text
+ * 
+ * @return the length of the formatted text
+*/
+int LOG_formatSeverity(char* buffer, int size, LOG_enuSeverityLevel_t severity, const char* text, int timeLength, int length)
+{
+    const char* name = gl_severity_names[severity];
+    int nameLength = (int)strlen(name);
+
+    if(length + nameLength > size - 1)
+    {
+        /* no room: keep the record as is */
+        nameLength = 0;
+    }
+
+    memcpy(buffer, text, timeLength);
+    memcpy(buffer + timeLength, name, nameLength);
+    memcpy(buffer + timeLength + nameLength, text + timeLength, length - timeLength);
+    length += nameLength;
+    buffer[length] = '\0';
+
+    return length;
+}
+
+/**
+ * @brief Formatter removing the time: "message"
+ * 
+ * @param[out] buffer    : receives the text
+ * @param[in]  size      : size of the buffer
+ * @param[in]  severity  : the message's severity level
+ * @param[in]  text      : the record as formatted by LOG_write: "[time] message\n"
+ * @param[in]  timeLength: length of the "[time] " part of the text
+ * @param[in]  length    : length of the text
+ * 
+ * @return the length of the formatted text
+*/
+int LOG_formatMessage(char* buffer, int size, LOG_enuSeverityLevel_t severity, const char* text, int timeLength, int length)
+{
+    (void)severity;
+    (void)size;
+
+    length -= timeLength;
+    memcpy(buffer, text + timeLength, length);
+    buffer[length] = '\0';
+
+    return length;
+}
+
+void log_sink_set_channel(int outputChannel)
+{
+    pthread_mutex_lock(&gl_sink_lock);
+    atomic_store(&gl_sinks[0].type, (outputChannel == LOG_OUT_FILE) ? LOG_SINK_FILE : LOG_SINK_CONSOLE);
+    update_min_severity();
+    pthread_mutex_unlock(&gl_sink_lock);
+}
+
+LOG_enuSeverityLevel_t log_sink_min_severity(void)
+{
+    return (LOG_enuSeverityLevel_t)atomic_load_explicit(&gl_sink_min, memory_order_relaxed);
+}
+
+void log_sink_emit(LOG_enuSeverityLevel_t severity, const char* data, int length)
+{
+    char formatted[LOG_CFG_RECORD_SIZE + FORMAT_EXTRA];
+    LOG_formatter_t last = NULL;
+    const char* text;
+    int textLength;
+    int formattedLength = 0;
+    int type;
+    int i;
+
+    for(i = 0; i < LOG_CFG_MAX_SINKS; i++)
+    {
+        type = atomic_load_explicit(&gl_sinks[i].type, memory_order_acquire);
+
+        if((type != SINK_FREE) && (type != LOG_SINK_CRASH)
+        && ((int)severity >= atomic_load_explicit(&gl_sinks[i].minSeverity, memory_order_relaxed)))
+        {
+            textLength = format_for(&gl_sinks[i], severity, data, length, formatted, &last, &formattedLength, &text);
+
+            switch(type)
+            {
+                case LOG_SINK_CONSOLE:
+                    fwrite(text, 1, textLength, stdout);
+                    break;
+
+                case LOG_SINK_FILE:
+                    log_file_write(severity, text, textLength);
+                    break;
+
+                case LOG_SINK_MEMORY:
+                    memory_write(&gl_sinks[i], text, textLength);
+                    break;
+
+                case LOG_SINK_CALLBACK:
+                    gl_sinks[i].callback(gl_sinks[i].context, severity, text, textLength);
+                    break;
+
+                default:
+                    break;
+            }
+        }
+    }
+}
+
+void log_sink_emit_crash(LOG_enuSeverityLevel_t severity, const char* data, int length)
+{
+    char formatted[LOG_CFG_RECORD_SIZE + FORMAT_EXTRA];
+    LOG_formatter_t last = NULL;
+    const char* text;
+    int textLength;
+    int formattedLength = 0;
+    int i;
+
+    if(atomic_load_explicit(&gl_crash_sinks, memory_order_relaxed) != 0)
+    {
+        for(i = 0; i < LOG_CFG_MAX_SINKS; i++)
+        {
+            if((atomic_load_explicit(&gl_sinks[i].type, memory_order_acquire) == LOG_SINK_CRASH)
+            && ((int)severity >= atomic_load_explicit(&gl_sinks[i].minSeverity, memory_order_relaxed)))
+            {
+                textLength = format_for(&gl_sinks[i], severity, data, length, formatted, &last, &formattedLength, &text);
+                log_crash_write(gl_sinks[i].buffer, severity, text, textLength);
+            }
+        }
+    }
+}
+
+void log_sink_flush(void)
+{
+    int i;
+    int console = 0;
+
+    for(i = 0; i < LOG_CFG_MAX_SINKS; i++)
+    {
+        if(atomic_load_explicit(&gl_sinks[i].type, memory_order_relaxed) == LOG_SINK_CONSOLE)
+        {
+            console = 1;
+        }
+    }
+
+    if(console)
+    {
+        fflush(stdout);
+    }
+
+    /* the file sink has its own flush policy */
+    log_file_sync();
+}
+
+/* Recompute the lowest minimum severity of the active sinks (gl_sink_lock held) */
+static void update_min_severity(void)
+{
+    int min = error + 1;
+    int i;
+
+    for(i = 0; i < LOG_CFG_MAX_SINKS; i++)
+    {
+        if((atomic_load(&gl_sinks[i].type) != SINK_FREE) && (atomic_load(&gl_sinks[i].minSeverity) < min))
+        {
+            min = atomic_load(&gl_sinks[i].minSeverity);
+        }
+    }
+
+    atomic_store(&gl_sink_min, min);
+}
+
+/* "[time] " ends at the first "] " (LOG_KV JSON lines have no time prefix) */
+static int time_length(const char* data, int length)
+{
+    int timeLength = 0;
+
+    if((length > 0) && (data[0] == '['))
+    {
+        while((timeLength < length - 1) && (data[timeLength] != ']'))
+        {
+            timeLength++;
+        }
+    }
+
+    return ((timeLength > 0) && (timeLength < length - 1)) ? (timeLength + 2) : 0;
+}
+
+/* The text of a record for a sink: the record itself, or the output of the sink's formatter
+   (run once for consecutive sinks sharing it), returns the text length.
+   A record without a time prefix (LOG_KV JSON line) is not a formatter's "[time] message" */
+static int format_for(LOG_strSinkSlot_t* sink, LOG_enuSeverityLevel_t severity, const char* data, int length,
+                      char* formatted, LOG_formatter_t* last, int* formattedLength, const char** text)
+{
+    int textLength;
+    int timeLength = 0;
+
+    if((sink->formatter == NULL) || ((timeLength = time_length(data, length)) == 0))
+    {
+        *text = data;
+        textLength = length;
+    }
+    else
+    {
+        if(sink->formatter != *last)
+        {
+            *formattedLength = sink->formatter(formatted, LOG_CFG_RECORD_SIZE + FORMAT_EXTRA, severity,
+                                               data, timeLength, length);
+            *last = sink->formatter;
+        }
+        *text = formatted;
+        textLength = *formattedLength;
+    }
+
+    return textLength;
+}
+
+/* Append to a memory sink's ring, overwriting the oldest text */
+static void memory_write(LOG_strSinkSlot_t* sink, const char* data, int length)
+{
+    size_t pos;
+    size_t first;
+
+    pthread_mutex_lock(&gl_memory_lock);
+
+    /* a record longer than the ring keeps its end */
+    if((size_t)length > sink->size)
+    {
+        sink->written += length - sink->size;
+        data += length - sink->size;
+        length = (int)sink->size;
+    }
+
+    pos = sink->written % sink->size;
+    first = sink->size - pos;
+    if(first > (size_t)length)
+    {
+        first = length;
+    }
+    memcpy(sink->buffer + pos, data, first);
+    memcpy(sink->buffer, data + first, length - first);
+    sink->written += length;
+
+    pthread_mutex_unlock(&gl_memory_lock);
+}
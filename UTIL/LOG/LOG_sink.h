@@ -0,0 +1,28 @@
+#ifndef LOG_SINK_H_
+#define LOG_SINK_H_
+
+#include "LOG.h"
+
+/*
+ * Sink table used by LOG.c for the text records (the user API is in LOG.h):
+ * every record is formatted once by LOG_write, then each sink accepting its severity
+ * gets it as is or through the sink's formatter (run once per formatter and record).
+ * Sink 0 is the output channel selected by LOG_setOutputChannel.
+ */
+
+/* Select the type of sink 0 (LOG_OUT_FILE or LOG_OUT_CONSOLE) */
+void log_sink_set_channel(int outputChannel);
+
+/* Lowest minimum severity of the active sinks (messages below it reach no sink) */
+LOG_enuSeverityLevel_t log_sink_min_severity(void);
+
+/* Give a formatted text record "[time] message\n" to the sinks accepting its severity */
+void log_sink_emit(LOG_enuSeverityLevel_t severity, const char* data, int length);
+
+/* Write a record to the LOG_SINK_CRASH sinks (on the caller's thread, also in asynchronous mode) */
+void log_sink_emit_crash(LOG_enuSeverityLevel_t severity, const char* data, int length);
+
+/* End of a write call (synchronous mode) or of a batch (writer thread) */
+void log_sink_flush(void);
+
+#endif /* LOG_SINK_H_ */